@@ -90,6 +90,14 @@ class UnsupportedTypeError(InvalidDefinitionError):
         return "Unsupported C++ type: " + repr(self.type_name)
 
 
+class TooManyMembers(InvalidDefinitionError):
+    def __init__(self, class_name):
+        self.class_name = class_name
+
+    def __str__(self):
+        return "Too many members for a specialized handler (at most 64): " + repr(self.class_name)
+
+
 NOESCAPE_CHARACTERS = bytes(string.digits + string.ascii_letters + ' ')
 
 
@@ -207,6 +215,221 @@ class ClassDefinitionCodeGenerator(object):
         return class_def
 
 
+class SpecializedHandlerCodeGenerator(object):
+    """
+    Generates `staticjson::Handler<T>` for a class, on top of `staticjson::GeneratedHandler`.
+    Members are numbered in key order. Keys are dispatched by a switch on their length and first
+    byte, values that need no conversion are assigned straight to the members, and the writer
+    emits every member in turn with its key as a literal.
+    """
+
+    # Setters of `GeneratedHandler`, the type of the value they receive, and the member types that
+    # value can be assigned to without a range check
+    SETTERS = [
+        ('set_bool', 'bool', {'bool'}),
+        ('set_int', 'int', {'int', 'long long', 'std::int64_t', 'int64_t', 'double'}),
+        ('set_uint', 'unsigned', {'unsigned', 'unsigned int', 'long long', 'std::int64_t', 'int64_t',
+                                  'unsigned long long', 'std::uint64_t', 'uint64_t', 'double'}),
+        ('set_int64', 'std::int64_t', {'long long', 'std::int64_t', 'int64_t'}),
+        ('set_uint64', 'std::uint64_t', {'unsigned long long', 'std::uint64_t', 'uint64_t'}),
+        ('set_double', 'double', {'double'}),
+    ]
+
+    # How members of these types are written without going through their handlers
+    WRITERS = {
+        'bool': 'output->Bool(m_value->{0})',
+        'int': 'output->Int64(m_value->{0})',
+        'long long': 'output->Int64(m_value->{0})',
+        'std::int64_t': 'output->Int64(m_value->{0})',
+        'int64_t': 'output->Int64(m_value->{0})',
+        'unsigned': 'output->Uint64(m_value->{0})',
+        'unsigned int': 'output->Uint64(m_value->{0})',
+        'unsigned long long': 'output->Uint64(m_value->{0})',
+        'std::uint64_t': 'output->Uint64(m_value->{0})',
+        'uint64_t': 'output->Uint64(m_value->{0})',
+        'double': 'output->Double(m_value->{0})',
+        'std::string': 'output->String(m_value->{0}.data(), SizeType(m_value->{0}.size()), true)',
+    }
+
+    def __init__(self, class_info):
+        self._class_info = class_info
+        if len(class_info.members) > 64:
+            raise TooManyMembers(class_info.name)
+        self._members = sorted(class_info.members, key=lambda m: m.json_key)
+
+    @property
+    def class_info(self):
+        return self._class_info
+
+    @staticmethod
+    def type_key(member):
+        return ' '.join(member.type_name.split())
+
+    @staticmethod
+    def char_literal(char):
+        if char in NOESCAPE_CHARACTERS:
+            return "'" + char + "'"
+        return "'\\x{:02x}'".format(ord(char))
+
+    def handler_type(self):
+        return 'Handler<{}>'.format(self.class_info.qualified_name)
+
+    def base_type(self):
+        return 'GeneratedHandler<{}, {}>'.format(self.handler_type(), self.class_info.qualified_name)
+
+    def child_declarations(self):
+        return ''.join('    Handler<decltype({}::{})> h_{};\n'.format(
+            self.class_info.qualified_name, m.variable_name, m.variable_name) for m in self._members)
+
+    def constants(self):
+        class_flags = 'Flags::Default'
+        if not self.class_info.no_duplicates:
+            class_flags += ' | Flags::AllowDuplicateKey'
+        if self.class_info.strict_parsing:
+            class_flags += ' | Flags::DisallowUnknownKey'
+        required = sum(1 << i for i, m in enumerate(self._members) if m.is_required)
+        return ('    static constexpr int member_count() {{ return {count}; }}\n'
+                '    static constexpr unsigned object_flags()\n'
+                '    {{\n'
+                '        return {flags};\n'
+                '    }}\n'
+                '    static constexpr std::uint64_t required_members() {{ return 0x{required:x}ULL; }}\n'
+                ).format(count=len(self._members), flags=class_flags, required=required)
+
+    def match(self, index, indent):
+        member = self._members[index]
+        return ('{0}if (std::memcmp(str, {1}, {2}) == 0)\n'
+                '{0}    return {3};\n').format(indent, cstring_literal(member.json_key),
+                                               len(member.json_key), index)
+
+    def find(self):
+        by_length = {}
+        for i, m in enumerate(self._members):
+            by_length.setdefault(len(m.json_key), []).append(i)
+        cases = ''
+        for length in sorted(by_length):
+            indices = by_length[length]
+            cases += '        case {}:\n'.format(length)
+            if len(indices) == 1:
+                cases += self.match(indices[0], '            ')
+            else:
+                by_first = {}
+                for i in indices:
+                    by_first.setdefault(self._members[i].json_key[0:1], []).append(i)
+                cases += '            switch (str[0])\n            {\n'
+                for first in sorted(by_first):
+                    cases += '            case {}:\n'.format(self.char_literal(first))
+                    for i in by_first[first]:
+                        cases += self.match(i, '                ')
+                    cases += '                break;\n'
+                cases += '            }\n'
+            cases += '            break;\n'
+        if not cases:
+            return ('    static int find(const char*, SizeType) { return -1; }\n')
+        return ('    static int find(const char* str, SizeType length)\n'
+                '    {\n'
+                '        switch (length)\n'
+                '        {\n'
+                '%s'
+                '        }\n'
+                '        return -1;\n'
+                '    }\n') % cases
+
+    def key(self):
+        if not self._members:
+            return '    static const char* key(int) { return nullptr; }\n'
+        return ('    static const char* key(int index)\n'
+                '    {\n'
+                '        static const char* const keys[] = {%s};\n'
+                '        return keys[index];\n'
+                '    }\n') % ', '.join(cstring_literal(m.json_key) for m in self._members)
+
+    def switch_function(self, signature, cases, default):
+        if not cases:
+            return '    {} {{ return {}; }}\n'.format(re.sub(r' \w+([,)])', r'\1', signature), default)
+        return ('    {}\n'
+                '    {{\n'
+                '        switch (index)\n'
+                '        {{\n'
+                '{}'
+                '        }}\n'
+                '        return {};\n'
+                '    }}\n').format(signature, ''.join(cases), default)
+
+    def child(self):
+        return self.switch_function(
+            'BaseHandler* child(int index)',
+            ['        case {}:\n            return &h_{};\n'.format(i, m.variable_name)
+             for i, m in enumerate(self._members)],
+            'nullptr')
+
+    def setters(self):
+        result = ''
+        for name, value_type, member_types in SpecializedHandlerCodeGenerator.SETTERS:
+            cases = ['        case {}:\n            m_value->{} = value;\n            return true;\n'
+                         .format(i, m.variable_name)
+                     for i, m in enumerate(self._members) if self.type_key(m) in member_types]
+            result += self.switch_function(
+                'bool {}(int index, {} value)'.format(name, value_type), cases, 'false')
+        cases = ['        case {}:\n            return &m_value->{};\n'.format(i, m.variable_name)
+                 for i, m in enumerate(self._members) if self.type_key(m) == 'std::string']
+        result += self.switch_function('std::string* string_member(int index)', cases, 'nullptr')
+        return result
+
+    def writer(self):
+        steps = ['output->StartSizedObject({})'.format(len(self._members))]
+        for m in self._members:
+            steps.append('output->Key({}, {}, true)'.format(cstring_literal(m.json_key), len(m.json_key)))
+            writer = SpecializedHandlerCodeGenerator.WRITERS.get(self.type_key(m))
+            steps.append(writer.format(m.variable_name) if writer else 'h_{}.write(output)'.format(m.variable_name))
+        steps.append('output->EndObject({})'.format(len(self._members)))
+        return ('    bool write(IHandler* output) const override\n'
+                '    {\n'
+                '        return %s;\n'
+                '    }\n') % '\n            && '.join(steps)
+
+    def constructor(self):
+        initializers = [self.base_type() + '(value)'] + \
+            ['h_{0}(&value->{0})'.format(m.variable_name) for m in self._members]
+        return ('    explicit Handler({}* value)\n'
+                '        : {}\n'
+                '    {{\n'
+                '    }}\n').format(self.class_info.qualified_name, '\n        , '.join(initializers))
+
+    def handler_definition(self):
+        return ('namespace staticjson\n'
+                '{{\n'
+                'template <>\n'
+                'class {handler}\n'
+                '    : public {base}\n'
+                '{{\n'
+                '    friend class {base};\n'
+                '\n'
+                'private:\n'
+                '{children}'
+                '\n'
+                '{constants}'
+                '\n'
+                '{find}'
+                '\n'
+                '{key}'
+                '\n'
+                '{child}'
+                '\n'
+                '{setters}'
+                '\n'
+                'public:\n'
+                '{constructor}'
+                '\n'
+                '{writer}'
+                '}};\n'
+                '}}\n').format(handler=self.handler_type(), base=self.base_type(),
+                               children=self.child_declarations(), constants=self.constants(),
+                               find=self.find(), key=self.key(), child=self.child(),
+                               setters=self.setters(), constructor=self.constructor(),
+                               writer=self.writer())
+
+
 class MemberInfo(object):
     accept_options = {'default', 'required', 'json_key', 'comment'}
 
@@ -299,6 +522,8 @@ def main():
     parser.add_argument('-i', '--input', help='input name for the definition file for classes', required=True)
     parser.add_argument('-o', '--output', help='output name for the header file', default=None)
     parser.add_argument('--template', help='Compatibility flag; does nothing', default=None)
+    parser.add_argument('--specialize', help='also generate a specialized handler for each class',
+                        action='store_true', default=False)
     args = parser.parse_args()
 
     if args.output is None:
@@ -311,8 +536,12 @@ def main():
         output.write('#pragma once\n\n')
 
         def output_class(class_record):
-            output.write(ClassDefinitionCodeGenerator(ClassInfo(class_record)).class_definition())
+            class_info = ClassInfo(class_record)
+            output.write(ClassDefinitionCodeGenerator(class_info).class_definition())
             output.write('\n\n')
+            if args.specialize:
+                output.write(SpecializedHandlerCodeGenerator(class_info).handler_definition())
+                output.write('\n')
 
         if isinstance(raw_record, list):
             for r in raw_record:
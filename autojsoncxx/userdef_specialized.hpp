@@ -0,0 +1,768 @@
+#pragma once
+
+namespace specialized
+{
+struct Date
+{
+    int year;
+    int month;
+    int day;
+
+    explicit Date() : year(), month(), day() {}
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        h->add_property("year", &this->year, staticjson::Flags::Default);
+        h->add_property("month", &this->month, staticjson::Flags::Default);
+        h->add_property("day", &this->day, staticjson::Flags::Default);
+
+        h->set_flags(staticjson::Flags::Default | staticjson::Flags::AllowDuplicateKey
+                     | staticjson::Flags::DisallowUnknownKey);
+    }
+};
+}
+
+namespace staticjson
+{
+template <>
+class Handler<::specialized::Date>
+    : public GeneratedHandler<Handler<::specialized::Date>, ::specialized::Date>
+{
+    friend class GeneratedHandler<Handler<::specialized::Date>, ::specialized::Date>;
+
+private:
+    Handler<decltype(::specialized::Date::day)> h_day;
+    Handler<decltype(::specialized::Date::month)> h_month;
+    Handler<decltype(::specialized::Date::year)> h_year;
+
+    static constexpr int member_count() { return 3; }
+    static constexpr unsigned object_flags()
+    {
+        return Flags::Default | Flags::AllowDuplicateKey | Flags::DisallowUnknownKey;
+    }
+    static constexpr std::uint64_t required_members() { return 0x7ULL; }
+
+    static int find(const char* str, SizeType length)
+    {
+        switch (length)
+        {
+        case 3:
+            if (std::memcmp(str, "day", 3) == 0)
+                return 0;
+            break;
+        case 4:
+            if (std::memcmp(str, "year", 4) == 0)
+                return 2;
+            break;
+        case 5:
+            if (std::memcmp(str, "month", 5) == 0)
+                return 1;
+            break;
+        }
+        return -1;
+    }
+
+    static const char* key(int index)
+    {
+        static const char* const keys[] = {"day", "month", "year"};
+        return keys[index];
+    }
+
+    BaseHandler* child(int index)
+    {
+        switch (index)
+        {
+        case 0:
+            return &h_day;
+        case 1:
+            return &h_month;
+        case 2:
+            return &h_year;
+        }
+        return nullptr;
+    }
+
+    bool set_bool(int, bool) { return false; }
+    bool set_int(int index, int value)
+    {
+        switch (index)
+        {
+        case 0:
+            m_value->day = value;
+            return true;
+        case 1:
+            m_value->month = value;
+            return true;
+        case 2:
+            m_value->year = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_uint(int, unsigned) { return false; }
+    bool set_int64(int, std::int64_t) { return false; }
+    bool set_uint64(int, std::uint64_t) { return false; }
+    bool set_double(int, double) { return false; }
+    std::string* string_member(int) { return nullptr; }
+
+public:
+    explicit Handler(::specialized::Date* value)
+        : GeneratedHandler<Handler<::specialized::Date>, ::specialized::Date>(value)
+        , h_day(&value->day)
+        , h_month(&value->month)
+        , h_year(&value->year)
+    {
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return output->StartSizedObject(3)
+            && output->Key("day", 3, true)
+            && output->Int64(m_value->day)
+            && output->Key("month", 5, true)
+            && output->Int64(m_value->month)
+            && output->Key("year", 4, true)
+            && output->Int64(m_value->year)
+            && output->EndObject(3);
+    }
+};
+}
+
+namespace specialized
+{
+namespace event
+{
+    struct BlockEvent
+    {
+        unsigned long long serial_number;
+        unsigned long long admin_ID;
+        Date date;
+        std::string description;
+        std::string details;
+
+        explicit BlockEvent()
+            : serial_number()
+            , admin_ID(255)
+            , date()
+            , description("\x2f\x2a\x20\x69\x6e\x69\x74\x20\x2a\x2f\x20\x74\x72\x79\x69\x6e\x67\x20"
+                          "\x74\x6f\x20\x6d\x65\x73\x73\x20\x75\x70\x20\x77\x69\x74\x68\x20\x74\x68"
+                          "\x65\x20\x63\x6f\x64\x65\x20\x67\x65\x6e\x65\x72\x61\x74\x6f\x72")
+            , details()
+        {
+            date.year = 1970;
+            date.month = 1;
+            date.day = 1; /* Assign date to the UNIX epoch */
+        }
+
+        void staticjson_init(staticjson::ObjectHandler* h)
+        {
+            h->add_property("\x73\x65\x72\x69\x61\x6c\x5f\x6e\x75\x6d\x62\x65\x72",
+                            &this->serial_number,
+                            staticjson::Flags::Default);
+            h->add_property("administrator ID", &this->admin_ID, staticjson::Flags::Optional);
+            h->add_property("date", &this->date, staticjson::Flags::Optional);
+            h->add_property("description", &this->description, staticjson::Flags::Optional);
+            h->add_property("details", &this->details, staticjson::Flags::Optional);
+
+            h->set_flags(staticjson::Flags::Default | staticjson::Flags::AllowDuplicateKey);
+        }
+    };
+}
+}
+
+namespace staticjson
+{
+template <>
+class Handler<::specialized::event::BlockEvent>
+    : public GeneratedHandler<Handler<::specialized::event::BlockEvent>,
+                              ::specialized::event::BlockEvent>
+{
+    friend class GeneratedHandler<Handler<::specialized::event::BlockEvent>,
+                                  ::specialized::event::BlockEvent>;
+
+private:
+    Handler<decltype(::specialized::event::BlockEvent::admin_ID)> h_admin_ID;
+    Handler<decltype(::specialized::event::BlockEvent::date)> h_date;
+    Handler<decltype(::specialized::event::BlockEvent::description)> h_description;
+    Handler<decltype(::specialized::event::BlockEvent::details)> h_details;
+    Handler<decltype(::specialized::event::BlockEvent::serial_number)> h_serial_number;
+
+    static constexpr int member_count() { return 5; }
+    static constexpr unsigned object_flags()
+    {
+        return Flags::Default | Flags::AllowDuplicateKey;
+    }
+    static constexpr std::uint64_t required_members() { return 0x10ULL; }
+
+    static int find(const char* str, SizeType length)
+    {
+        switch (length)
+        {
+        case 4:
+            if (std::memcmp(str, "date", 4) == 0)
+                return 1;
+            break;
+        case 7:
+            if (std::memcmp(str, "details", 7) == 0)
+                return 3;
+            break;
+        case 11:
+            if (std::memcmp(str, "description", 11) == 0)
+                return 2;
+            break;
+        case 13:
+            if (std::memcmp(str, "\x73\x65\x72\x69\x61\x6c\x5f\x6e\x75\x6d\x62\x65\x72", 13) == 0)
+                return 4;
+            break;
+        case 16:
+            if (std::memcmp(str, "administrator ID", 16) == 0)
+                return 0;
+            break;
+        }
+        return -1;
+    }
+
+    static const char* key(int index)
+    {
+        static const char* const keys[] = {"administrator ID",
+                                           "date",
+                                           "description",
+                                           "details",
+                                           "\x73\x65\x72\x69\x61\x6c\x5f\x6e\x75\x6d\x62\x65\x72"};
+        return keys[index];
+    }
+
+    BaseHandler* child(int index)
+    {
+        switch (index)
+        {
+        case 0:
+            return &h_admin_ID;
+        case 1:
+            return &h_date;
+        case 2:
+            return &h_description;
+        case 3:
+            return &h_details;
+        case 4:
+            return &h_serial_number;
+        }
+        return nullptr;
+    }
+
+    bool set_bool(int, bool) { return false; }
+    bool set_int(int, int) { return false; }
+    bool set_uint(int index, unsigned value)
+    {
+        switch (index)
+        {
+        case 0:
+            m_value->admin_ID = value;
+            return true;
+        case 4:
+            m_value->serial_number = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_int64(int, std::int64_t) { return false; }
+    bool set_uint64(int index, std::uint64_t value)
+    {
+        switch (index)
+        {
+        case 0:
+            m_value->admin_ID = value;
+            return true;
+        case 4:
+            m_value->serial_number = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_double(int, double) { return false; }
+    std::string* string_member(int index)
+    {
+        switch (index)
+        {
+        case 2:
+            return &m_value->description;
+        case 3:
+            return &m_value->details;
+        }
+        return nullptr;
+    }
+
+public:
+    explicit Handler(::specialized::event::BlockEvent* value)
+        : GeneratedHandler<Handler<::specialized::event::BlockEvent>,
+                           ::specialized::event::BlockEvent>(value)
+        , h_admin_ID(&value->admin_ID)
+        , h_date(&value->date)
+        , h_description(&value->description)
+        , h_details(&value->details)
+        , h_serial_number(&value->serial_number)
+    {
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return output->StartSizedObject(5)
+            && output->Key("administrator ID", 16, true)
+            && output->Uint64(m_value->admin_ID)
+            && output->Key("date", 4, true)
+            && h_date.write(output)
+            && output->Key("description", 11, true)
+            && output->String(
+                m_value->description.data(), SizeType(m_value->description.size()), true)
+            && output->Key("details", 7, true)
+            && output->String(m_value->details.data(), SizeType(m_value->details.size()), true)
+            && output->Key("\x73\x65\x72\x69\x61\x6c\x5f\x6e\x75\x6d\x62\x65\x72", 13, true)
+            && output->Uint64(m_value->serial_number)
+            && output->EndObject(5);
+    }
+};
+}
+
+namespace specialized
+{
+struct User
+{
+    unsigned long long ID;
+    std::string nickname;
+    Date birthday;
+    std::shared_ptr<specialized::event::BlockEvent> block_event;
+    std::vector<specialized::event::BlockEvent> dark_history;
+    std::map<std::string, std::string> optional_attributes;
+
+    explicit User()
+        : ID()
+        , nickname("\xe2\x9d\xb6\xe2\x9d\xb7\xe2\x9d\xb8")
+        , birthday()
+        , block_event()
+        , dark_history()
+        , optional_attributes()
+    {
+    }
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        h->add_property("ID", &this->ID, staticjson::Flags::Default);
+        h->add_property("nickname", &this->nickname, staticjson::Flags::Default);
+        h->add_property("birthday", &this->birthday, staticjson::Flags::Optional);
+        h->add_property("\x62\x6c\x6f\x63\x6b\x5f\x65\x76\x65\x6e\x74",
+                        &this->block_event,
+                        staticjson::Flags::Optional);
+        h->add_property("\x64\x61\x72\x6b\x5f\x68\x69\x73\x74\x6f\x72\x79",
+                        &this->dark_history,
+                        staticjson::Flags::Optional);
+        h->add_property(
+            "\x6f\x70\x74\x69\x6f\x6e\x61\x6c\x5f\x61\x74\x74\x72\x69\x62\x75\x74\x65\x73",
+            &this->optional_attributes,
+            staticjson::Flags::Optional);
+
+        h->set_flags(staticjson::Flags::Default);
+    }
+};
+}
+
+namespace staticjson
+{
+template <>
+class Handler<::specialized::User>
+    : public GeneratedHandler<Handler<::specialized::User>, ::specialized::User>
+{
+    friend class GeneratedHandler<Handler<::specialized::User>, ::specialized::User>;
+
+private:
+    Handler<decltype(::specialized::User::ID)> h_ID;
+    Handler<decltype(::specialized::User::birthday)> h_birthday;
+    Handler<decltype(::specialized::User::block_event)> h_block_event;
+    Handler<decltype(::specialized::User::dark_history)> h_dark_history;
+    Handler<decltype(::specialized::User::nickname)> h_nickname;
+    Handler<decltype(::specialized::User::optional_attributes)> h_optional_attributes;
+
+    static constexpr int member_count() { return 6; }
+    static constexpr unsigned object_flags()
+    {
+        return Flags::Default;
+    }
+    static constexpr std::uint64_t required_members() { return 0x11ULL; }
+
+    static int find(const char* str, SizeType length)
+    {
+        switch (length)
+        {
+        case 2:
+            if (std::memcmp(str, "ID", 2) == 0)
+                return 0;
+            break;
+        case 8:
+            switch (str[0])
+            {
+            case 'b':
+                if (std::memcmp(str, "birthday", 8) == 0)
+                    return 1;
+                break;
+            case 'n':
+                if (std::memcmp(str, "nickname", 8) == 0)
+                    return 4;
+                break;
+            }
+            break;
+        case 11:
+            if (std::memcmp(str, "\x62\x6c\x6f\x63\x6b\x5f\x65\x76\x65\x6e\x74", 11) == 0)
+                return 2;
+            break;
+        case 12:
+            if (std::memcmp(str, "\x64\x61\x72\x6b\x5f\x68\x69\x73\x74\x6f\x72\x79", 12) == 0)
+                return 3;
+            break;
+        case 19:
+            if (std::memcmp(
+                    str,
+                    "\x6f\x70\x74\x69\x6f\x6e\x61\x6c\x5f\x61\x74\x74\x72\x69\x62\x75\x74\x65\x73",
+                    19)
+                == 0)
+                return 5;
+            break;
+        }
+        return -1;
+    }
+
+    static const char* key(int index)
+    {
+        static const char* const keys[] = {
+            "ID",
+            "birthday",
+            "\x62\x6c\x6f\x63\x6b\x5f\x65\x76\x65\x6e\x74",
+            "\x64\x61\x72\x6b\x5f\x68\x69\x73\x74\x6f\x72\x79",
+            "nickname",
+            "\x6f\x70\x74\x69\x6f\x6e\x61\x6c\x5f\x61\x74\x74\x72\x69\x62\x75\x74\x65\x73"};
+        return keys[index];
+    }
+
+    BaseHandler* child(int index)
+    {
+        switch (index)
+        {
+        case 0:
+            return &h_ID;
+        case 1:
+            return &h_birthday;
+        case 2:
+            return &h_block_event;
+        case 3:
+            return &h_dark_history;
+        case 4:
+            return &h_nickname;
+        case 5:
+            return &h_optional_attributes;
+        }
+        return nullptr;
+    }
+
+    bool set_bool(int, bool) { return false; }
+    bool set_int(int, int) { return false; }
+    bool set_uint(int index, unsigned value)
+    {
+        switch (index)
+        {
+        case 0:
+            m_value->ID = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_int64(int, std::int64_t) { return false; }
+    bool set_uint64(int index, std::uint64_t value)
+    {
+        switch (index)
+        {
+        case 0:
+            m_value->ID = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_double(int, double) { return false; }
+    std::string* string_member(int index)
+    {
+        switch (index)
+        {
+        case 4:
+            return &m_value->nickname;
+        }
+        return nullptr;
+    }
+
+public:
+    explicit Handler(::specialized::User* value)
+        : GeneratedHandler<Handler<::specialized::User>, ::specialized::User>(value)
+        , h_ID(&value->ID)
+        , h_birthday(&value->birthday)
+        , h_block_event(&value->block_event)
+        , h_dark_history(&value->dark_history)
+        , h_nickname(&value->nickname)
+        , h_optional_attributes(&value->optional_attributes)
+    {
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return output->StartSizedObject(6)
+            && output->Key("ID", 2, true)
+            && output->Uint64(m_value->ID)
+            && output->Key("birthday", 8, true)
+            && h_birthday.write(output)
+            && output->Key("\x62\x6c\x6f\x63\x6b\x5f\x65\x76\x65\x6e\x74", 11, true)
+            && h_block_event.write(output)
+            && output->Key("\x64\x61\x72\x6b\x5f\x68\x69\x73\x74\x6f\x72\x79", 12, true)
+            && h_dark_history.write(output)
+            && output->Key("nickname", 8, true)
+            && output->String(m_value->nickname.data(), SizeType(m_value->nickname.size()), true)
+            && output->Key(
+                "\x6f\x70\x74\x69\x6f\x6e\x61\x6c\x5f\x61\x74\x74\x72\x69\x62\x75\x74\x65\x73",
+                19,
+                true)
+            && h_optional_attributes.write(output)
+            && output->EndObject(6);
+    }
+};
+}
+
+namespace specialized
+{
+struct Sample
+{
+    bool enabled;
+    double ratio;
+    long long offset;
+    unsigned count;
+    std::vector<int> codes;
+    std::string label;
+    int level;
+
+    explicit Sample()
+        : enabled(), ratio(), offset(), count(), codes(), label(), level()
+    {
+    }
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        h->add_property("enabled", &this->enabled, staticjson::Flags::Optional);
+        h->add_property("ratio", &this->ratio, staticjson::Flags::Default);
+        h->add_property("\x6f\x66\x66\x73\x65\x74\x20\x28\x6d\x73\x29",
+                        &this->offset,
+                        staticjson::Flags::Optional);
+        h->add_property("count", &this->count, staticjson::Flags::Optional);
+        h->add_property("codes", &this->codes, staticjson::Flags::Optional);
+        h->add_property("label", &this->label, staticjson::Flags::Default);
+        h->add_property("level", &this->level, staticjson::Flags::Optional);
+
+        h->set_flags(staticjson::Flags::Default | staticjson::Flags::AllowDuplicateKey);
+    }
+};
+}
+
+namespace staticjson
+{
+template <>
+class Handler<::specialized::Sample>
+    : public GeneratedHandler<Handler<::specialized::Sample>, ::specialized::Sample>
+{
+    friend class GeneratedHandler<Handler<::specialized::Sample>, ::specialized::Sample>;
+
+private:
+    Handler<decltype(::specialized::Sample::codes)> h_codes;
+    Handler<decltype(::specialized::Sample::count)> h_count;
+    Handler<decltype(::specialized::Sample::enabled)> h_enabled;
+    Handler<decltype(::specialized::Sample::label)> h_label;
+    Handler<decltype(::specialized::Sample::level)> h_level;
+    Handler<decltype(::specialized::Sample::offset)> h_offset;
+    Handler<decltype(::specialized::Sample::ratio)> h_ratio;
+
+    static constexpr int member_count() { return 7; }
+    static constexpr unsigned object_flags()
+    {
+        return Flags::Default | Flags::AllowDuplicateKey;
+    }
+    static constexpr std::uint64_t required_members() { return 0x48ULL; }
+
+    static int find(const char* str, SizeType length)
+    {
+        switch (length)
+        {
+        case 5:
+            switch (str[0])
+            {
+            case 'c':
+                if (std::memcmp(str, "codes", 5) == 0)
+                    return 0;
+                if (std::memcmp(str, "count", 5) == 0)
+                    return 1;
+                break;
+            case 'l':
+                if (std::memcmp(str, "label", 5) == 0)
+                    return 3;
+                if (std::memcmp(str, "level", 5) == 0)
+                    return 4;
+                break;
+            case 'r':
+                if (std::memcmp(str, "ratio", 5) == 0)
+                    return 6;
+                break;
+            }
+            break;
+        case 7:
+            if (std::memcmp(str, "enabled", 7) == 0)
+                return 2;
+            break;
+        case 11:
+            if (std::memcmp(str, "\x6f\x66\x66\x73\x65\x74\x20\x28\x6d\x73\x29", 11) == 0)
+                return 5;
+            break;
+        }
+        return -1;
+    }
+
+    static const char* key(int index)
+    {
+        static const char* const keys[] = {"codes",
+                                           "count",
+                                           "enabled",
+                                           "label",
+                                           "level",
+                                           "\x6f\x66\x66\x73\x65\x74\x20\x28\x6d\x73\x29",
+                                           "ratio"};
+        return keys[index];
+    }
+
+    BaseHandler* child(int index)
+    {
+        switch (index)
+        {
+        case 0:
+            return &h_codes;
+        case 1:
+            return &h_count;
+        case 2:
+            return &h_enabled;
+        case 3:
+            return &h_label;
+        case 4:
+            return &h_level;
+        case 5:
+            return &h_offset;
+        case 6:
+            return &h_ratio;
+        }
+        return nullptr;
+    }
+
+    bool set_bool(int index, bool value)
+    {
+        switch (index)
+        {
+        case 2:
+            m_value->enabled = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_int(int index, int value)
+    {
+        switch (index)
+        {
+        case 4:
+            m_value->level = value;
+            return true;
+        case 5:
+            m_value->offset = value;
+            return true;
+        case 6:
+            m_value->ratio = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_uint(int index, unsigned value)
+    {
+        switch (index)
+        {
+        case 1:
+            m_value->count = value;
+            return true;
+        case 5:
+            m_value->offset = value;
+            return true;
+        case 6:
+            m_value->ratio = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_int64(int index, std::int64_t value)
+    {
+        switch (index)
+        {
+        case 5:
+            m_value->offset = value;
+            return true;
+        }
+        return false;
+    }
+    bool set_uint64(int, std::uint64_t) { return false; }
+    bool set_double(int index, double value)
+    {
+        switch (index)
+        {
+        case 6:
+            m_value->ratio = value;
+            return true;
+        }
+        return false;
+    }
+    std::string* string_member(int index)
+    {
+        switch (index)
+        {
+        case 3:
+            return &m_value->label;
+        }
+        return nullptr;
+    }
+
+public:
+    explicit Handler(::specialized::Sample* value)
+        : GeneratedHandler<Handler<::specialized::Sample>, ::specialized::Sample>(value)
+        , h_codes(&value->codes)
+        , h_count(&value->count)
+        , h_enabled(&value->enabled)
+        , h_label(&value->label)
+        , h_level(&value->level)
+        , h_offset(&value->offset)
+        , h_ratio(&value->ratio)
+    {
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return output->StartSizedObject(7)
+            && output->Key("codes", 5, true)
+            && h_codes.write(output)
+            && output->Key("count", 5, true)
+            && output->Uint64(m_value->count)
+            && output->Key("enabled", 7, true)
+            && output->Bool(m_value->enabled)
+            && output->Key("label", 5, true)
+            && output->String(m_value->label.data(), SizeType(m_value->label.size()), true)
+            && output->Key("level", 5, true)
+            && output->Int64(m_value->level)
+            && output->Key("\x6f\x66\x66\x73\x65\x74\x20\x28\x6d\x73\x29", 11, true)
+            && output->Int64(m_value->offset)
+            && output->Key("ratio", 5, true)
+            && output->Double(m_value->ratio)
+            && output->EndObject(7);
+    }
+};
+}
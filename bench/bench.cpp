@@ -0,0 +1,520 @@
+// Micro benchmarks of the parse, serialize and DOM paths.
+//
+// Usage: staticjson_bench [--data=<dir>] [--min-time=<seconds>] [--scale=<bytes>] [filter]
+//
+// Each result is printed as one JSON object per line, so runs can be diffed or fed to scripts.
+
+#include "model.hpp"
+
+#include <staticjson/allocation_hooks.hpp>
+#include <staticjson/document.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include <rapidjson/document.h>
+#include <rapidjson/reader.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#define stat _stat
+#endif
+
+// Table-driven copies of `Date` and `BlockEvent`, for comparison with the template path
+struct TableDate
+{
+    int year = 0, month = 0, day = 0;
+    CalendarType type = CalendarType::Gregorian;
+};
+
+struct TableBlockEvent
+{
+    std::uint64_t serial_number = 0, admin_ID = 255;
+    TableDate date;
+    std::string description, details;
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+    std::experimental::optional<std::string> flags;
+#endif
+};
+
+STATICJSON_DECLARE_TABLE(TableDate,
+                         staticjson::Flags::DisallowUnknownKey,
+                         staticjson::table_field("year", &TableDate::year),
+                         staticjson::table_field("month", &TableDate::month),
+                         staticjson::table_field("day", &TableDate::day),
+                         staticjson::table_field(
+                             "type", &TableDate::type, staticjson::Flags::Optional))
+
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+#define TABLE_BLOCK_EVENT_FLAGS                                                                    \
+    staticjson::table_field("flags", &TableBlockEvent::flags, staticjson::Flags::Optional),
+#else
+#define TABLE_BLOCK_EVENT_FLAGS
+#endif
+
+STATICJSON_DECLARE_TABLE(
+    TableBlockEvent,
+    staticjson::Flags::Default,
+    staticjson::table_field("serial_number", &TableBlockEvent::serial_number),
+    staticjson::table_field(
+        "administrator ID", &TableBlockEvent::admin_ID, staticjson::Flags::Optional),
+    staticjson::table_field("date", &TableBlockEvent::date, staticjson::Flags::Optional),
+    staticjson::table_field(
+        "description", &TableBlockEvent::description, staticjson::Flags::Optional),
+    TABLE_BLOCK_EVENT_FLAGS
+    staticjson::table_field("details", &TableBlockEvent::details, staticjson::Flags::Optional))
+
+// And copies declared with compile-time field lists
+struct FieldsDate
+{
+    int year = 0, month = 0, day = 0;
+    CalendarType type = CalendarType::Gregorian;
+};
+
+struct FieldsBlockEvent
+{
+    std::uint64_t serial_number = 0, admin_ID = 255;
+    FieldsDate date;
+    std::string description, details;
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+    std::experimental::optional<std::string> flags;
+#endif
+};
+
+STATICJSON_FIELDS_FLAGS(FieldsDate,
+                        staticjson::Flags::DisallowUnknownKey,
+                        (year, "year"),
+                        (month, "month"),
+                        (day, "day"),
+                        (type, "type", staticjson::Flags::Optional))
+
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+#define FIELDS_BLOCK_EVENT_FLAGS (flags, "flags", staticjson::Flags::Optional),
+#else
+#define FIELDS_BLOCK_EVENT_FLAGS
+#endif
+
+STATICJSON_FIELDS(FieldsBlockEvent,
+                  (serial_number, "serial_number"),
+                  (admin_ID, "administrator ID", staticjson::Flags::Optional),
+                  (date, "date", staticjson::Flags::Optional),
+                  (description, "description", staticjson::Flags::Optional),
+                  FIELDS_BLOCK_EVENT_FLAGS(details, "details", staticjson::Flags::Optional))
+
+namespace
+{
+struct Options
+{
+    std::string data_dir;
+    std::string filter;
+    double min_time = 0.5;
+    std::size_t scale = 8 << 20;
+};
+
+Options options;
+
+// Prevents the compiler from discarding results
+volatile std::size_t sink;
+
+void run(const char* benchmark,
+         const std::string& input,
+         std::size_t bytes,
+         const std::function<bool()>& op)
+{
+    std::string name = std::string(benchmark) + "/" + input;
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+        return;
+    if (!op())
+    {
+        std::fprintf(stderr, "%s failed\n", name.c_str());
+        std::exit(1);
+    }
+
+    typedef std::chrono::steady_clock clock;
+    std::size_t iterations = 0, batch = 1, allocations = 0;
+    double elapsed = 0;
+    while (elapsed < options.min_time)
+    {
+        staticjson::AllocationCounter before = staticjson::nonpublic::allocations_so_far();
+        clock::time_point start = clock::now();
+        for (std::size_t i = 0; i < batch; ++i)
+            op();
+        elapsed += std::chrono::duration<double>(clock::now() - start).count();
+        allocations += staticjson::nonpublic::allocations_since(before).count;
+        iterations += batch;
+        batch *= 2;
+    }
+
+    double ns_per_op = elapsed * 1e9 / iterations;
+    std::printf("{\"benchmark\": \"%s\", \"input\": \"%s\", \"bytes\": %zu, \"iterations\": %zu, "
+                "\"ns_per_op\": %.1f, \"mb_per_s\": ",
+                benchmark,
+                input.c_str(),
+                bytes,
+                iterations,
+                ns_per_op);
+    if (bytes > 0)
+        std::printf("%.2f", bytes / (ns_per_op / 1e9) / 1e6);
+    else
+        std::printf("null");
+    std::printf(", \"allocs_per_op\": %.2f}\n", double(allocations) / iterations);
+    std::fflush(stdout);
+}
+
+std::string read_file(const std::string& filename)
+{
+    staticjson::nonpublic::FileGuard fg(std::fopen(filename.c_str(), "rb"));
+    if (!fg.fp)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", filename.c_str());
+        std::exit(1);
+    }
+    std::string result;
+    char buffer[16384];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), fg.fp)) > 0)
+        result.append(buffer, n);
+    return result;
+}
+
+void write_file(const std::string& filename, const std::string& content)
+{
+    staticjson::nonpublic::FileGuard fg(std::fopen(filename.c_str(), "wb"));
+    if (!fg.fp || std::fwrite(content.data(), 1, content.size(), fg.fp) != content.size())
+    {
+        std::fprintf(stderr, "Cannot write %s\n", filename.c_str());
+        std::exit(1);
+    }
+}
+
+std::string find_data_dir()
+{
+    std::string path = ".";
+    struct stat st;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (::stat((path + "/examples/success").c_str(), &st) == 0)
+            return path + "/examples/success";
+        path += "/..";
+    }
+    std::fprintf(stderr, "%s", "No 'examples' directory found, use --data=<dir>\n");
+    std::exit(1);
+}
+
+std::string write_document(const rapidjson::Document& d)
+{
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    d.Accept(writer);
+    return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+// Repeats the elements of a JSON array (or members of an object, with renamed keys) until the
+// serialized form reaches the requested size
+std::string scale_up(const std::string& json, std::size_t target)
+{
+    rapidjson::Document original, scaled;
+    original.Parse(json.c_str());
+    if (original.HasParseError() || original.Empty())
+        return json;
+    std::size_t unit = write_document(original).size(), copies = target / unit + 1;
+    if (original.IsArray())
+    {
+        scaled.SetArray();
+        for (std::size_t c = 0; c < copies; ++c)
+            for (auto e = original.Begin(); e != original.End(); ++e)
+                scaled.PushBack(rapidjson::Value(*e, scaled.GetAllocator()),
+                                scaled.GetAllocator());
+    }
+    else
+    {
+        scaled.SetObject();
+        for (std::size_t c = 0; c < copies; ++c)
+            for (auto m = original.MemberBegin(); m != original.MemberEnd(); ++m)
+            {
+                std::string key = std::string(m->name.GetString()) + "#" + std::to_string(c);
+                scaled.AddMember(rapidjson::Value(key.c_str(), scaled.GetAllocator()),
+                                 rapidjson::Value(m->value, scaled.GetAllocator()),
+                                 scaled.GetAllocator());
+            }
+    }
+    return write_document(scaled);
+}
+
+std::string synthetic_block_events(std::size_t target)
+{
+    std::mt19937_64 rng(42);
+    BlockEventArray events;
+    std::size_t estimate = 0;
+    while (estimate < target)
+    {
+        BlockEvent e;
+        e.serial_number = rng();
+        e.admin_ID = rng() % 100000;
+        e.date.year = 1970 + rng() % 60;
+        e.date.month = 1 + rng() % 12;
+        e.date.day = 1 + rng() % 28;
+        e.description = "event " + std::to_string(rng() % 1000);
+        e.details = std::string(16 + rng() % 64, 'a' + static_cast<char>(rng() % 26));
+        estimate += 120 + e.details.size();
+        events.push_back(std::move(e));
+    }
+    return staticjson::to_json_string(events);
+}
+
+std::string synthetic_tensor(std::size_t target)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> dist(-1e3, 1e3);
+    Tensor tensor;
+    std::size_t estimate = 0;
+    while (estimate < target)
+    {
+        std::array<std::vector<double>, 3> slice;
+        for (auto&& row : slice)
+            for (int i = 0; i < 64; ++i)
+                row.push_back(dist(rng));
+        estimate += 3 * 64 * 20;
+        tensor.push_back(std::move(slice));
+    }
+    return staticjson::to_json_string(tensor);
+}
+
+// A flat array of readings, the shape numeric telemetry mostly takes
+template <class Number>
+std::string synthetic_numbers(std::size_t target)
+{
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<Number> numbers;
+    for (std::size_t estimate = 0; estimate < target; estimate += 16)
+        numbers.push_back(static_cast<Number>(dist(rng)));
+    return staticjson::to_json_string(numbers);
+}
+
+std::string with_kind(const std::string& kind, const std::string& object)
+{
+    return "{\"kind\":\"" + kind + "\"," + object.substr(1) + "\n";
+}
+
+// Block events and users in one NDJSON stream, told apart by a "kind" envelope member
+std::string synthetic_records(const std::string& users_json, std::size_t target)
+{
+    UserArray users;
+    BlockEventArray events;
+    staticjson::from_json_string(users_json.c_str(), &users, nullptr);
+    staticjson::from_json_string(synthetic_block_events(target).c_str(), &events, nullptr);
+    std::string result;
+    for (std::size_t i = 0; i < events.size() && result.size() < target; ++i)
+    {
+        result += with_kind("event", staticjson::to_json_string(events[i]));
+        if (i % 4 == 0 && !users.empty())
+            result += with_kind("user", staticjson::to_json_string(users[i / 4 % users.size()]));
+    }
+    return result;
+}
+
+struct NullSaxHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, NullSaxHandler>
+{
+    bool Default() { return true; }
+};
+
+template <class T, unsigned parseFlags>
+void bench_flags(const char* benchmark, const std::string& input, const std::string& json)
+{
+    run(benchmark, input, json.size(), [&]() {
+        T value;
+        return staticjson::from_json_string<parseFlags>(json.c_str(), &value, nullptr);
+    });
+}
+
+template <class T>
+void bench_type(const std::string& input, const std::string& json)
+{
+    const std::size_t bytes = json.size();
+
+    run("from_json_string", input, bytes, [&]() {
+        T value;
+        bool ok = staticjson::from_json_string(json.c_str(), &value, nullptr);
+        sink = sizeof(value);
+        return ok;
+    });
+
+    bench_flags<T, rapidjson::kParseIterativeFlag>("from_json_string<iterative>", input, json);
+    bench_flags<T, rapidjson::kParseFullPrecisionFlag>(
+        "from_json_string<full_precision>", input, json);
+    bench_flags<T, rapidjson::kParseValidateEncodingFlag>(
+        "from_json_string<validate_encoding>", input, json);
+    bench_flags<T, rapidjson::kParseNumbersAsStringsFlag>(
+        "from_json_string<numbers_as_strings>", input, json);
+    bench_flags<T, rapidjson::kParseStopWhenDoneFlag>(
+        "from_json_string<stop_when_done>", input, json);
+    bench_flags<T, rapidjson::kParseIterativeFlag | rapidjson::kParseFullPrecisionFlag>(
+        "from_json_string<iterative|full_precision>", input, json);
+    // Includes copying the input, which in-place parsing destroys
+    run("from_json_insitu", input, bytes, [&]() {
+        std::vector<char> buffer(json.c_str(), json.c_str() + json.size() + 1);
+        T value;
+        return staticjson::from_json_insitu(buffer.data(), &value, nullptr);
+    });
+
+    std::string filename = "staticjson_bench_" + input + ".json";
+    write_file(filename, json);
+    run("from_json_file", input, bytes, [&]() {
+        T value;
+        return staticjson::from_json_file(filename, &value, nullptr);
+    });
+    std::remove(filename.c_str());
+
+    T parsed;
+    staticjson::from_json_string(json.c_str(), &parsed, nullptr);
+    std::size_t serialized_bytes = staticjson::to_json_string(parsed).size();
+    run("to_json_string", input, serialized_bytes, [&]() {
+        sink = staticjson::to_json_string(parsed).size();
+        return true;
+    });
+    run("to_pretty_json_string", input, serialized_bytes, [&]() {
+        sink = staticjson::to_pretty_json_string(parsed).size();
+        return true;
+    });
+
+    staticjson::Document dom;
+    dom.Parse(json.c_str());
+    run("from_json_value", input, bytes, [&]() {
+        T value;
+        return staticjson::from_json_value(dom, &value, nullptr);
+    });
+    run("to_json_value", input, serialized_bytes, [&]() {
+        staticjson::Document d;
+        return staticjson::to_json_document(&d, parsed, nullptr);
+    });
+
+    run("export_json_schema", input, 0, [&]() {
+        T value;
+        sink = staticjson::export_json_schema(&value).MemberCount();
+        return true;
+    });
+
+    run("rapidjson_dom_parse", input, bytes, [&]() {
+        rapidjson::Document d;
+        d.Parse(json.c_str());
+        return !d.HasParseError();
+    });
+    run("rapidjson_sax_parse", input, bytes, [&]() {
+        NullSaxHandler handler;
+        rapidjson::StringStream is(json.c_str());
+        rapidjson::Reader reader;
+        return !reader.Parse(is, handler).IsError();
+    });
+    run("rapidjson_dom_serialize", input, serialized_bytes, [&]() {
+        sink = write_document(dom).size();
+        return true;
+    });
+}
+
+void bench_router(const std::string& input, const std::string& ndjson)
+{
+    std::vector<std::string> lines;
+    for (std::size_t begin = 0, end; begin < ndjson.size(); begin = end + 1)
+    {
+        end = ndjson.find('\n', begin);
+        lines.push_back(ndjson.substr(begin, end - begin));
+    }
+
+    staticjson::MessageRouter router("kind");
+    router.add_route<BlockEvent>("event", [](BlockEvent& e) { sink = e.details.size(); });
+    router.add_route<User>("user", [](User& u) { sink = u.nickname.size(); });
+    run("route_ndjson", input, ndjson.size(), [&]() {
+        return router.route_ndjson(ndjson.c_str(), nullptr);
+    });
+
+    // What the router replaces: a DOM per record to read the kind, then a typed parse of the DOM
+    run("route_ndjson_via_document", input, ndjson.size(), [&]() {
+        for (auto&& line : lines)
+        {
+            staticjson::Document d;
+            d.Parse(line.c_str());
+            if (d.HasParseError())
+                return false;
+            bool ok;
+            if (std::strcmp(d["kind"].GetString(), "event") == 0)
+            {
+                BlockEvent e;
+                ok = staticjson::from_json_value(d, &e, nullptr);
+                sink = e.details.size();
+            }
+            else
+            {
+                User u;
+                ok = staticjson::from_json_value(d, &u, nullptr);
+                sink = u.nickname.size();
+            }
+            if (!ok)
+                return false;
+        }
+        return true;
+    });
+}
+}
+
+int main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--data=", 7) == 0)
+            options.data_dir = argv[i] + 7;
+        else if (std::strncmp(argv[i], "--min-time=", 11) == 0)
+            options.min_time = std::atof(argv[i] + 11);
+        else if (std::strncmp(argv[i], "--scale=", 8) == 0)
+            options.scale = static_cast<std::size_t>(std::atof(argv[i] + 8));
+        else
+            options.filter = argv[i];
+    }
+    if (options.data_dir.empty())
+        options.data_dir = find_data_dir();
+
+    std::string users = read_file(options.data_dir + "/user_array.json");
+    std::string user_map = read_file(options.data_dir + "/user_map.json");
+    std::string tensor = read_file(options.data_dir + "/tensor.json");
+
+    bench_type<UserArray>("user_array", users);
+    bench_type<UserMap>("user_map", user_map);
+    bench_type<Tensor>("tensor", tensor);
+    bench_type<UserArray>("user_array_scaled", scale_up(users, options.scale));
+    bench_type<UserMap>("user_map_scaled", scale_up(user_map, options.scale));
+    std::string block_events = synthetic_block_events(options.scale);
+    bench_type<BlockEventArray>("block_events_synthetic", block_events);
+    bench_type<std::vector<TableBlockEvent>>("block_events_synthetic_table", block_events);
+    bench_type<std::vector<FieldsBlockEvent>>("block_events_synthetic_fields", block_events);
+    std::string tensor_synthetic = synthetic_tensor(options.scale);
+    bench_type<Tensor>("tensor_synthetic", tensor_synthetic);
+    bench_type<staticjson::Tensor<double, 3>>("tensor_synthetic_contiguous", tensor_synthetic);
+    std::string doubles = synthetic_numbers<double>(options.scale);
+    bench_type<std::vector<double>>("doubles_synthetic", doubles);
+    // Lists still go through the generic per-element handler, for comparison
+    bench_type<std::list<double>>("doubles_synthetic_list", doubles);
+    bench_type<std::vector<std::int64_t>>("int64s_synthetic",
+                                          synthetic_numbers<std::int64_t>(options.scale));
+    bench_router("records_synthetic", synthetic_records(users, options.scale));
+
+    staticjson::GeneratorOptions generator_options;
+    generator_options.target_size = options.scale;
+    generator_options.max_string_length = 32;
+    bench_type<UserArray>("user_array_generated",
+                          staticjson::generate_json<UserArray>(generator_options));
+    bench_type<UserMap>("user_map_generated",
+                        staticjson::generate_json<UserMap>(generator_options));
+    return 0;
+}
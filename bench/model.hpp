@@ -0,0 +1,109 @@
+#pragma once
+
+#include <staticjson/staticjson.hpp>
+
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+#include <experimental/optional>
+#include <staticjson/optional_support.hpp>
+#endif
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// The same types as the integration test, so that the numbers reflect `examples/success`
+
+enum class CalendarType
+{
+    Gregorian,
+    Chinese,
+    Jewish,
+    Islam
+};
+
+STATICJSON_DECLARE_ENUM(CalendarType,
+                        {"Gregorian", CalendarType::Gregorian},
+                        {"Chinese", CalendarType::Chinese},
+                        {"Jewish", CalendarType::Jewish},
+                        {"Islam", CalendarType::Islam})
+
+struct Date
+{
+    int year, month, day;
+    CalendarType type;
+
+    Date() : year(0), month(0), day(0), type(CalendarType::Gregorian) {}
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        h->add_property("year", &year);
+        h->add_property("month", &month);
+        h->add_property("day", &day);
+        h->add_property("type", &type, staticjson::Flags::Optional);
+        h->set_flags(staticjson::Flags::DisallowUnknownKey);
+    }
+};
+
+struct BlockEvent
+{
+    std::uint64_t serial_number, admin_ID = 255;
+    Date date;
+    std::string description, details;
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+    std::experimental::optional<std::string> flags;
+#endif
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        using staticjson::Flags;
+        h->add_property("serial_number", &serial_number);
+        h->add_property("administrator ID", &admin_ID, Flags::Optional);
+        h->add_property("date", &date, Flags::Optional);
+        h->add_property("description", &description, Flags::Optional);
+        h->add_property("details", &details, Flags::Optional);
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+        h->add_property("flags", &flags, Flags::Optional);
+#endif
+    }
+};
+
+struct User
+{
+    unsigned long long ID;
+    std::string nickname;
+    Date birthday;
+    std::shared_ptr<BlockEvent> block_event;
+    std::vector<BlockEvent> dark_history;
+    std::unordered_map<std::string, std::string> optional_attributes;
+    std::tuple<int, std::vector<std::tuple<double, double>>, bool> auxiliary;
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+    std::experimental::optional<BlockEvent> dark_event;
+    std::experimental::optional<std::vector<std::experimental::optional<BlockEvent>>>
+        alternate_history;
+#endif
+
+    void staticjson_init(staticjson::ObjectHandler* h)
+    {
+        using staticjson::Flags;
+        h->add_property("ID", &ID);
+        h->add_property("nickname", &nickname);
+        h->add_property("birthday", &birthday, Flags::Optional);
+        h->add_property("block_event", &block_event, Flags::Optional);
+        h->add_property("optional_attributes", &optional_attributes, Flags::Optional);
+        h->add_property("dark_history", &dark_history, Flags::Optional);
+        h->add_property("auxiliary", &auxiliary, Flags::Optional);
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+        h->add_property("dark_event", &dark_event, Flags::Optional);
+        h->add_property("alternate_history", &alternate_history, Flags::Optional);
+#endif
+    }
+};
+
+typedef std::vector<User> UserArray;
+typedef std::map<std::string, User> UserMap;
+typedef std::vector<BlockEvent> BlockEventArray;
+typedef std::vector<std::array<std::vector<double>, 3>> Tensor;
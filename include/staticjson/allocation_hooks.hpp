@@ -0,0 +1,54 @@
+#pragma once
+
+// Replaces the global allocation functions so that `AllocationStats` can be collected.
+// Include this header in exactly one translation unit of the program.
+
+#include <staticjson/instrumentation.hpp>
+
+#include <cstdlib>
+#include <new>
+
+// GCC does not see that the replacements below pair malloc with free
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    staticjson::nonpublic::record_allocation(size);
+    void* p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    staticjson::nonpublic::record_allocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+const bool staticjson_allocation_hooks
+    = (staticjson::nonpublic::mark_allocation_hooks_installed(), true);
+}
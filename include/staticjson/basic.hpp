@@ -3,11 +3,17 @@
 #include <rapidjson/document.h>
 #include <staticjson/error.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <memory>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace staticjson
 {
@@ -58,6 +64,32 @@ public:
 
     virtual bool RawNumber(const char*, SizeType, bool);
 
+    // Byte strings have no JSON counterpart; by default they are forwarded as base64 text
+    virtual bool Binary(const std::uint8_t*, SizeType);
+
+    // Writers call these instead of StartArray/StartObject when the length is known in advance
+    virtual bool StartSizedArray(SizeType);
+
+    virtual bool StartSizedObject(SizeType);
+
+    // Writers call these for numbers stored contiguously; by default each number is forwarded as
+    // its own event between StartSizedArray and EndArray
+    virtual bool NumberArray(const int*, SizeType);
+
+    virtual bool NumberArray(const unsigned*, SizeType);
+
+    virtual bool NumberArray(const std::int64_t*, SizeType);
+
+    virtual bool NumberArray(const std::uint64_t*, SizeType);
+
+    virtual bool NumberArray(const float*, SizeType);
+
+    virtual bool NumberArray(const double*, SizeType);
+
+    // Whether writers should include members flagged `IgnoreWrite`. Outputs that have to restore
+    // the whole value, such as snapshots, return true.
+    virtual bool writes_ignored_members() const { return false; }
+
     virtual void prepare_for_reuse() = 0;
 };
 
@@ -66,6 +98,227 @@ using rapidjson::Value;
 
 typedef rapidjson::MemoryPoolAllocator<> MemoryPoolAllocator;
 
+// Size of a handler tree, as reported by `handler_footprint`
+struct HandlerFootprint
+{
+    std::size_t handlers = 0;
+
+    // The key maps of object handlers, and their total number of entries
+    std::size_t maps = 0, map_entries = 0;
+
+    // An estimate. The handlers themselves are counted by `sizeof`, but the nodes of the key maps
+    // and the heap blocks of their keys are sized assuming a typical standard library layout.
+    std::size_t bytes = 0;
+};
+
+// Caps on what a single parse may build. A value exceeding one fails the parse before it is
+// stored.
+struct ParseLimits
+{
+    // Nesting of arrays and objects
+    std::size_t max_depth = std::numeric_limits<std::size_t>::max();
+
+    // Bytes of one string, key or byte string
+    std::size_t max_string_length = std::numeric_limits<std::size_t>::max();
+
+    // Elements of one array, or members of one object
+    std::size_t max_container_size = std::numeric_limits<std::size_t>::max();
+
+    // Bytes of strings and container elements stored into the result. This is an estimate:
+    // strings are charged their length and sequences and maps `sizeof` each element, whatever
+    // capacity the containers actually grow to and however large their nodes are.
+    std::size_t max_allocation = std::numeric_limits<std::size_t>::max();
+
+    bool any() const
+    {
+        return max_depth != std::numeric_limits<std::size_t>::max()
+            || max_string_length != std::numeric_limits<std::size_t>::max()
+            || max_container_size != std::numeric_limits<std::size_t>::max()
+            || max_allocation != std::numeric_limits<std::size_t>::max();
+    }
+};
+
+// Keeps only the first elements of arrays, for previews of large inputs. Elements past the cap
+// are skipped. Once a capped array that is not nested in another array is full, parsing stops
+// right there and succeeds, so the rest of the input is never read; object members following
+// such an array are not parsed and should be optional.
+struct SamplingOptions
+{
+    std::size_t max_array_elements = std::numeric_limits<std::size_t>::max();
+
+    // Caps of individual arrays, keyed by JSON pointer with "*" standing for any array index,
+    // such as "/users" or "/users/*/friends". They take precedence over `max_array_elements`.
+    std::map<std::string, std::size_t> max_array_elements_at;
+
+    bool any() const
+    {
+        return max_array_elements != std::numeric_limits<std::size_t>::max()
+            || !max_array_elements_at.empty();
+    }
+};
+
+// Bounds on how long a single parse may run. Both conditions are polled every
+// `check_interval` events, so a parse overshoots them by at most that many events.
+struct ParseOptions
+{
+    // Parsing stops with `error::DeadlineExceededError` once this point has passed
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+
+    // Parsing stops with `error::ParseCancelledError` once this becomes true
+    const std::atomic<bool>* cancel = nullptr;
+
+    std::size_t check_interval = 256;
+
+    ParseLimits limits;
+
+    SamplingOptions sampling;
+};
+
+namespace nonpublic
+{
+    struct AllocationBudget
+    {
+        std::size_t limit, used;
+    };
+
+    // Budget of the parse running on this thread, or null when it has none
+    extern thread_local AllocationBudget* active_budget;
+
+    bool exceed_allocation_budget(std::unique_ptr<ErrorBase>& error);
+
+    // Called by handlers before they store `bytes` into the result
+    inline bool charge_allocation(std::size_t bytes, std::unique_ptr<ErrorBase>& error)
+    {
+        AllocationBudget* budget = active_budget;
+        if (!budget)
+            return true;
+        if (bytes > budget->limit - budget->used)
+            return exceed_allocation_budget(error);
+        budget->used += bytes;
+        return true;
+    }
+
+    // Set while a parse with statistics enabled runs on this thread
+    extern thread_local ParseStatistics* active_statistics;
+
+    // Counts a key no member matched in the statistics of the parse running on this thread
+    inline void count_unknown_key()
+    {
+        ParseStatistics* statistics = active_statistics;
+        if (statistics)
+            ++statistics->unknown_keys;
+    }
+}
+
+namespace nonpublic
+{
+    // Stores events, strings included, so they can be replayed into a handler chosen later
+    class EventRecorder : public IHandler
+    {
+    private:
+        enum Kind : unsigned char
+        {
+            NULL_EVENT,
+            BOOL_EVENT,
+            INT_EVENT,
+            UINT_EVENT,
+            INT64_EVENT,
+            UINT64_EVENT,
+            DOUBLE_EVENT,
+            STRING_EVENT,
+            RAW_NUMBER_EVENT,
+            BINARY_EVENT,
+            KEY_EVENT,
+            START_OBJECT_EVENT,
+            END_OBJECT_EVENT,
+            START_ARRAY_EVENT,
+            END_ARRAY_EVENT
+        };
+
+        // `payload` holds the bits of a number or the offset of a string in `m_text`
+        struct Event
+        {
+            Kind kind;
+            SizeType length;
+            std::uint64_t payload;
+        };
+
+        std::vector<Event> m_events;
+        std::string m_text;
+
+        bool record(Kind kind, std::uint64_t payload = 0, SizeType length = 0);
+        bool record_text(Kind kind, const char* data, SizeType length);
+
+    public:
+        bool Null() override;
+        bool Bool(bool) override;
+        bool Int(int) override;
+        bool Uint(unsigned) override;
+        bool Int64(std::int64_t) override;
+        bool Uint64(std::uint64_t) override;
+        bool Double(double) override;
+        bool String(const char*, SizeType, bool) override;
+        bool RawNumber(const char*, SizeType, bool) override;
+        bool Binary(const std::uint8_t*, SizeType) override;
+        bool StartObject() override;
+        bool Key(const char*, SizeType, bool) override;
+        bool EndObject(SizeType) override;
+        bool StartArray() override;
+        bool EndArray(SizeType) override;
+
+        bool empty() const { return m_events.empty(); }
+
+        // Stops at the first event `output` rejects
+        bool replay(IHandler* output) const;
+
+        void prepare_for_reuse() override;
+    };
+
+    // Forwards a written object to `output` with one more member, `key: tag`, placed first
+    class TaggedObjectWriter : public IHandler
+    {
+    private:
+        IHandler* m_output;
+        const char* m_key;
+        const char* m_tag;
+        int depth = 0;
+
+        bool write_tag();
+
+    public:
+        explicit TaggedObjectWriter(IHandler* output, const char* key, const char* tag)
+            : m_output(output), m_key(key), m_tag(tag)
+        {
+        }
+
+        bool Null() override;
+        bool Bool(bool) override;
+        bool Int(int) override;
+        bool Uint(unsigned) override;
+        bool Int64(std::int64_t) override;
+        bool Uint64(std::uint64_t) override;
+        bool Double(double) override;
+        bool String(const char*, SizeType, bool) override;
+        bool RawNumber(const char*, SizeType, bool) override;
+        bool Binary(const std::uint8_t*, SizeType) override;
+        bool StartObject() override;
+        bool StartSizedObject(SizeType) override;
+        bool Key(const char*, SizeType, bool) override;
+        bool EndObject(SizeType) override;
+        bool StartArray() override;
+        bool StartSizedArray(SizeType) override;
+        bool EndArray(SizeType) override;
+        bool NumberArray(const int*, SizeType) override;
+        bool NumberArray(const unsigned*, SizeType) override;
+        bool NumberArray(const std::int64_t*, SizeType) override;
+        bool NumberArray(const std::uint64_t*, SizeType) override;
+        bool NumberArray(const float*, SizeType) override;
+        bool NumberArray(const double*, SizeType) override;
+        bool writes_ignored_members() const override { return m_output->writes_ignored_members(); }
+        void prepare_for_reuse() override { depth = 0; }
+    };
+}
+
 class BaseHandler : public IHandler, private NonMobile
 {
     friend class NullableHandler;
@@ -138,8 +391,78 @@ public:
     virtual bool write(IHandler* output) const = 0;
 
     virtual void generate_schema(Value& output, MemoryPoolAllocator& alloc) const = 0;
+
+    // Adds this handler and its children to the tally. The caller has already counted the bytes
+    // of this handler itself; handlers add the bytes of children they allocate separately.
+    virtual void accumulate_footprint(HandlerFootprint* footprint) const { ++footprint->handlers; }
+};
+
+// Parses an object whose member `key` names the handler the object belongs to. Members after the
+// name go straight to that handler, members before it are recorded and replayed once it arrives,
+// and the name member itself is never forwarded.
+class DiscriminatedHandler : public BaseHandler
+{
+private:
+    std::string m_key;
+    BaseHandler* active = nullptr;
+    nonpublic::EventRecorder recorder;
+    int depth = 0;
+
+    // Whether the next value is the name, and whether it has been seen
+    bool at_name = false, named = false;
+
+    // Whether `the_error` is about the name member
+    bool name_error = false;
+
+private:
+    bool fail(ErrorBase* error, bool about_name);
+    bool begin_object(const char* name, SizeType length);
+
+    // Where an event inside the object goes, or null after recording an error
+    IHandler* target(const char* type);
+
+protected:
+    explicit DiscriminatedHandler(std::string key);
+
+    // The handler of objects named `name`, prepared for a new value, or null for unknown names
+    virtual BaseHandler* select(const char* name, SizeType length) = 0;
+
+    const std::string& key() const { return m_key; }
+
+    // The handler picked for the current object, if any
+    BaseHandler* selected() const { return active; }
+
+    void reset() override;
+
+public:
+    bool Null() override;
+    bool Bool(bool) override;
+    bool Int(int) override;
+    bool Uint(unsigned) override;
+    bool Int64(std::int64_t) override;
+    bool Uint64(std::uint64_t) override;
+    bool Double(double) override;
+    bool String(const char*, SizeType, bool) override;
+    bool RawNumber(const char*, SizeType, bool) override;
+    bool Binary(const std::uint8_t*, SizeType) override;
+    bool StartObject() override;
+    bool Key(const char*, SizeType, bool) override;
+    bool EndObject(SizeType) override;
+    bool StartArray() override;
+    bool EndArray(SizeType) override;
+    bool has_error() const override;
+    bool reap_error(ErrorStack& stk) override;
 };
 
+namespace nonpublic
+{
+    // Adds the member `key`, holding `name`, to the schema of an object
+    void add_discriminator_schema(Value& schema,
+                                  const char* key,
+                                  const char* name,
+                                  MemoryPoolAllocator& alloc);
+}
+
 struct Flags
 {
     static const unsigned Default = 0x0, AllowDuplicateKey = 0x1, Optional = 0x2, IgnoreRead = 0x4,
@@ -157,6 +480,7 @@ protected:
     {
         std::unique_ptr<BaseHandler> handler;
         unsigned flags;
+        std::size_t size;
     };
 
 protected:
@@ -206,12 +530,18 @@ public:
 
     virtual bool EndArray(SizeType) override;
 
+    virtual bool Binary(const std::uint8_t*, SizeType) override;
+
+    virtual bool RawNumber(const char*, SizeType, bool) override;
+
     virtual bool reap_error(ErrorStack&) override;
 
     virtual bool write(IHandler* output) const override;
 
     virtual void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override;
 
+    void accumulate_footprint(HandlerFootprint* footprint) const override;
+
     unsigned get_flags() const { return flags; }
 
     void set_flags(unsigned f) { flags = f; }
@@ -222,6 +552,7 @@ public:
         FlaggedHandler fh;
         fh.handler.reset(new Handler<T>(pointer));
         fh.flags = flags_;
+        fh.size = sizeof(Handler<T>);
         add_handler(std::move(name), std::move(fh));
     }
 };
@@ -284,7 +615,8 @@ protected:
         if (!internal.is_parsed())
             return true;
         this->parsed = true;
-        auto err = Converter<T>::from_shadow(shadow, *m_value);
+        // Converters may take the shadow by rvalue reference and move from it
+        auto err = Converter<T>::from_shadow(std::move(shadow), *m_value);
         if (err)
         {
             this->the_error.swap(err);
@@ -341,6 +673,16 @@ public:
 
     virtual bool EndArray(SizeType sz) override { return postprocess(internal.EndArray(sz)); }
 
+    virtual bool Binary(const std::uint8_t* data, SizeType size) override
+    {
+        return postprocess(internal.Binary(data, size));
+    }
+
+    virtual bool RawNumber(const char* str, SizeType size, bool copy) override
+    {
+        return postprocess(internal.RawNumber(str, size, copy));
+    }
+
     virtual bool has_error() const override
     {
         return BaseHandler::has_error() || internal.has_error();
@@ -353,42 +695,465 @@ public:
 
     virtual bool write(IHandler* output) const override
     {
-        Converter<T>::to_shadow(*m_value, const_cast<shadow_type&>(shadow));
-        return internal.write(output);
+        shadow_type written;
+        Converter<T>::to_shadow(*m_value, written);
+        return internal_type(&written).write(output);
     }
 
     void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
     {
         return internal.generate_schema(output, alloc);
     }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
 };
 
+// Parses a JSON array straight into a type whose converter takes the elements one at a time, see
+// `Converter` in the README. No shadow of the whole value is built in either direction.
+template <class T>
+class StreamingArrayHandler : public BaseHandler
+{
+private:
+    typedef typename Converter<T>::element_type ElementType;
+
+private:
+    ElementType element;
+    Handler<ElementType> internal;
+    T* m_value;
+    std::size_t count = 0;
+    int depth = 0;
+
+    // An error returned by the converter for the current element
+    std::unique_ptr<ErrorBase> element_error;
+
+protected:
+    // Sizes announced by binary formats are untrusted, so converters are told this many at most
+    static const std::size_t max_reserved = 1 << 16;
+
+    bool precheck(const char* type)
+    {
+        if (depth <= 0)
+            return set_type_mismatch(type);
+        return true;
+    }
+
+    bool postcheck(bool success)
+    {
+        if (!success)
+        {
+            the_error.reset(new error::ArrayElementError(count));
+            return false;
+        }
+        if (!internal.is_parsed())
+            return true;
+        if (!nonpublic::charge_allocation(sizeof(ElementType), this->the_error))
+            return false;
+        element_error = Converter<T>::append(*m_value, std::move(element));
+        if (element_error)
+        {
+            the_error.reset(new error::ArrayElementError(count));
+            return false;
+        }
+        ++count;
+        element = ElementType();
+        internal.prepare_for_reuse();
+        return true;
+    }
+
+    bool start(std::size_t size_hint)
+    {
+        ++depth;
+        if (depth > 1)
+            return postcheck(internal.StartArray());
+        count = 0;
+        Converter<T>::begin(*m_value, std::min(size_hint, max_reserved));
+        return true;
+    }
+
+    void reset() override
+    {
+        element = ElementType();
+        internal.prepare_for_reuse();
+        element_error.reset();
+        count = 0;
+        depth = 0;
+    }
+
+public:
+    explicit StreamingArrayHandler(T* value) : element(), internal(&element), m_value(value) {}
+
+    bool Null() override { return precheck("null") && postcheck(internal.Null()); }
+
+    bool Bool(bool b) override { return precheck("bool") && postcheck(internal.Bool(b)); }
+
+    bool Int(int i) override { return precheck("int") && postcheck(internal.Int(i)); }
+
+    bool Uint(unsigned i) override { return precheck("unsigned") && postcheck(internal.Uint(i)); }
+
+    bool Int64(std::int64_t i) override
+    {
+        return precheck("int64_t") && postcheck(internal.Int64(i));
+    }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return precheck("uint64_t") && postcheck(internal.Uint64(i));
+    }
+
+    bool Double(double d) override { return precheck("double") && postcheck(internal.Double(d)); }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("string") && postcheck(internal.String(str, length, copy));
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && postcheck(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && postcheck(internal.RawNumber(str, length, copy));
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("object") && postcheck(internal.Key(str, length, copy));
+    }
+
+    bool StartObject() override { return precheck("object") && postcheck(internal.StartObject()); }
+
+    bool EndObject(SizeType length) override
+    {
+        return precheck("object") && postcheck(internal.EndObject(length));
+    }
+
+    bool StartArray() override { return start(0); }
+
+    bool StartSizedArray(SizeType length) override { return start(length); }
+
+    bool EndArray(SizeType length) override
+    {
+        --depth;
+        if (depth > 0)
+            return postcheck(internal.EndArray(length));
+        auto err = Converter<T>::end(*m_value);
+        if (err)
+        {
+            the_error.swap(err);
+            return false;
+        }
+        this->parsed = true;
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error)
+            return false;
+        stk.push(the_error.release());
+        if (element_error)
+            stk.push(element_error.release());
+        else
+            internal.reap_error(stk);
+        return true;
+    }
+
+    std::string type_name() const override { return "array of " + internal.type_name(); }
+
+    bool write(IHandler* output) const override
+    {
+        SizeType size = static_cast<SizeType>(Converter<T>::size(*m_value));
+        if (!output->StartSizedArray(size))
+            return false;
+        bool success = Converter<T>::for_each(*m_value, [output](const ElementType& e) {
+            Handler<ElementType> h(const_cast<ElementType*>(&e));
+            return h.write(output);
+        });
+        return success && output->EndArray(size);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("array"), alloc);
+        Value items;
+        internal.generate_schema(items, alloc);
+        output.AddMember(rapidjson::StringRef("items"), items, alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+};
+
+template <class T>
+const std::size_t StreamingArrayHandler<T>::max_reserved;
+
+// Parses a JSON object straight into a type whose converter takes the members one at a time
+template <class T>
+class StreamingObjectHandler : public BaseHandler
+{
+private:
+    typedef typename Converter<T>::member_type ElementType;
+
+private:
+    ElementType element;
+    Handler<ElementType> internal;
+    T* m_value;
+    std::string current_key;
+    int depth = 0;
+
+    std::unique_ptr<ErrorBase> element_error;
+
+protected:
+    // Sizes announced by binary formats are untrusted, so converters are told this many at most
+    static const std::size_t max_reserved = 1 << 16;
+
+    bool precheck(const char* type)
+    {
+        if (depth <= 0)
+            return set_type_mismatch(type);
+        return true;
+    }
+
+    bool postcheck(bool success)
+    {
+        if (!success)
+        {
+            the_error.reset(new error::ObjectMemberError(current_key));
+            return false;
+        }
+        if (!internal.is_parsed())
+            return true;
+        if (!nonpublic::charge_allocation(sizeof(ElementType) + current_key.size(),
+                                          this->the_error))
+            return false;
+        element_error = Converter<T>::append(*m_value, current_key, std::move(element));
+        if (element_error)
+        {
+            the_error.reset(new error::ObjectMemberError(current_key));
+            return false;
+        }
+        element = ElementType();
+        internal.prepare_for_reuse();
+        return true;
+    }
+
+    bool start(std::size_t size_hint)
+    {
+        ++depth;
+        if (depth > 1)
+            return postcheck(internal.StartObject());
+        Converter<T>::begin(*m_value, std::min(size_hint, max_reserved));
+        return true;
+    }
+
+    void reset() override
+    {
+        element = ElementType();
+        internal.prepare_for_reuse();
+        element_error.reset();
+        current_key.clear();
+        depth = 0;
+    }
+
+public:
+    explicit StreamingObjectHandler(T* value) : element(), internal(&element), m_value(value) {}
+
+    bool Null() override { return precheck("null") && postcheck(internal.Null()); }
+
+    bool Bool(bool b) override { return precheck("bool") && postcheck(internal.Bool(b)); }
+
+    bool Int(int i) override { return precheck("int") && postcheck(internal.Int(i)); }
+
+    bool Uint(unsigned i) override { return precheck("unsigned") && postcheck(internal.Uint(i)); }
+
+    bool Int64(std::int64_t i) override
+    {
+        return precheck("int64_t") && postcheck(internal.Int64(i));
+    }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return precheck("uint64_t") && postcheck(internal.Uint64(i));
+    }
+
+    bool Double(double d) override { return precheck("double") && postcheck(internal.Double(d)); }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("string") && postcheck(internal.String(str, length, copy));
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && postcheck(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && postcheck(internal.RawNumber(str, length, copy));
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        if (depth > 1)
+            return postcheck(internal.Key(str, length, copy));
+        current_key.assign(str, length);
+        return true;
+    }
+
+    bool StartArray() override { return precheck("array") && postcheck(internal.StartArray()); }
+
+    bool EndArray(SizeType length) override
+    {
+        return precheck("array") && postcheck(internal.EndArray(length));
+    }
+
+    bool StartObject() override { return start(0); }
+
+    bool StartSizedObject(SizeType length) override { return start(length); }
+
+    bool EndObject(SizeType length) override
+    {
+        --depth;
+        if (depth > 0)
+            return postcheck(internal.EndObject(length));
+        auto err = Converter<T>::end(*m_value);
+        if (err)
+        {
+            the_error.swap(err);
+            return false;
+        }
+        this->parsed = true;
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error)
+            return false;
+        stk.push(the_error.release());
+        if (element_error)
+            stk.push(element_error.release());
+        else
+            internal.reap_error(stk);
+        return true;
+    }
+
+    std::string type_name() const override { return "object of " + internal.type_name(); }
+
+    bool write(IHandler* output) const override
+    {
+        SizeType size = static_cast<SizeType>(Converter<T>::size(*m_value));
+        if (!output->StartSizedObject(size))
+            return false;
+        bool success = Converter<T>::for_each(
+            *m_value, [output](const std::string& key, const ElementType& e) {
+                if (!output->Key(key.data(), static_cast<SizeType>(key.size()), true))
+                    return false;
+                Handler<ElementType> h(const_cast<ElementType*>(&e));
+                return h.write(output);
+            });
+        return success && output->EndObject(size);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        Value internal_schema;
+        internal.generate_schema(internal_schema, alloc);
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+        Value empty_obj(rapidjson::kObjectType);
+        output.AddMember(rapidjson::StringRef("properties"), empty_obj, alloc);
+        output.AddMember(rapidjson::StringRef("additionalProperties"), internal_schema, alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+};
+
+template <class T>
+const std::size_t StreamingObjectHandler<T>::max_reserved;
+
 namespace helper
 {
-    template <class T, bool no_conversion>
+    template <class T>
+    struct void_type
+    {
+        typedef void type;
+    };
+
+    // How `Handler<T>` treats a type, as chosen by `Converter<T>`: 0 for classes registering
+    // their members, 1 for conversion through `shadow_type`, 2 for streaming as an array of
+    // `element_type` and 3 for streaming as an object with members of `member_type`
+    template <class T, class = void>
+    struct conversion_kind
+        : public std::integral_constant<
+              int,
+              std::is_same<typename Converter<T>::shadow_type, T>::value ? 0 : 1>
+    {
+    };
+
+    template <class T>
+    struct conversion_kind<T, typename void_type<typename Converter<T>::element_type>::type>
+        : public std::integral_constant<int, 2>
+    {
+    };
+
+    template <class T>
+    struct conversion_kind<T, typename void_type<typename Converter<T>::member_type>::type>
+        : public std::integral_constant<int, 3>
+    {
+    };
+
+    template <class T, int kind>
     class DispatchHandler;
     template <class T>
-    class DispatchHandler<T, true> : public ::staticjson::ObjectTypeHandler<T>
+    class DispatchHandler<T, 0> : public ::staticjson::ObjectTypeHandler<T>
     {
     public:
         explicit DispatchHandler(T* t) : ::staticjson::ObjectTypeHandler<T>(t) {}
     };
 
     template <class T>
-    class DispatchHandler<T, false> : public ::staticjson::ConversionHandler<T>
+    class DispatchHandler<T, 1> : public ::staticjson::ConversionHandler<T>
     {
     public:
         explicit DispatchHandler(T* t) : ::staticjson::ConversionHandler<T>(t) {}
     };
+
+    template <class T>
+    class DispatchHandler<T, 2> : public ::staticjson::StreamingArrayHandler<T>
+    {
+    public:
+        explicit DispatchHandler(T* t) : ::staticjson::StreamingArrayHandler<T>(t) {}
+    };
+
+    template <class T>
+    class DispatchHandler<T, 3> : public ::staticjson::StreamingObjectHandler<T>
+    {
+    public:
+        explicit DispatchHandler(T* t) : ::staticjson::StreamingObjectHandler<T>(t) {}
+    };
 }
 
 template <class T>
-class Handler
-    : public helper::DispatchHandler<T, std::is_same<typename Converter<T>::shadow_type, T>::value>
+class Handler : public helper::DispatchHandler<T, helper::conversion_kind<T>::value>
 {
 public:
-    typedef helper::DispatchHandler<T, std::is_same<typename Converter<T>::shadow_type, T>::value>
-        base_type;
+    typedef helper::DispatchHandler<T, helper::conversion_kind<T>::value> base_type;
     explicit Handler(T* t) : base_type(t) {}
 };
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace staticjson
+{
+
+namespace nonpublic
+{
+    bool parse_cbor(const std::uint8_t* data,
+                    std::size_t size,
+                    BaseHandler* handler,
+                    ParseStatus* status,
+                    const ParseOptions* options = nullptr);
+    std::string serialize_cbor(const BaseHandler* handler);
+}
+
+template <class T>
+inline bool from_cbor(const void* data, std::size_t size, T* value, ParseStatus* status)
+{
+    Handler<T> h(value);
+    return nonpublic::parse_cbor(static_cast<const std::uint8_t*>(data), size, &h, status);
+}
+
+template <class T>
+inline bool from_cbor(const void* data,
+                      std::size_t size,
+                      T* value,
+                      ParseStatus* status,
+                      const ParseOptions& options)
+{
+    Handler<T> h(value);
+    return nonpublic::parse_cbor(static_cast<const std::uint8_t*>(data), size, &h, status, &options);
+}
+
+template <class T>
+inline bool from_cbor(const std::string& data, T* value, ParseStatus* status)
+{
+    return from_cbor(data.data(), data.size(), value, status);
+}
+
+template <class T>
+inline bool
+from_cbor(const std::string& data, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    return from_cbor(data.data(), data.size(), value, status, options);
+}
+
+template <class T>
+inline std::string to_cbor(const T& value)
+{
+    Handler<T> h(const_cast<T*>(&value));
+    return nonpublic::serialize_cbor(&h);
+}
+}
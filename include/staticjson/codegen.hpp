@@ -0,0 +1,292 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace staticjson
+{
+// Base of the handlers `autojsoncxx.py --specialize` generates for each class. `Derived` is the
+// generated `Handler<T>`, which supplies what only the generator knows, as plain functions:
+//
+// * `member_count()`, `object_flags()` and `required_members()`, a bit per member
+// * `find(key, length)`, the index of the member with that key or -1, and `key(index)`
+// * `child(index)`, the handler of a member
+// * `set_bool`, `set_int`, `set_uint`, `set_int64`, `set_uint64` and `set_double`, which assign a
+//   value straight to a member when no conversion can fail and return false otherwise, and
+//   `string_member`, the member a string is assigned to or null
+// * `write`
+//
+// Members are numbered in key order, the order `ObjectHandler` keeps them in, so that errors and
+// output are the same as through `staticjson_init`. There are at most 64 of them.
+template <class Derived, class T>
+class GeneratedHandler : public BaseHandler
+{
+protected:
+    T* m_value;
+
+private:
+    std::uint64_t present = 0;
+
+    // The member whose value is being parsed, or -1 when it is skipped
+    int current = -1;
+    int depth = 0;
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    // Children are only read through the const overloads of `BaseHandler`
+    BaseHandler& child(int index) const
+    {
+        return *const_cast<Derived*>(static_cast<const Derived*>(this))->child(index);
+    }
+
+    static std::uint64_t bit(int index) { return std::uint64_t(1) << index; }
+
+    bool precheck(const char* actual_type)
+    {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::TypeMismatchError(type_name(), actual_type));
+            return false;
+        }
+        if (current >= 0 && (present & bit(current)))
+        {
+            if (Derived::object_flags() & Flags::AllowDuplicateKey)
+            {
+                child(current).prepare_for_reuse();
+                present &= ~bit(current);
+            }
+            else
+            {
+                the_error.reset(new error::DuplicateKeyError(Derived::key(current)));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool postcheck(bool success)
+    {
+        if (!success)
+        {
+            the_error.reset(new error::ObjectMemberError(Derived::key(current)));
+            return false;
+        }
+        if (child(current).is_parsed())
+            present |= bit(current);
+        return true;
+    }
+
+    template <class Assign, class Event>
+    bool deliver(const char* actual_type, Assign assign, Event event)
+    {
+        if (!precheck(actual_type))
+            return false;
+        if (current < 0)
+            return true;
+        if (assign())
+        {
+            present |= bit(current);
+            return true;
+        }
+        return postcheck(event(child(current)));
+    }
+
+    template <class Event>
+    bool forward(const char* actual_type, Event event)
+    {
+        return deliver(actual_type, [] { return false; }, event);
+    }
+
+protected:
+    explicit GeneratedHandler(T* value) : m_value(value) {}
+
+    void reset() override
+    {
+        present = 0;
+        current = -1;
+        depth = 0;
+        for (int i = 0; i < Derived::member_count(); ++i)
+            child(i).prepare_for_reuse();
+    }
+
+public:
+    std::string type_name() const override { return "object"; }
+
+    bool Null() override
+    {
+        return forward("null", [](BaseHandler& h) { return h.Null(); });
+    }
+
+    bool Bool(bool b) override
+    {
+        return deliver("bool",
+                       [&] { return derived().set_bool(current, b); },
+                       [=](BaseHandler& h) { return h.Bool(b); });
+    }
+
+    bool Int(int i) override
+    {
+        return deliver("int",
+                       [&] { return derived().set_int(current, i); },
+                       [=](BaseHandler& h) { return h.Int(i); });
+    }
+
+    bool Uint(unsigned i) override
+    {
+        return deliver("unsigned",
+                       [&] { return derived().set_uint(current, i); },
+                       [=](BaseHandler& h) { return h.Uint(i); });
+    }
+
+    bool Int64(std::int64_t i) override
+    {
+        return deliver("std::int64_t",
+                       [&] { return derived().set_int64(current, i); },
+                       [=](BaseHandler& h) { return h.Int64(i); });
+    }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return deliver("std::uint64_t",
+                       [&] { return derived().set_uint64(current, i); },
+                       [=](BaseHandler& h) { return h.Uint64(i); });
+    }
+
+    bool Double(double d) override
+    {
+        return deliver("double",
+                       [&] { return derived().set_double(current, d); },
+                       [=](BaseHandler& h) { return h.Double(d); });
+    }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        // A string over the allocation budget goes to its handler, which reports the error
+        auto assign = [&] {
+            std::string* s = derived().string_member(current);
+            std::unique_ptr<ErrorBase> over_budget;
+            if (!s || !nonpublic::charge_allocation(length, over_budget))
+                return false;
+            s->assign(str, length);
+            return true;
+        };
+        return deliver(
+            "string", assign, [=](BaseHandler& h) { return h.String(str, length, copy); });
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return forward("binary", [=](BaseHandler& h) { return h.Binary(data, length); });
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return forward("number", [=](BaseHandler& h) { return h.RawNumber(str, length, copy); });
+    }
+
+    bool StartArray() override
+    {
+        return forward("array", [](BaseHandler& h) { return h.StartArray(); });
+    }
+
+    bool EndArray(SizeType length) override
+    {
+        return forward("array", [=](BaseHandler& h) { return h.EndArray(length); });
+    }
+
+    bool StartObject() override
+    {
+        ++depth;
+        if (depth > 1)
+            return current < 0 || postcheck(child(current).StartObject());
+        return true;
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::CorruptedDOMError());
+            return false;
+        }
+        if (depth > 1)
+            return current < 0 || postcheck(child(current).Key(str, length, copy));
+        current = Derived::find(str, length);
+        if (current < 0)
+        {
+            nonpublic::count_unknown_key();
+            if (Derived::object_flags() & Flags::DisallowUnknownKey)
+            {
+                the_error.reset(new error::UnknownFieldError(str, length));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool EndObject(SizeType length) override
+    {
+        --depth;
+        if (depth > 0)
+            return current < 0 || postcheck(child(current).EndObject(length));
+        std::uint64_t missing = Derived::required_members() & ~present;
+        if (missing)
+        {
+            auto error = new error::RequiredFieldMissingError();
+            the_error.reset(error);
+            for (int i = 0; i < Derived::member_count(); ++i)
+            {
+                if (missing & bit(i))
+                    error->missing_members().push_back(Derived::key(i));
+            }
+            return false;
+        }
+        this->parsed = true;
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error)
+            return false;
+        stk.push(the_error.release());
+        if (current >= 0)
+            child(current).reap_error(stk);
+        return true;
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+        Value properties(rapidjson::kObjectType);
+        Value required(rapidjson::kArrayType);
+        for (int i = 0; i < Derived::member_count(); ++i)
+        {
+            Value schema;
+            child(i).generate_schema(schema, alloc);
+            properties.AddMember(rapidjson::StringRef(Derived::key(i)), schema, alloc);
+            if (Derived::required_members() & bit(i))
+                required.PushBack(rapidjson::StringRef(Derived::key(i)), alloc);
+        }
+        output.AddMember(rapidjson::StringRef("properties"), properties, alloc);
+        if (!required.Empty())
+            output.AddMember(rapidjson::StringRef("required"), required, alloc);
+        output.AddMember(rapidjson::StringRef("additionalProperties"),
+                         !(Derived::object_flags() & Flags::DisallowUnknownKey),
+                         alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        for (int i = 0; i < Derived::member_count(); ++i)
+            child(i).accumulate_footprint(footprint);
+    }
+};
+}
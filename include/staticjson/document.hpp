@@ -70,7 +70,10 @@ public:
 
 namespace nonpublic
 {
-    bool write_value(const Value& v, BaseHandler* out, ParseStatus* status);
+    bool write_value(const Value& v,
+                     BaseHandler* out,
+                     ParseStatus* status,
+                     const ParseOptions* options = nullptr);
     bool
     read_value(Value* v, MemoryPoolAllocator* alloc, const BaseHandler* input, ParseStatus* status);
 }
@@ -82,6 +85,13 @@ bool from_json_value(const Value& v, T* t, ParseStatus* status)
     return nonpublic::write_value(v, &h, status);
 }
 
+template <class T>
+bool from_json_value(const Value& v, T* t, ParseStatus* status, const ParseOptions& options)
+{
+    Handler<T> h(t);
+    return nonpublic::write_value(v, &h, status, &options);
+}
+
 template <class T>
 bool from_json_document(const Document& d,
                         T* t,
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -49,7 +51,8 @@ namespace error
     static const error_type SUCCESS = 0, OBJECT_MEMBER = 1, ARRAY_ELEMENT = 2, MISSING_REQUIRED = 3,
                             TYPE_MISMATCH = 4, NUMBER_OUT_OF_RANGE = 5, ARRAY_LENGTH_MISMATCH = 6,
                             UNKNOWN_FIELD = 7, DUPLICATE_KEYS = 8, CORRUPTED_DOM = 9,
-                            TOO_DEEP_RECURSION = 10, INVALID_ENUM = 11, CUSTOM = -1;
+                            TOO_DEEP_RECURSION = 10, INVALID_ENUM = 11, PARSE_CANCELLED = 12,
+                            DEADLINE_EXCEEDED = 13, LIMIT_EXCEEDED = 14, CUSTOM = -1;
 
     class Success : public ErrorBase
     {
@@ -218,6 +221,47 @@ namespace error
         error_type type() const { return INVALID_ENUM; }
     };
 
+    class ParseCancelledError : public ErrorBase
+    {
+    private:
+        std::size_t m_offset;
+
+    public:
+        explicit ParseCancelledError(std::size_t offset) : m_offset(offset) {}
+        std::size_t offset() const { return m_offset; }
+        std::string description() const;
+        error_type type() const { return PARSE_CANCELLED; }
+    };
+
+    class DeadlineExceededError : public ErrorBase
+    {
+    private:
+        std::size_t m_offset;
+
+    public:
+        explicit DeadlineExceededError(std::size_t offset) : m_offset(offset) {}
+        std::size_t offset() const { return m_offset; }
+        std::string description() const;
+        error_type type() const { return DEADLINE_EXCEEDED; }
+    };
+
+    class LimitExceededError : public ErrorBase
+    {
+    private:
+        std::string m_limit_name;
+        std::size_t m_limit;
+
+    public:
+        explicit LimitExceededError(std::string limitName, std::size_t limit) : m_limit(limit)
+        {
+            m_limit_name.swap(limitName);
+        }
+        const std::string& limit_name() const { return m_limit_name; }
+        std::size_t limit() const { return m_limit; }
+        std::string description() const;
+        error_type type() const { return LIMIT_EXCEEDED; }
+    };
+
     class CustomError : public ErrorBase
     {
     private:
@@ -233,14 +277,18 @@ namespace error
     {
 
         class error_stack_const_iterator
-            : public std::iterator<std::forward_iterator_tag, const ErrorBase>
         {
         private:
             const ErrorBase* e;
 
-            typedef std::iterator<std::forward_iterator_tag, const ErrorBase> base_type;
-
         public:
+            // std::iterator is deprecated in C++17, so the member types are spelled out
+            typedef std::forward_iterator_tag iterator_category;
+            typedef const ErrorBase value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const ErrorBase* pointer;
+            typedef const ErrorBase& reference;
+
             explicit error_stack_const_iterator(const ErrorBase* p) : e(p) {}
             reference operator*() const { return *e; }
 
@@ -343,16 +391,50 @@ public:
 // For argument dependent lookup
 inline void swap(ErrorStack& s1, ErrorStack& s2) { s1.swap(s2); }
 
+// Counters of a single parse, collected only when requested with
+// `ParseStatus::enable_statistics`
+struct ParseStatistics
+{
+    std::size_t bytes_consumed = 0;
+
+    // SAX events by kind
+    std::size_t nulls = 0, bools = 0, integers = 0, doubles = 0, strings = 0, binaries = 0,
+                objects = 0, arrays = 0;
+
+    // Every key seen, and those matching no field of the object they appear in
+    std::size_t keys = 0, unknown_keys = 0;
+
+    std::size_t max_depth = 0;
+
+    // Total length of the strings, keys and byte strings handed to handlers
+    std::size_t string_bytes = 0;
+
+    std::uint64_t elapsed_ns = 0;
+};
+
 class ParseStatus
 {
 private:
     ErrorStack m_stack;
     std::size_t m_offset;
     int m_code;
+    std::unique_ptr<ParseStatistics> m_statistics;
 
 public:
     explicit ParseStatus() : m_stack(), m_offset(), m_code() {}
 
+    // Subsequent parses with this status fill in `statistics()`. Parses without it enabled take
+    // a code path with no counting at all, save an inline null check per unknown key.
+    void enable_statistics()
+    {
+        if (!m_statistics)
+            m_statistics.reset(new ParseStatistics());
+    }
+
+    ParseStatistics* statistics() { return m_statistics.get(); }
+
+    const ParseStatistics* statistics() const { return m_statistics.get(); }
+
     void set_result(int err, std::size_t off)
     {
         m_code = err;
@@ -384,6 +466,7 @@ public:
         std::swap(m_code, other.m_code);
         std::swap(m_offset, other.m_offset);
         m_stack.swap(other.m_stack);
+        m_statistics.swap(other.m_statistics);
     }
 
     bool operator!() const { return has_error(); }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <staticjson/primitive_types.hpp>
+#include <staticjson/stl_types.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Handlers of common types, explicitly instantiated in the library. With
+// STATICJSON_USE_EXTERN_TEMPLATES defined before StaticJSON is included, translation units use
+// those instead of instantiating their own copies. The classes listed are the ones compiled out of
+// line; the full specializations of scalar types have nothing to instantiate.
+#define STATICJSON_COMMON_HANDLERS(INSTANTIATE)                                                    \
+    INSTANTIATE(IntegerHandler<int>)                                                               \
+    INSTANTIATE(IntegerHandler<unsigned>)                                                          \
+    INSTANTIATE(IntegerHandler<long>)                                                              \
+    INSTANTIATE(IntegerHandler<unsigned long>)                                                     \
+    INSTANTIATE(IntegerHandler<long long>)                                                         \
+    INSTANTIATE(IntegerHandler<unsigned long long>)                                                \
+    INSTANTIATE(NumericArrayHandler<std::vector<int>>)                                             \
+    INSTANTIATE(Handler<std::vector<int>>)                                                         \
+    INSTANTIATE(NumericArrayHandler<std::vector<unsigned>>)                                        \
+    INSTANTIATE(Handler<std::vector<unsigned>>)                                                    \
+    INSTANTIATE(NumericArrayHandler<std::vector<std::int64_t>>)                                    \
+    INSTANTIATE(Handler<std::vector<std::int64_t>>)                                                \
+    INSTANTIATE(NumericArrayHandler<std::vector<std::uint64_t>>)                                   \
+    INSTANTIATE(Handler<std::vector<std::uint64_t>>)                                               \
+    INSTANTIATE(NumericArrayHandler<std::vector<float>>)                                           \
+    INSTANTIATE(Handler<std::vector<float>>)                                                       \
+    INSTANTIATE(NumericArrayHandler<std::vector<double>>)                                          \
+    INSTANTIATE(Handler<std::vector<double>>)                                                      \
+    INSTANTIATE(ArrayHandler<std::vector<std::string>>)                                            \
+    INSTANTIATE(Handler<std::vector<std::string>>)                                                 \
+    INSTANTIATE(MapHandler<std::map<std::string, std::string>>)                                    \
+    INSTANTIATE(Handler<std::map<std::string, std::string>>)                                       \
+    INSTANTIATE(MapHandler<std::map<std::string, int>>)                                            \
+    INSTANTIATE(Handler<std::map<std::string, int>>)                                               \
+    INSTANTIATE(MapHandler<std::map<std::string, double>>)                                         \
+    INSTANTIATE(Handler<std::map<std::string, double>>)                                            \
+    INSTANTIATE(MapHandler<std::unordered_map<std::string, std::string>>)                          \
+    INSTANTIATE(Handler<std::unordered_map<std::string, std::string>>)                             \
+    INSTANTIATE(MapHandler<std::unordered_map<std::string, int>>)                                  \
+    INSTANTIATE(Handler<std::unordered_map<std::string, int>>)                                     \
+    INSTANTIATE(MapHandler<std::unordered_map<std::string, double>>)                               \
+    INSTANTIATE(Handler<std::unordered_map<std::string, double>>)
+
+#ifdef STATICJSON_USE_EXTERN_TEMPLATES
+#define STATICJSON_EXTERN_HANDLER(...) extern template class __VA_ARGS__;
+
+namespace staticjson
+{
+STATICJSON_COMMON_HANDLERS(STATICJSON_EXTERN_HANDLER)
+}
+
+#undef STATICJSON_EXTERN_HANDLER
+#endif
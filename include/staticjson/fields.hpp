@@ -0,0 +1,565 @@
+#pragma once
+
+#include <staticjson/stl_types.hpp>
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <tuple>
+
+namespace staticjson
+{
+// The members of `T` known at compile time, declared with `STATICJSON_FIELDS`. `field<I>` gives
+// the type, key and flags of member `I`, and reaches it in an object.
+template <class T>
+struct FieldList;
+
+// Parses and writes an object type declared with `STATICJSON_FIELDS`. Member handlers are held
+// inline, keys are matched against constants, presence is tracked in a bitset, and writing is
+// unrolled over the members in declaration order.
+template <class T>
+class FieldsHandler : public BaseHandler
+{
+private:
+    typedef FieldList<T> List;
+    static const std::size_t N = List::size;
+    typedef typename nonpublic::make_index_sequence<N>::type Indices;
+
+    template <std::size_t I>
+    using Field = typename List::template field<I>;
+
+    template <class Sequence>
+    struct Children;
+
+    template <std::size_t... Is>
+    struct Children<nonpublic::index_sequence<Is...>>
+    {
+        typedef std::tuple<Handler<typename Field<Is>::value_type>...> type;
+    };
+
+private:
+    T* m_value;
+    typename Children<Indices>::type children;
+    std::array<BaseHandler*, N> handlers;
+    std::bitset<N> present;
+
+    // The member whose value is being parsed, or `N` when it is skipped
+    std::size_t current = N;
+    int depth = 0;
+
+private:
+    template <std::size_t... Is>
+    FieldsHandler(T* value, nonpublic::index_sequence<Is...>)
+        : m_value(value), children(Field<Is>::get(value)...)
+    {
+        handlers = {{&std::get<Is>(children)...}};
+    }
+
+    template <std::size_t... Is>
+    static const char* const* key_table(nonpublic::index_sequence<Is...>)
+    {
+        static const char* const keys[] = {Field<Is>::name()...};
+        return keys;
+    }
+
+    static const char* key(std::size_t index) { return key_table(Indices())[index]; }
+
+    template <std::size_t... Is>
+    static unsigned field_flags(std::size_t index, nonpublic::index_sequence<Is...>)
+    {
+        static const unsigned flags[] = {Field<Is>::flags()...};
+        return flags[index];
+    }
+
+    // Lengths are compile time constants, so most members are ruled out without reading the key
+    template <std::size_t... Is>
+    static std::size_t find(const char* str, SizeType length, nonpublic::index_sequence<Is...>)
+    {
+        std::size_t result = N;
+        int unused[] = {0,
+                        (result == N && Field<Is>::length() == length
+                                 && std::memcmp(Field<Is>::name(), str, length) == 0
+                             ? (result = Is, 0)
+                             : 0)...};
+        (void)unused;
+        return result;
+    }
+
+    template <std::size_t... Is>
+    static std::bitset<N> flagged(unsigned flag, nonpublic::index_sequence<Is...>)
+    {
+        std::bitset<N> result;
+        int unused[] = {0, (result.set(Is, (Field<Is>::flags() & flag) != 0), 0)...};
+        (void)unused;
+        return result;
+    }
+
+    static const std::bitset<N>& optional_fields()
+    {
+        static const std::bitset<N> fields = flagged(Flags::Optional, Indices());
+        return fields;
+    }
+
+    static SizeType written_count(const IHandler* output)
+    {
+        static const SizeType count
+            = static_cast<SizeType>(N - flagged(Flags::IgnoreWrite, Indices()).count());
+        return output->writes_ignored_members() ? static_cast<SizeType>(N) : count;
+    }
+
+    template <std::size_t I>
+    bool write_field(IHandler* output) const
+    {
+        if ((Field<I>::flags() & Flags::IgnoreWrite) && !output->writes_ignored_members())
+            return true;
+        return output->Key(Field<I>::name(), Field<I>::length(), true)
+            && std::get<I>(children).write(output);
+    }
+
+    template <std::size_t... Is>
+    bool write_fields(IHandler* output, nonpublic::index_sequence<Is...>) const
+    {
+        bool success = true;
+        int unused[] = {0, (success = success && write_field<Is>(output), 0)...};
+        (void)unused;
+        return success;
+    }
+
+    template <std::size_t I>
+    void add_schema(Value& properties, Value& required, MemoryPoolAllocator& alloc) const
+    {
+        Value schema;
+        std::get<I>(children).generate_schema(schema, alloc);
+        properties.AddMember(
+            rapidjson::StringRef(Field<I>::name(), Field<I>::length()), schema, alloc);
+        if (!(Field<I>::flags() & Flags::Optional))
+            required.PushBack(rapidjson::StringRef(Field<I>::name(), Field<I>::length()), alloc);
+    }
+
+    template <std::size_t... Is>
+    void add_schemas(Value& properties,
+                     Value& required,
+                     MemoryPoolAllocator& alloc,
+                     nonpublic::index_sequence<Is...>) const
+    {
+        int unused[] = {0, (add_schema<Is>(properties, required, alloc), 0)...};
+        (void)unused;
+    }
+
+    bool precheck(const char* actual_type)
+    {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::TypeMismatchError(type_name(), actual_type));
+            return false;
+        }
+        if (current < N && present[current])
+        {
+            if (List::flags & Flags::AllowDuplicateKey)
+            {
+                handlers[current]->prepare_for_reuse();
+                present.reset(current);
+            }
+            else
+            {
+                the_error.reset(new error::DuplicateKeyError(key(current)));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool postcheck(bool success)
+    {
+        if (!success)
+        {
+            the_error.reset(new error::ObjectMemberError(key(current)));
+            return false;
+        }
+        if (handlers[current]->is_parsed())
+            present.set(current);
+        return true;
+    }
+
+    template <class Event>
+    bool forward(const char* actual_type, Event event)
+    {
+        if (!precheck(actual_type))
+            return false;
+        return current == N || postcheck(event(*handlers[current]));
+    }
+
+protected:
+    void reset() override
+    {
+        current = N;
+        depth = 0;
+        present.reset();
+        for (BaseHandler* h : handlers)
+            h->prepare_for_reuse();
+    }
+
+public:
+    explicit FieldsHandler(T* value) : FieldsHandler(value, Indices()) {}
+
+    std::string type_name() const override { return "object"; }
+
+    bool Null() override
+    {
+        return forward("null", [](BaseHandler& h) { return h.Null(); });
+    }
+
+    bool Bool(bool b) override
+    {
+        return forward("bool", [=](BaseHandler& h) { return h.Bool(b); });
+    }
+
+    bool Int(int i) override
+    {
+        return forward("int", [=](BaseHandler& h) { return h.Int(i); });
+    }
+
+    bool Uint(unsigned i) override
+    {
+        return forward("unsigned", [=](BaseHandler& h) { return h.Uint(i); });
+    }
+
+    bool Int64(std::int64_t i) override
+    {
+        return forward("std::int64_t", [=](BaseHandler& h) { return h.Int64(i); });
+    }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return forward("std::uint64_t", [=](BaseHandler& h) { return h.Uint64(i); });
+    }
+
+    bool Double(double d) override
+    {
+        return forward("double", [=](BaseHandler& h) { return h.Double(d); });
+    }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        return forward("string", [=](BaseHandler& h) { return h.String(str, length, copy); });
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return forward("binary", [=](BaseHandler& h) { return h.Binary(data, length); });
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return forward("number", [=](BaseHandler& h) { return h.RawNumber(str, length, copy); });
+    }
+
+    bool StartArray() override
+    {
+        return forward("array", [](BaseHandler& h) { return h.StartArray(); });
+    }
+
+    bool EndArray(SizeType length) override
+    {
+        return forward("array", [=](BaseHandler& h) { return h.EndArray(length); });
+    }
+
+    bool StartObject() override
+    {
+        ++depth;
+        if (depth > 1)
+            return current == N || postcheck(handlers[current]->StartObject());
+        return true;
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::CorruptedDOMError());
+            return false;
+        }
+        if (depth > 1)
+            return current == N || postcheck(handlers[current]->Key(str, length, copy));
+        current = find(str, length, Indices());
+        if (current == N)
+        {
+            nonpublic::count_unknown_key();
+            if (List::flags & Flags::DisallowUnknownKey)
+            {
+                the_error.reset(new error::UnknownFieldError(str, length));
+                return false;
+            }
+        }
+        else if (field_flags(current, Indices()) & Flags::IgnoreRead)
+        {
+            current = N;
+        }
+        return true;
+    }
+
+    bool EndObject(SizeType length) override
+    {
+        --depth;
+        if (depth > 0)
+            return current == N || postcheck(handlers[current]->EndObject(length));
+        std::bitset<N> missing = ~(present | optional_fields());
+        if (missing.any())
+        {
+            auto error = new error::RequiredFieldMissingError();
+            the_error.reset(error);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (missing[i])
+                    error->missing_members().push_back(key(i));
+            }
+            return false;
+        }
+        this->parsed = true;
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error)
+            return false;
+        stk.push(the_error.release());
+        if (current < N)
+            handlers[current]->reap_error(stk);
+        return true;
+    }
+
+    bool write(IHandler* output) const override
+    {
+        SizeType count = written_count(output);
+        return output->StartSizedObject(count) && write_fields(output, Indices())
+            && output->EndObject(count);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+        Value properties(rapidjson::kObjectType);
+        Value required(rapidjson::kArrayType);
+        add_schemas(properties, required, alloc, Indices());
+        output.AddMember(rapidjson::StringRef("properties"), properties, alloc);
+        if (!required.Empty())
+            output.AddMember(rapidjson::StringRef("required"), required, alloc);
+        output.AddMember(rapidjson::StringRef("additionalProperties"),
+                         !(List::flags & Flags::DisallowUnknownKey),
+                         alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        for (const BaseHandler* h : handlers)
+            h->accumulate_footprint(footprint);
+    }
+};
+}
+
+// Makes `type` an object type whose members are known at compile time. Each member is given as
+// `(member, "key")` or `(member, "key", flags)`; `object_flags` are the flags of
+// `ObjectHandler::set_flags`. Members are written in the order listed. It must not be used inside a
+// namespace, and takes at most 64 members.
+#define STATICJSON_FIELDS_FLAGS(type, object_flags, ...)                                           \
+    namespace staticjson                                                                           \
+    {                                                                                              \
+        template <>                                                                                \
+        struct FieldList<type>                                                                     \
+        {                                                                                          \
+            enum : std::size_t                                                                     \
+            {                                                                                      \
+                size = STATICJSON_NARGS(__VA_ARGS__)                                               \
+            };                                                                                     \
+            enum : unsigned                                                                        \
+            {                                                                                      \
+                flags = object_flags                                                               \
+            };                                                                                     \
+                                                                                                   \
+            template <std::size_t I, class D = void>                                               \
+            struct field;                                                                          \
+                                                                                                   \
+            STATICJSON_FOR_EACH_FIELD(type, __VA_ARGS__)                                           \
+        };                                                                                         \
+                                                                                                   \
+        template <>                                                                                \
+        class Handler<type> : public FieldsHandler<type>                                           \
+        {                                                                                          \
+        public:                                                                                    \
+            explicit Handler(type* value) : FieldsHandler<type>(value) {}                          \
+        };                                                                                         \
+    }
+
+#define STATICJSON_FIELDS(type, ...)                                                               \
+    STATICJSON_FIELDS_FLAGS(type, ::staticjson::Flags::Default, __VA_ARGS__)
+
+// One member: the tuple is unpacked, and the default flags appended in case it has none
+#define STATICJSON_FIELD(type, index, tuple)                                                       \
+    STATICJSON_FIELD_APPLY(STATICJSON_FIELD_I,                                                     \
+                           (type, index, STATICJSON_UNPACK tuple, ::staticjson::Flags::Default, ~))
+#define STATICJSON_UNPACK(...) __VA_ARGS__
+#define STATICJSON_FIELD_APPLY(m, args) m args
+#define STATICJSON_FIELD_I(type, index, member, key, member_flags, ...)                            \
+    template <class D>                                                                             \
+    struct field<index, D>                                                                         \
+    {                                                                                              \
+        typedef decltype(type::member) value_type;                                                 \
+                                                                                                   \
+        static value_type* get(type* object) { return &object->member; }                           \
+        static constexpr const char* name() { return key; }                                        \
+        static constexpr SizeType length() { return sizeof(key) - 1; }                             \
+        static constexpr unsigned flags() { return member_flags; }                                 \
+    };
+
+// Counts the arguments of a macro, from 1 to 64. The trailing 0 keeps the "..." of
+// `STATICJSON_NARGS_N` from being empty.
+#define STATICJSON_NARGS(...) STATICJSON_NARGS_I((__VA_ARGS__, STATICJSON_NARGS_COUNTS()))
+#define STATICJSON_NARGS_I(args) STATICJSON_NARGS_N args
+#define STATICJSON_NARGS_N(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15,       \
+    _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, _33,      \
+    _34, _35, _36, _37, _38, _39, _40, _41, _42, _43, _44, _45, _46, _47, _48, _49, _50, _51,      \
+    _52, _53, _54, _55, _56, _57, _58, _59, _60, _61, _62, _63, _64, N, ...) N
+#define STATICJSON_NARGS_COUNTS()                                                                  \
+    64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48, 47, 46, 45, 44, 43, 42,    \
+    41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19,    \
+    18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+
+#define STATICJSON_FIELDS_CAT(a, b) STATICJSON_FIELDS_CAT_I(a, b)
+#define STATICJSON_FIELDS_CAT_I(a, b) a##b
+
+// Applies `STATICJSON_FIELD` to each member tuple, numbering them from `index`
+#define STATICJSON_FOR_EACH_FIELD(type, ...)                                                       \
+    STATICJSON_FIELDS_CAT(STATICJSON_FOR_EACH_FIELD_, STATICJSON_NARGS(__VA_ARGS__))               \
+    (type, 0, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_1(type, index, x) STATICJSON_FIELD(type, index, x)
+#define STATICJSON_FOR_EACH_FIELD_2(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_1(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_3(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_2(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_4(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_3(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_5(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_4(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_6(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_5(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_7(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_6(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_8(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_7(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_9(type, index, x, ...)                                           \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_8(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_10(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_9(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_11(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_10(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_12(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_11(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_13(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_12(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_14(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_13(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_15(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_14(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_16(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_15(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_17(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_16(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_18(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_17(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_19(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_18(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_20(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_19(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_21(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_20(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_22(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_21(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_23(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_22(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_24(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_23(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_25(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_24(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_26(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_25(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_27(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_26(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_28(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_27(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_29(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_28(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_30(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_29(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_31(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_30(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_32(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_31(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_33(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_32(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_34(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_33(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_35(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_34(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_36(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_35(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_37(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_36(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_38(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_37(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_39(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_38(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_40(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_39(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_41(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_40(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_42(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_41(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_43(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_42(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_44(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_43(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_45(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_44(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_46(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_45(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_47(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_46(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_48(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_47(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_49(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_48(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_50(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_49(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_51(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_50(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_52(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_51(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_53(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_52(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_54(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_53(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_55(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_54(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_56(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_55(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_57(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_56(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_58(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_57(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_59(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_58(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_60(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_59(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_61(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_60(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_62(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_61(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_63(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_62(type, index + 1, __VA_ARGS__)
+#define STATICJSON_FOR_EACH_FIELD_64(type, index, x, ...)                                          \
+    STATICJSON_FIELD(type, index, x) STATICJSON_FOR_EACH_FIELD_63(type, index + 1, __VA_ARGS__)
@@ -0,0 +1,652 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+#include <staticjson/io.hpp>
+#include <staticjson/primitive_types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace staticjson
+{
+
+// A frozen image is a relocatable, read-only encoding of a value that can be accessed in place.
+//
+// The image starts with a 24 byte header (magic, offset of the root node, total size) followed by
+// nodes aligned at 8 bytes. Every node starts with a 32-bit kind and a 32-bit count. Scalars are
+// stored right after that; strings and byte strings store `count` bytes plus a terminating zero;
+// arrays store `count` 64-bit node offsets; objects store `count` pairs of 64-bit offsets to the
+// key (a string node) and to the value, sorted by key. All offsets are relative to the start of the
+// image, which is therefore position independent. Numbers use the native byte order.
+//
+// Images are not trusted. A node is only read once it is known to lie entirely within the image,
+// and one that does not is treated as absent. Typed views check the kind of their node the same
+// way, so a view of the wrong type over a node is empty rather than misread.
+template <class T>
+struct FieldList;
+
+namespace frozen
+{
+    enum class Kind : std::uint32_t
+    {
+        Null = 0,
+        Bool = 1,
+        Int64 = 2,
+        Uint64 = 3,
+        Double = 4,
+        String = 5,
+        Binary = 6,
+        Array = 7,
+        Object = 8
+    };
+
+    static const std::size_t header_size = 24;
+
+    class StringRef
+    {
+    private:
+        const char* m_data;
+        std::size_t m_size;
+
+    public:
+        StringRef() : m_data(""), m_size(0) {}
+        StringRef(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+        const char* data() const { return m_data; }
+
+        // Frozen strings are always followed by a zero byte
+        const char* c_str() const { return m_data; }
+
+        std::size_t size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        std::string str() const { return std::string(m_data, m_size); }
+
+        int compare(const char* other, std::size_t other_size) const
+        {
+            int c = std::memcmp(m_data, other, m_size < other_size ? m_size : other_size);
+            if (c != 0)
+                return c;
+            return m_size < other_size ? -1 : (m_size > other_size ? 1 : 0);
+        }
+
+        bool operator==(const std::string& other) const
+        {
+            return compare(other.data(), other.size()) == 0;
+        }
+
+        bool operator==(const char* other) const
+        {
+            return compare(other, std::strlen(other)) == 0;
+        }
+
+        template <class T>
+        bool operator!=(const T& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    // Untyped access to a node. A default constructed node denotes an absent value.
+    class Node
+    {
+    private:
+        const char* m_base;
+        std::uint64_t m_size;
+        std::uint64_t m_offset;
+
+        // Read once when the node is checked, so that later reads stay within the checked extent
+        Kind m_kind;
+        std::uint32_t m_count;
+
+        template <class U>
+        U load(std::uint64_t position) const
+        {
+            U u;
+            std::memcpy(&u, m_base + position, sizeof(u));
+            return u;
+        }
+
+        // Bytes taken by a node, or 0 for an unknown kind
+        static std::uint64_t extent(Kind kind, std::uint32_t count)
+        {
+            switch (kind)
+            {
+            case Kind::Null:
+            case Kind::Bool:
+                return 8;
+            case Kind::Int64:
+            case Kind::Uint64:
+            case Kind::Double:
+                return 16;
+            case Kind::String:
+            case Kind::Binary:
+                return 8 + std::uint64_t(count) + 1;
+            case Kind::Array:
+                return 8 + 8 * std::uint64_t(count);
+            case Kind::Object:
+                return 8 + 16 * std::uint64_t(count);
+            default:
+                return 0;
+            }
+        }
+
+        Node child(std::uint64_t position) const
+        {
+            return Node(m_base, m_size, load<std::uint64_t>(position));
+        }
+
+    public:
+        Node() : m_base(nullptr), m_size(0), m_offset(0), m_kind(Kind::Null), m_count(0) {}
+
+        // The node at `offset` of the image of `size` bytes at `base`, or an absent node if it
+        // does not lie entirely within the image
+        Node(const char* base, std::uint64_t size, std::uint64_t offset)
+            : m_base(base), m_size(size), m_offset(0), m_kind(Kind::Null), m_count(0)
+        {
+            if (offset < header_size || offset > size || size - offset < 8)
+                return;
+            Kind kind = static_cast<Kind>(load<std::uint32_t>(offset));
+            std::uint32_t count = load<std::uint32_t>(offset + 4);
+            std::uint64_t bytes = extent(kind, count);
+            if (bytes == 0 || bytes > size - offset)
+                return;
+            if ((kind == Kind::String || kind == Kind::Binary) && m_base[offset + bytes - 1] != 0)
+                return;
+            m_offset = offset;
+            m_kind = kind;
+            m_count = count;
+        }
+
+        bool exists() const { return m_offset != 0; }
+
+        Kind kind() const { return m_kind; }
+
+        bool is_null() const { return m_kind == Kind::Null; }
+
+        bool is_number() const
+        {
+            return m_kind == Kind::Int64 || m_kind == Kind::Uint64 || m_kind == Kind::Double;
+        }
+
+        // This node if it is of kind `k`, otherwise an absent node
+        Node of_kind(Kind k) const { return m_kind == k ? *this : Node(); }
+
+        // Length of strings, byte strings, arrays and objects
+        SizeType size() const
+        {
+            switch (m_kind)
+            {
+            case Kind::String:
+            case Kind::Binary:
+            case Kind::Array:
+            case Kind::Object:
+                return m_count;
+            default:
+                return 0;
+            }
+        }
+
+        bool as_bool() const { return m_kind == Kind::Bool && m_count != 0; }
+
+        std::int64_t as_int64() const
+        {
+            switch (kind())
+            {
+            case Kind::Int64:
+                return load<std::int64_t>(m_offset + 8);
+            case Kind::Uint64:
+                return static_cast<std::int64_t>(load<std::uint64_t>(m_offset + 8));
+            case Kind::Double:
+                return static_cast<std::int64_t>(load<double>(m_offset + 8));
+            default:
+                return 0;
+            }
+        }
+
+        std::uint64_t as_uint64() const
+        {
+            switch (kind())
+            {
+            case Kind::Int64:
+                return static_cast<std::uint64_t>(load<std::int64_t>(m_offset + 8));
+            case Kind::Uint64:
+                return load<std::uint64_t>(m_offset + 8);
+            case Kind::Double:
+                return static_cast<std::uint64_t>(load<double>(m_offset + 8));
+            default:
+                return 0;
+            }
+        }
+
+        double as_double() const
+        {
+            switch (kind())
+            {
+            case Kind::Int64:
+                return static_cast<double>(load<std::int64_t>(m_offset + 8));
+            case Kind::Uint64:
+                return static_cast<double>(load<std::uint64_t>(m_offset + 8));
+            case Kind::Double:
+                return load<double>(m_offset + 8);
+            default:
+                return 0;
+            }
+        }
+
+        StringRef as_string() const
+        {
+            if (m_kind != Kind::String && m_kind != Kind::Binary)
+                return StringRef();
+            return StringRef(m_base + m_offset + 8, m_count);
+        }
+
+        // Element of an array, or an absent node past its end
+        Node operator[](SizeType i) const
+        {
+            if (m_kind != Kind::Array || i >= m_count)
+                return Node();
+            return child(m_offset + 8 + 8 * std::uint64_t(i));
+        }
+
+        // Key of the i-th member of an object
+        StringRef key_at(SizeType i) const
+        {
+            if (m_kind != Kind::Object || i >= m_count)
+                return StringRef();
+            return child(m_offset + 8 + 16 * std::uint64_t(i)).as_string();
+        }
+
+        // Value of the i-th member of an object
+        Node value_at(SizeType i) const
+        {
+            if (m_kind != Kind::Object || i >= m_count)
+                return Node();
+            return child(m_offset + 16 + 16 * std::uint64_t(i));
+        }
+
+        // Binary search over the sorted members of an object; returns an absent node if not found
+        Node find(const char* key, std::size_t length) const
+        {
+            if (kind() != Kind::Object)
+                return Node();
+            SizeType low = 0, high = size();
+            while (low < high)
+            {
+                SizeType mid = low + (high - low) / 2;
+                int c = key_at(mid).compare(key, length);
+                if (c < 0)
+                    low = mid + 1;
+                else
+                    high = mid;
+            }
+            if (low < size() && key_at(low).compare(key, length) == 0)
+                return value_at(low);
+            return Node();
+        }
+
+        Node find(const char* key) const { return find(key, std::strlen(key)); }
+
+        Node find(const std::string& key) const { return find(key.data(), key.size()); }
+    };
+
+    // Read-only typed view over a node. Each view keeps its node only if it is of the kind its type
+    // is frozen as, and is backed by an absent node otherwise.
+    //
+    // The primary template covers registered class types. Members of types declared with
+    // `STATICJSON_FIELDS` are reached with `field<I>()`, typed by the declaration; those of other
+    // types with `get<M>("key")`, whose type is checked only against the kind of the member.
+    template <class T, class Enable = void>
+    class View
+    {
+    private:
+        Node m_node;
+
+    public:
+        View() {}
+        explicit View(Node node) : m_node(node.of_kind(Kind::Object)) {}
+
+        const Node& node() const { return m_node; }
+
+        bool has(const char* key) const { return m_node.find(key).exists(); }
+
+        template <class M>
+        View<M> get(const char* key) const
+        {
+            return View<M>(m_node.find(key));
+        }
+
+        template <std::size_t I, class U = T>
+        View<typename FieldList<U>::template field<I>::value_type> field() const
+        {
+            typedef typename FieldList<U>::template field<I> F;
+            return View<typename F::value_type>(m_node.find(F::name(), F::length()));
+        }
+    };
+
+    template <class T>
+    class View<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+    private:
+        // `char` is serialized as a boolean, see `Handler<char>`
+        static const bool is_boolean = std::is_same<T, bool>::value || std::is_same<T, char>::value;
+
+        Node m_node;
+
+        T convert(std::integral_constant<int, 0>) const { return m_node.as_bool(); }
+
+        T convert(std::integral_constant<int, 1>) const
+        {
+            return static_cast<T>(m_node.as_double());
+        }
+
+        T convert(std::integral_constant<int, 2>) const
+        {
+            return static_cast<T>(m_node.as_int64());
+        }
+
+        T convert(std::integral_constant<int, 3>) const
+        {
+            return static_cast<T>(m_node.as_uint64());
+        }
+
+    public:
+        View() {}
+        explicit View(Node node)
+            : m_node(is_boolean ? node.of_kind(Kind::Bool) : node.is_number() ? node : Node())
+        {
+        }
+
+        const Node& node() const { return m_node; }
+
+        T get() const
+        {
+            return convert(std::integral_constant<int,
+                                                   is_boolean
+                                                       ? 0
+                                                       : std::is_floating_point<T>::value
+                                                           ? 1
+                                                           : std::is_signed<T>::value ? 2 : 3>());
+        }
+
+        operator T() const { return get(); }
+    };
+
+    template <>
+    class View<std::string> : public StringRef
+    {
+    private:
+        Node m_node;
+
+    public:
+        View() {}
+        explicit View(Node node)
+            : StringRef(node.of_kind(Kind::String).as_string()), m_node(node.of_kind(Kind::String))
+        {
+        }
+
+        const Node& node() const { return m_node; }
+
+        StringRef get() const { return *this; }
+    };
+
+    template <>
+    class View<Bytes>
+    {
+    private:
+        Node m_node;
+
+    public:
+        View() {}
+        explicit View(Node node) : m_node(node.of_kind(Kind::Binary)) {}
+
+        const Node& node() const { return m_node; }
+
+        const std::uint8_t* data() const
+        {
+            return reinterpret_cast<const std::uint8_t*>(m_node.as_string().data());
+        }
+
+        std::size_t size() const { return m_node.as_string().size(); }
+    };
+
+    template <>
+    class View<Document> : public Node
+    {
+    public:
+        View() {}
+        explicit View(Node node) : Node(node) {}
+
+        const Node& node() const { return *this; }
+    };
+
+    template <class T>
+    class SequenceView
+    {
+    private:
+        Node m_node;
+
+    public:
+        class const_iterator
+        {
+        private:
+            Node m_node;
+            SizeType m_index;
+
+        public:
+            const_iterator(Node node, SizeType index) : m_node(node), m_index(index) {}
+
+            View<T> operator*() const { return View<T>(m_node[m_index]); }
+
+            const_iterator& operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+
+            bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+
+            bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+        };
+
+        SequenceView() {}
+        explicit SequenceView(Node node) : m_node(node.of_kind(Kind::Array)) {}
+
+        const Node& node() const { return m_node; }
+
+        SizeType size() const { return m_node.size(); }
+
+        bool empty() const { return size() == 0; }
+
+        View<T> operator[](SizeType i) const { return View<T>(m_node[i]); }
+
+        const_iterator begin() const { return const_iterator(m_node, 0); }
+
+        const_iterator end() const { return const_iterator(m_node, size()); }
+    };
+
+    template <class T>
+    class View<std::vector<T>> : public SequenceView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : SequenceView<T>(node) {}
+    };
+
+    template <class T>
+    class View<std::deque<T>> : public SequenceView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : SequenceView<T>(node) {}
+    };
+
+    template <class T>
+    class View<std::list<T>> : public SequenceView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : SequenceView<T>(node) {}
+    };
+
+    template <class T, std::size_t N>
+    class View<std::array<T, N>> : public SequenceView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : SequenceView<T>(node) {}
+    };
+
+    template <class T>
+    class MapView
+    {
+    private:
+        Node m_node;
+
+    public:
+        MapView() {}
+        explicit MapView(Node node) : m_node(node.of_kind(Kind::Object)) {}
+
+        const Node& node() const { return m_node; }
+
+        SizeType size() const { return m_node.size(); }
+
+        bool empty() const { return size() == 0; }
+
+        bool contains(const std::string& key) const { return m_node.find(key).exists(); }
+
+        // The returned view is backed by an absent node if the key does not exist
+        View<T> find(const std::string& key) const { return View<T>(m_node.find(key)); }
+
+        StringRef key_at(SizeType i) const { return m_node.key_at(i); }
+
+        View<T> value_at(SizeType i) const { return View<T>(m_node.value_at(i)); }
+    };
+
+    template <class T, class Hash, class Equal>
+    class View<std::unordered_map<std::string, T, Hash, Equal>> : public MapView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : MapView<T>(node) {}
+    };
+
+    template <class T, class Compare>
+    class View<std::map<std::string, T, Compare>> : public MapView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : MapView<T>(node) {}
+    };
+
+    template <class T>
+    class NullableView
+    {
+    private:
+        Node m_node;
+
+    public:
+        NullableView() {}
+        explicit NullableView(Node node) : m_node(node) {}
+
+        const Node& node() const { return m_node; }
+
+        explicit operator bool() const { return !m_node.is_null(); }
+
+        View<T> operator*() const { return View<T>(m_node); }
+    };
+
+    template <class T, class Deleter>
+    class View<std::unique_ptr<T, Deleter>> : public NullableView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : NullableView<T>(node) {}
+    };
+
+    template <class T>
+    class View<std::shared_ptr<T>> : public NullableView<T>
+    {
+    public:
+        View() {}
+        explicit View(Node node) : NullableView<T>(node) {}
+    };
+
+    // Owns the bytes of an image, either memory mapped from a file or held in memory
+    class Image : private NonMobile
+    {
+    private:
+        std::string m_owned;
+        void* m_mapping;
+        std::size_t m_size;
+        const char* m_data;
+
+        void close();
+        bool validate();
+
+    public:
+        Image();
+        ~Image();
+
+        // Maps the file read-only; its pages are shared with other processes mapping it
+        bool open(const char* filename);
+
+        bool open(const std::string& filename) { return open(filename.c_str()); }
+
+        bool assign(std::string buffer);
+
+        bool valid() const { return m_data != nullptr; }
+
+        const char* data() const { return m_data; }
+
+        std::size_t size() const { return m_size; }
+
+        Node root() const;
+
+        template <class T>
+        View<T> root_as() const
+        {
+            return View<T>(root());
+        }
+    };
+}
+
+namespace nonpublic
+{
+    std::string freeze(const BaseHandler* handler);
+    bool freeze_to_file(std::FILE* fp, const BaseHandler* handler);
+}
+
+template <class T>
+inline std::string freeze(const T& value)
+{
+    Handler<T> h(const_cast<T*>(&value));
+    return nonpublic::freeze(&h);
+}
+
+template <class T>
+inline bool freeze_to_file(const char* filename, const T& value)
+{
+    Handler<T> h(const_cast<T*>(&value));
+    nonpublic::FileGuard fg(std::fopen(filename, "wb"));
+    return nonpublic::freeze_to_file(fg.fp, &h);
+}
+
+template <class T>
+inline bool freeze_to_file(const std::string& filename, const T& value)
+{
+    return freeze_to_file(filename.c_str(), value);
+}
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+#include <staticjson/io.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace staticjson
+{
+
+// Knobs for `generate_json`. Sizes are inclusive ranges; schema constraints such as the fixed
+// length of `std::array` take precedence.
+struct GeneratorOptions
+{
+    std::size_t min_string_length = 0, max_string_length = 16;
+    std::size_t min_array_size = 0, max_array_size = 8;
+
+    // Number of entries in maps and free-form objects
+    std::size_t min_map_size = 0, max_map_size = 4;
+
+    // Probability that an optional field is present, and that a nullable value is not null
+    double optional_field_rate = 0.5;
+
+    // Probability that an object which tolerates unknown keys receives an extra field
+    double unknown_field_rate = 0.0;
+
+    // Beyond this depth optional parts are omitted and containers are kept as small as allowed
+    unsigned max_depth = 8;
+
+    // When nonzero and the root is an array or a map, elements are appended until the output
+    // reaches this many bytes
+    std::size_t target_size = 0;
+
+    std::uint64_t seed = 0;
+};
+
+namespace nonpublic
+{
+    std::string generate_json(const BaseHandler* handler, const GeneratorOptions& options);
+    bool generate_json_file(std::FILE* fp,
+                            const BaseHandler* handler,
+                            const GeneratorOptions& options);
+}
+
+// Emits random JSON that a `Handler<T>` accepts, following the structure its schema describes
+template <class T>
+inline std::string generate_json(const GeneratorOptions& options = GeneratorOptions())
+{
+    T dummy;
+    Handler<T> h(&dummy);
+    return nonpublic::generate_json(&h, options);
+}
+
+// Streams the output, so the size is not limited by memory
+template <class T>
+inline bool generate_json_file(const char* filename,
+                               const GeneratorOptions& options = GeneratorOptions())
+{
+    T dummy;
+    Handler<T> h(&dummy);
+    nonpublic::FileGuard fg(std::fopen(filename, "wb"));
+    return nonpublic::generate_json_file(fg.fp, &h, options);
+}
+}
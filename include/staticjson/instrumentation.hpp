@@ -0,0 +1,109 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+#include <staticjson/io.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace staticjson
+{
+
+struct AllocationCounter
+{
+    std::size_t count;
+    std::size_t bytes;
+};
+
+// Allocations made by the calling thread during one call. Only collected when the program
+// includes <staticjson/allocation_hooks.hpp> in one of its translation units.
+struct AllocationStats
+{
+    bool instrumented = false;
+
+    // Building the `Handler<T>` tree before any input is seen
+    AllocationCounter handler_construction = {0, 0};
+
+    // Everything after that: the contents of `T` plus handlers created lazily while parsing
+    AllocationCounter parse = {0, 0};
+
+    // Writing, including the growth of the output buffer
+    AllocationCounter serialize = {0, 0};
+};
+
+namespace nonpublic
+{
+    void record_allocation(std::size_t size);
+    void mark_allocation_hooks_installed();
+    bool allocation_hooks_installed();
+    AllocationCounter allocations_so_far();
+
+    inline AllocationCounter allocations_since(AllocationCounter start)
+    {
+        AllocationCounter now = allocations_so_far();
+        AllocationCounter result = {now.count - start.count, now.bytes - start.bytes};
+        return result;
+    }
+}
+
+template <class T>
+inline bool
+from_json_string(const char* str, T* value, ParseStatus* status, AllocationStats* stats)
+{
+    stats->instrumented = nonpublic::allocation_hooks_installed();
+    AllocationCounter start = nonpublic::allocations_so_far();
+    Handler<T> h(value);
+    stats->handler_construction = nonpublic::allocations_since(start);
+    start = nonpublic::allocations_so_far();
+    bool success = nonpublic::parse_json_string(str, &h, status);
+    stats->parse = nonpublic::allocations_since(start);
+    return success;
+}
+
+template <class T>
+inline bool
+from_json_file(const char* filename, T* value, ParseStatus* status, AllocationStats* stats)
+{
+    stats->instrumented = nonpublic::allocation_hooks_installed();
+    AllocationCounter start = nonpublic::allocations_so_far();
+    Handler<T> h(value);
+    stats->handler_construction = nonpublic::allocations_since(start);
+    start = nonpublic::allocations_so_far();
+    nonpublic::FileGuard fg(std::fopen(filename, "r"));
+    bool success = nonpublic::parse_json_file(fg.fp, &h, status);
+    stats->parse = nonpublic::allocations_since(start);
+    return success;
+}
+
+template <class T>
+inline bool
+from_json_file(const std::string& filename, T* value, ParseStatus* status, AllocationStats* stats)
+{
+    return from_json_file(filename.c_str(), value, status, stats);
+}
+
+template <class T>
+inline std::string to_json_string(const T& value, AllocationStats* stats)
+{
+    stats->instrumented = nonpublic::allocation_hooks_installed();
+    AllocationCounter start = nonpublic::allocations_so_far();
+    Handler<T> h(const_cast<T*>(&value));
+    stats->handler_construction = nonpublic::allocations_since(start);
+    start = nonpublic::allocations_so_far();
+    std::string result = nonpublic::serialize_json_string(&h);
+    stats->serialize = nonpublic::allocations_since(start);
+    return result;
+}
+
+// Number and size of the handlers needed to parse into `value`. Handlers that are only created
+// while parsing, such as those for the pointee of a smart pointer, are not included.
+template <class T>
+inline HandlerFootprint handler_footprint(T* value)
+{
+    Handler<T> h(value);
+    HandlerFootprint footprint;
+    footprint.bytes = sizeof(h);
+    h.accumulate_footprint(&footprint);
+    return footprint;
+}
+}
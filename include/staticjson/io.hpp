@@ -2,16 +2,84 @@
 
 #include <staticjson/basic.hpp>
 
+#include <rapidjson/filereadstream.h>
+#include <rapidjson/reader.h>
+
+#include <cstdint>
 #include <cstdio>
 #include <string>
+#include <utility>
 
 namespace staticjson
 {
 
 namespace nonpublic
 {
-    bool parse_json_string(const char* str, BaseHandler* handler, ParseStatus* status);
-    bool parse_json_file(std::FILE* fp, BaseHandler* handler, ParseStatus* status);
+    bool parse_json_string(const char* str,
+                           BaseHandler* handler,
+                           ParseStatus* status,
+                           const ParseOptions* options = nullptr);
+    bool parse_json_file(std::FILE* fp,
+                         BaseHandler* handler,
+                         ParseStatus* status,
+                         const ParseOptions* options = nullptr);
+    class ParseChain;
+
+    // Interposes the handlers implementing statistics and `ParseOptions` for one parse, and
+    // reports its outcome. Without either, events go straight to the target handler.
+    class ParseSession : private NonMobile
+    {
+    private:
+        BaseHandler* m_handler;
+        ParseStatus* m_status;
+        ParseChain* m_chain;
+
+    public:
+        explicit ParseSession(BaseHandler* handler,
+                              ParseStatus* status,
+                              const ParseOptions* options);
+        ~ParseSession();
+
+        bool interposed() const { return m_chain != nullptr; }
+
+        // The first of the interposed handlers; only valid when `interposed()`
+        IHandler* handler() const;
+
+        // `consumed` is the position of the input stream, used when parsing succeeded
+        bool finish(rapidjson::ParseResult rc, std::size_t consumed);
+    };
+
+    // Full precision is provided by the library's own number conversion in
+    // `IHandler::RawNumber`, which is much faster than rapidjson's, so the parser only has to
+    // hand over the text of each number
+    template <unsigned parseFlags>
+    struct ReaderFlags
+    {
+        static const unsigned value = (parseFlags & rapidjson::kParseFullPrecisionFlag)
+            ? (parseFlags & ~unsigned(rapidjson::kParseFullPrecisionFlag))
+                | rapidjson::kParseNumbersAsStringsFlag
+            : parseFlags;
+    };
+
+    template <unsigned parseFlags, class InputStream>
+    inline bool
+    read_json(InputStream& is, BaseHandler* h, ParseStatus* status, const ParseOptions* options)
+    {
+        const unsigned flags = ReaderFlags<parseFlags>::value;
+        ParseSession session(h, status, options);
+        rapidjson::Reader r;
+        rapidjson::ParseResult rc;
+        // Limits are meant for untrusted input, which must not be able to exhaust the stack of
+        // the recursive parser either
+        if (options && options->limits.any())
+            rc = r.Parse<flags | rapidjson::kParseIterativeFlag>(is, *session.handler());
+        else if (session.interposed())
+            rc = r.Parse<flags>(is, *session.handler());
+        else
+            rc = r.Parse<flags>(is, *h);
+        return session.finish(rc, is.Tell());
+    }
+
     std::string serialize_json_string(const BaseHandler* handler);
     bool serialize_json_file(std::FILE* fp, const BaseHandler* handler);
     std::string serialize_pretty_json_string(const BaseHandler* handler);
@@ -28,6 +96,39 @@ namespace nonpublic
                 std::fclose(fp);
         }
     };
+
+    struct SourceFile
+    {
+        std::string content;
+        std::uint64_t size;
+        std::int64_t mtime;
+        std::uint64_t hash;
+    };
+
+    bool read_source_file(const char* filename, SourceFile* source);
+    std::uint64_t handler_fingerprint(const BaseHandler* handler);
+    bool parse_snapshot(const char* filename,
+                        std::uint64_t fingerprint,
+                        const SourceFile& source,
+                        BaseHandler* handler,
+                        ParseStatus* status,
+                        const ParseOptions* options);
+    void write_snapshot(const char* filename,
+                        std::uint64_t fingerprint,
+                        const SourceFile& source,
+                        const BaseHandler* handler);
+
+    // Hash of the schema the handler tree of `T` would export, computed once per type
+    template <class T>
+    inline std::uint64_t type_fingerprint()
+    {
+        static const std::uint64_t result = []() {
+            T dummy;
+            Handler<T> h(&dummy);
+            return handler_fingerprint(&h);
+        }();
+        return result;
+    }
 }
 
 template <class T>
@@ -57,6 +158,204 @@ inline bool from_json_file(const std::string& filename, T* value, ParseStatus* s
     return from_json_file(filename.c_str(), value, status);
 }
 
+// The variants below take rapidjson parse flags, such as `kParseFullPrecisionFlag` or
+// `kParseStopWhenDoneFlag`, as their first template argument:
+//
+//     staticjson::from_json_string<rapidjson::kParseFullPrecisionFlag>(str, &value, &status);
+template <unsigned parseFlags, class T>
+inline bool from_json_string(const char* str, T* value, ParseStatus* status)
+{
+    static_assert(!(parseFlags & rapidjson::kParseInsituFlag), "Use from_json_insitu instead");
+    Handler<T> h(value);
+    rapidjson::StringStream is(str);
+    return nonpublic::read_json<parseFlags>(is, &h, status, nullptr);
+}
+
+template <unsigned parseFlags, class T>
+inline bool
+from_json_string(const char* str, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    static_assert(!(parseFlags & rapidjson::kParseInsituFlag), "Use from_json_insitu instead");
+    Handler<T> h(value);
+    rapidjson::StringStream is(str);
+    return nonpublic::read_json<parseFlags>(is, &h, status, &options);
+}
+
+// Parses in place, overwriting the contents of `str`. This saves the copies of strings the
+// parser would otherwise make while unescaping them.
+template <unsigned parseFlags, class T>
+inline bool from_json_insitu(char* str, T* value, ParseStatus* status)
+{
+    Handler<T> h(value);
+    rapidjson::InsituStringStream is(str);
+    return nonpublic::read_json<parseFlags | rapidjson::kParseInsituFlag>(is, &h, status, nullptr);
+}
+
+template <class T>
+inline bool from_json_insitu(char* str, T* value, ParseStatus* status)
+{
+    return from_json_insitu<rapidjson::kParseDefaultFlags>(str, value, status);
+}
+
+template <unsigned parseFlags, class T>
+inline bool from_json_file(std::FILE* fp, T* value, ParseStatus* status)
+{
+    static_assert(!(parseFlags & rapidjson::kParseInsituFlag), "Files cannot be parsed in place");
+    if (!fp)
+        return false;
+    Handler<T> h(value);
+    char buffer[1000];
+    rapidjson::FileReadStream is(fp, buffer, sizeof(buffer));
+    return nonpublic::read_json<parseFlags>(is, &h, status, nullptr);
+}
+
+template <unsigned parseFlags, class T>
+inline bool from_json_file(const char* filename, T* value, ParseStatus* status)
+{
+    nonpublic::FileGuard fg(std::fopen(filename, "r"));
+    return from_json_file<parseFlags>(fg.fp, value, status);
+}
+
+template <unsigned parseFlags, class T>
+inline bool from_json_file(const std::string& filename, T* value, ParseStatus* status)
+{
+    return from_json_file<parseFlags>(filename.c_str(), value, status);
+}
+
+template <unsigned parseFlags, class T>
+inline bool
+from_json_file(std::FILE* fp, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    static_assert(!(parseFlags & rapidjson::kParseInsituFlag), "Files cannot be parsed in place");
+    if (!fp)
+        return false;
+    Handler<T> h(value);
+    char buffer[1000];
+    rapidjson::FileReadStream is(fp, buffer, sizeof(buffer));
+    return nonpublic::read_json<parseFlags>(is, &h, status, &options);
+}
+
+template <unsigned parseFlags, class T>
+inline bool
+from_json_file(const char* filename, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    nonpublic::FileGuard fg(std::fopen(filename, "r"));
+    return from_json_file<parseFlags>(fg.fp, value, status, options);
+}
+
+template <unsigned parseFlags, class T>
+inline bool from_json_file(const std::string& filename,
+                           T* value,
+                           ParseStatus* status,
+                           const ParseOptions& options)
+{
+    return from_json_file<parseFlags>(filename.c_str(), value, status, options);
+}
+
+template <class T>
+inline bool
+from_json_string(const char* str, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    Handler<T> h(value);
+    return nonpublic::parse_json_string(str, &h, status, &options);
+}
+
+template <class T>
+inline bool
+from_json_file(std::FILE* fp, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    Handler<T> h(value);
+    return nonpublic::parse_json_file(fp, &h, status, &options);
+}
+
+template <class T>
+inline bool
+from_json_file(const char* filename, T* value, ParseStatus* status, const ParseOptions& options)
+{
+    nonpublic::FileGuard fg(std::fopen(filename, "r"));
+    return from_json_file(fg.fp, value, status, options);
+}
+
+template <class T>
+inline bool from_json_file(const std::string& filename,
+                           T* value,
+                           ParseStatus* status,
+                           const ParseOptions& options)
+{
+    return from_json_file(filename.c_str(), value, status, options);
+}
+
+namespace nonpublic
+{
+    template <class T>
+    inline bool parse_json_file_with_cache(const char* filename,
+                                           T* value,
+                                           ParseStatus* status,
+                                           const ParseOptions* options)
+    {
+        SourceFile source;
+        if (!read_source_file(filename, &source))
+            return false;
+        // A sampled result is not the value of the file, so it is neither read nor cached
+        if (options && options->sampling.any())
+        {
+            Handler<T> h(value);
+            return parse_json_string(source.content.c_str(), &h, status, options);
+        }
+        std::uint64_t fingerprint = type_fingerprint<T>();
+        {
+            // A snapshot that fails to decode must not leave anything behind in `value`
+            T cached;
+            Handler<T> h(&cached);
+            if (parse_snapshot(filename, fingerprint, source, &h, status, options))
+            {
+                *value = std::move(cached);
+                return true;
+            }
+        }
+        Handler<T> h(value);
+        if (!parse_json_string(source.content.c_str(), &h, status, options))
+            return false;
+        Handler<T> writer(value);
+        write_snapshot(filename, fingerprint, source, &writer);
+        return true;
+    }
+}
+
+// Like `from_json_file`, but keeps a binary snapshot of the result in `<filename>.sjc`.
+// The snapshot is only used when both the source file and the shape of `T` are unchanged.
+template <class T>
+inline bool from_json_file_with_cache(const char* filename, T* value, ParseStatus* status)
+{
+    return nonpublic::parse_json_file_with_cache(filename, value, status, nullptr);
+}
+
+template <class T>
+inline bool from_json_file_with_cache(const std::string& filename, T* value, ParseStatus* status)
+{
+    return from_json_file_with_cache(filename.c_str(), value, status);
+}
+
+// Limits, the deadline and cancellation apply to decoding the snapshot as well. With sampling
+// enabled the snapshot is bypassed.
+template <class T>
+inline bool from_json_file_with_cache(const char* filename,
+                                      T* value,
+                                      ParseStatus* status,
+                                      const ParseOptions& options)
+{
+    return nonpublic::parse_json_file_with_cache(filename, value, status, &options);
+}
+
+template <class T>
+inline bool from_json_file_with_cache(const std::string& filename,
+                                      T* value,
+                                      ParseStatus* status,
+                                      const ParseOptions& options)
+{
+    return from_json_file_with_cache(filename.c_str(), value, status, options);
+}
+
 template <class T>
 inline std::string to_json_string(const T& value)
 {
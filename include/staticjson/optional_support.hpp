@@ -2,6 +2,9 @@
 
 #include "stl_types.hpp"
 
+#include <string>
+#include <type_traits>
+
 #ifdef __has_include
 #if __has_include(<optional>)
 #include <optional>
@@ -40,20 +43,36 @@ namespace nonpublic
 
 namespace staticjson
 {
+namespace nonpublic
+{
+    // Values parsed by a single scalar event
+    template <class T>
+    struct is_scalar_optional
+        : public std::integral_constant<bool,
+                                        std::is_arithmetic<T>::value
+                                            || std::is_same<T, std::string>::value>
+    {
+    };
+}
 
+// Parses in place. The contained value is created, and the element handler bound to it, on the
+// first event; resetting disengages the optional but keeps the handler, which then sees a fresh
+// value at the same address when the optional is engaged again. Optionals in arrays or reused
+// objects therefore build their element handler only once. Writing and schema generation leave
+// that handler alone and go through a handler of their own, as containers do for elements.
 template <class T>
-class Handler<nonpublic::optional<T>> : public BaseHandler
+class OptionalHandler : public BaseHandler
 {
 public:
     using ElementType = T;
 
 protected:
-    mutable nonpublic::optional<T>* m_value;
-    mutable nonpublic::optional<Handler<ElementType>> internal_handler;
+    nonpublic::optional<T>* m_value;
+    nonpublic::optional<Handler<ElementType>> internal_handler;
     int depth = 0;
 
 public:
-    explicit Handler(nonpublic::optional<T>* value) : m_value(value) {}
+    explicit OptionalHandler(nonpublic::optional<T>* value) : m_value(value) {}
 
 protected:
     void initialize()
@@ -63,12 +82,17 @@ protected:
             m_value->emplace();
             internal_handler.emplace(&(**m_value));
         }
+        else if (!*m_value)
+        {
+            m_value->emplace();
+        }
     }
 
     void reset() override
     {
         depth = 0;
-        internal_handler = nonpublic::nullopt;
+        if (internal_handler)
+            internal_handler->prepare_for_reuse();
         *m_value = nonpublic::nullopt;
     }
 
@@ -101,27 +125,32 @@ public:
         {
             return out->Null();
         }
-        if (!internal_handler)
-        {
-            internal_handler.emplace(&(**m_value));
-        }
-        return internal_handler->write(out);
+        Handler<ElementType> h(&(**m_value));
+        return h.write(out);
     }
 
     void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
     {
-        const_cast<Handler<nonpublic::optional<T>>*>(this)->initialize();
         output.SetObject();
         Value anyOf(rapidjson::kArrayType);
         Value nullDescriptor(rapidjson::kObjectType);
         nullDescriptor.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("null"), alloc);
         Value descriptor;
-        internal_handler->generate_schema(descriptor, alloc);
+        ElementType element;
+        Handler<ElementType> h(&element);
+        h.generate_schema(descriptor, alloc);
         anyOf.PushBack(nullDescriptor, alloc);
         anyOf.PushBack(descriptor, alloc);
         output.AddMember(rapidjson::StringRef("anyOf"), anyOf, alloc);
     }
 
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        if (internal_handler)
+            internal_handler->accumulate_footprint(footprint);
+    }
+
     bool Bool(bool b) override
     {
         initialize();
@@ -164,6 +193,18 @@ public:
         return postcheck(internal_handler->String(str, len, copy));
     }
 
+    bool Binary(const std::uint8_t* data, SizeType len) override
+    {
+        initialize();
+        return postcheck(internal_handler->Binary(data, len));
+    }
+
+    bool RawNumber(const char* str, SizeType len, bool copy) override
+    {
+        initialize();
+        return postcheck(internal_handler->RawNumber(str, len, copy));
+    }
+
     bool Key(const char* str, SizeType len, bool copy) override
     {
         initialize();
@@ -211,7 +252,145 @@ public:
         {
             return "std::optional<" + this->internal_handler->type_name() + ">";
         }
-        return "std::optional";
+        // Named the same before any value is parsed, as `OptionalScalarHandler` names it
+        ElementType element;
+        Handler<ElementType> h(&element);
+        return "std::optional<" + h.type_name() + ">";
+    }
+};
+
+// Optional numbers, booleans and strings: the value is parsed by a plain scalar handler and copied
+// in once complete, so no per-event engagement or depth checks are needed.
+template <class T>
+class OptionalScalarHandler : public BaseHandler
+{
+public:
+    using ElementType = T;
+
+protected:
+    T element;
+    Handler<ElementType> internal;
+    nonpublic::optional<T>* m_value;
+
+protected:
+    bool store(bool success)
+    {
+        if (success)
+        {
+            *m_value = std::move(element);
+            this->parsed = true;
+        }
+        return success;
+    }
+
+    void reset() override
+    {
+        internal.prepare_for_reuse();
+        *m_value = nonpublic::nullopt;
+    }
+
+public:
+    explicit OptionalScalarHandler(nonpublic::optional<T>* value)
+        : element(), internal(&element), m_value(value)
+    {
+    }
+
+    bool Null() override
+    {
+        *m_value = nonpublic::nullopt;
+        this->parsed = true;
+        return true;
+    }
+
+    bool Bool(bool b) override { return store(internal.Bool(b)); }
+
+    bool Int(int i) override { return store(internal.Int(i)); }
+
+    bool Uint(unsigned i) override { return store(internal.Uint(i)); }
+
+    bool Int64(std::int64_t i) override { return store(internal.Int64(i)); }
+
+    bool Uint64(std::uint64_t i) override { return store(internal.Uint64(i)); }
+
+    bool Double(double d) override { return store(internal.Double(d)); }
+
+    bool String(const char* str, SizeType len, bool copy) override
+    {
+        return store(internal.String(str, len, copy));
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType len) override
+    {
+        return store(internal.Binary(data, len));
+    }
+
+    bool RawNumber(const char* str, SizeType len, bool copy) override
+    {
+        return store(internal.RawNumber(str, len, copy));
+    }
+
+    bool Key(const char* str, SizeType len, bool copy) override
+    {
+        return internal.Key(str, len, copy);
+    }
+
+    bool StartObject() override { return internal.StartObject(); }
+
+    bool EndObject(SizeType len) override { return internal.EndObject(len); }
+
+    bool StartArray() override { return internal.StartArray(); }
+
+    bool EndArray(SizeType len) override { return internal.EndArray(len); }
+
+    bool has_error() const override { return internal.has_error(); }
+
+    bool reap_error(ErrorStack& stk) override { return internal.reap_error(stk); }
+
+    bool write(IHandler* out) const override
+    {
+        if (!m_value || !(*m_value))
+            return out->Null();
+        Handler<ElementType> h(&(**m_value));
+        return h.write(out);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        Value anyOf(rapidjson::kArrayType);
+        Value nullDescriptor(rapidjson::kObjectType);
+        nullDescriptor.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("null"), alloc);
+        Value descriptor;
+        internal.generate_schema(descriptor, alloc);
+        anyOf.PushBack(nullDescriptor, alloc);
+        anyOf.PushBack(descriptor, alloc);
+        output.AddMember(rapidjson::StringRef("anyOf"), anyOf, alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+
+    std::string type_name() const override
+    {
+        return "std::optional<" + internal.type_name() + ">";
+    }
+};
+
+template <class T>
+class Handler<nonpublic::optional<T>>
+    : public std::conditional<nonpublic::is_scalar_optional<T>::value,
+                              OptionalScalarHandler<T>,
+                              OptionalHandler<T>>::type
+{
+public:
+    explicit Handler(nonpublic::optional<T>* value)
+        : std::conditional<nonpublic::is_scalar_optional<T>::value,
+                           OptionalScalarHandler<T>,
+                           OptionalHandler<T>>::type(value)
+    {
     }
 };
 }
@@ -1,12 +1,35 @@
 #pragma once
 #include <staticjson/basic.hpp>
 
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 namespace staticjson
 {
+namespace nonpublic
+{
+    std::string base64_encode(const std::uint8_t* data, std::size_t size);
+    bool base64_decode(const char* str, std::size_t length, std::vector<std::uint8_t>* out);
+
+    // Correctly rounded conversions of JSON number text. They fail on malformed text and on
+    // values too large for the type.
+    bool parse_double(const char* str, std::size_t length, double* out);
+    bool parse_float(const char* str, std::size_t length, float* out);
+
+    // Makes the parse running on this thread fail with `kParseErrorNumberTooBig`
+    void report_number_too_big();
+
+    inline bool is_integer_text(const char* str, std::size_t length)
+    {
+        for (std::size_t i = 0; i < length; ++i)
+            if (str[i] == '.' || str[i] == 'e' || str[i] == 'E')
+                return false;
+        return true;
+    }
+}
 
 template <class IntType>
 class IntegerHandler : public BaseHandler
@@ -344,6 +367,20 @@ public:
         return true;
     }
 
+    // Converting the text directly avoids rounding twice, first to double and then to float
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        if (nonpublic::is_integer_text(str, length))
+            return BaseHandler::RawNumber(str, length, copy);
+        if (!nonpublic::parse_float(str, length, m_value))
+        {
+            nonpublic::report_number_too_big();
+            return set_out_of_range("float");
+        }
+        this->parsed = true;
+        return true;
+    }
+
     std::string type_name() const override { return "float"; }
 
     bool write(IHandler* out) const override { return out->Double(*m_value); }
@@ -366,6 +403,8 @@ public:
 
     bool String(const char* str, SizeType length, bool) override
     {
+        if (!nonpublic::charge_allocation(length, this->the_error))
+            return false;
         m_value->assign(str, length);
         this->parsed = true;
         return true;
@@ -384,4 +423,59 @@ public:
         output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("string"), alloc);
     }
 };
+
+// A byte string. Binary formats such as CBOR carry it natively; JSON carries it as base64 text.
+class Bytes : public std::vector<std::uint8_t>
+{
+public:
+    using std::vector<std::uint8_t>::vector;
+    Bytes() {}
+};
+
+template <>
+class Handler<Bytes> : public BaseHandler
+{
+private:
+    Bytes* m_value;
+
+public:
+    explicit Handler(Bytes* v) : m_value(v) {}
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        if (!nonpublic::charge_allocation(length, this->the_error))
+            return false;
+        m_value->assign(data, data + length);
+        this->parsed = true;
+        return true;
+    }
+
+    bool String(const char* str, SizeType length, bool) override
+    {
+        if (!nonpublic::charge_allocation(length / 4 * 3, this->the_error))
+            return false;
+        if (!nonpublic::base64_decode(str, length, m_value))
+        {
+            the_error.reset(new error::CustomError("Invalid base64 encoding"));
+            return false;
+        }
+        this->parsed = true;
+        return true;
+    }
+
+    std::string type_name() const override { return "bytes"; }
+
+    bool write(IHandler* out) const override
+    {
+        return out->Binary(m_value->data(), SizeType(m_value->size()));
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("string"), alloc);
+        output.AddMember(
+            rapidjson::StringRef("contentEncoding"), rapidjson::StringRef("base64"), alloc);
+    }
+};
 }
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <staticjson/basic.hpp>
+#include <staticjson/io.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace staticjson
+{
+// Parses records of several types that share one stream, each an object naming its kind in an
+// envelope member such as "kind". Every record is parsed once, straight into the `Handler<T>`
+// registered for its kind, and the value is then handed to the callback of that kind. Records
+// naming their kind first take the direct path; for others, the members before the kind are
+// recorded and replayed.
+class MessageRouter : private NonMobile
+{
+private:
+    class Route
+    {
+    public:
+        virtual ~Route() {}
+
+        // Clears the value and returns its handler, ready for a new record
+        virtual BaseHandler* begin() = 0;
+
+        virtual const BaseHandler* handler() const = 0;
+
+        virtual void deliver() = 0;
+    };
+
+    // The value and its handler are built once and reused by every record of the kind
+    template <class T, class Callback>
+    class TypedRoute : public Route
+    {
+    private:
+        T value;
+        Handler<T> h;
+        Callback callback;
+
+    public:
+        explicit TypedRoute(Callback callback) : value(), h(&value), callback(std::move(callback))
+        {
+        }
+
+        BaseHandler* begin() override
+        {
+            value = T();
+            h.prepare_for_reuse();
+            return &h;
+        }
+
+        const BaseHandler* handler() const override { return &h; }
+
+        void deliver() override { callback(value); }
+    };
+
+    class RecordHandler : public DiscriminatedHandler
+    {
+    private:
+        MessageRouter* m_router;
+        std::string lookup;
+
+    protected:
+        BaseHandler* select(const char* name, SizeType length) override;
+
+    public:
+        explicit RecordHandler(MessageRouter* router, std::string key);
+
+        bool write(IHandler* output) const override;
+
+        void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override;
+
+        std::string type_name() const override;
+    };
+
+private:
+    std::map<std::string, std::unique_ptr<Route>> routes;
+    const std::pair<const std::string, std::unique_ptr<Route>>* current = nullptr;
+    RecordHandler record;
+    std::size_t m_routed = 0;
+
+private:
+    template <class InputStream>
+    bool route_stream(InputStream& is, ParseStatus* status, const ParseOptions* options);
+
+public:
+    explicit MessageRouter(std::string envelope_key);
+    ~MessageRouter();
+
+    // Sends records of `kind` to `callback`, which is called with a `T&` it may move from.
+    // Registering a kind again replaces its route.
+    template <class T, class Callback>
+    void add_route(std::string kind, Callback callback)
+    {
+        current = nullptr;
+        routes[std::move(kind)].reset(new TypedRoute<T, Callback>(std::move(callback)));
+    }
+
+    // Routes a single record
+    bool route(const char* record, ParseStatus* status, const ParseOptions* options = nullptr);
+
+    // Routes the records of newline-delimited JSON in order, stopping at the first record that
+    // fails to parse or has an unknown kind. The offset in `status` is from the start of the
+    // input. Options apply to each record separately.
+    bool route_ndjson(const char* str, ParseStatus* status, const ParseOptions* options = nullptr);
+
+    bool
+    route_ndjson(std::FILE* fp, ParseStatus* status, const ParseOptions* options = nullptr);
+
+    // Records delivered by the last call
+    std::size_t routed() const { return m_routed; }
+
+    // The schema of a record: one alternative per kind
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const
+    {
+        record.generate_schema(output, alloc);
+    }
+};
+}
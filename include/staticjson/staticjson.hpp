@@ -1,7 +1,17 @@
 #pragma once
 #include <staticjson/basic.hpp>
+#include <staticjson/cbor.hpp>
+#include <staticjson/codegen.hpp>
 #include <staticjson/document.hpp>
 #include <staticjson/enum.hpp>
+#include <staticjson/extern_templates.hpp>
+#include <staticjson/fields.hpp>
+#include <staticjson/frozen.hpp>
+#include <staticjson/generator.hpp>
+#include <staticjson/instrumentation.hpp>
 #include <staticjson/io.hpp>
 #include <staticjson/primitive_types.hpp>
+#include <staticjson/router.hpp>
 #include <staticjson/stl_types.hpp>
+#include <staticjson/table.hpp>
+#include <staticjson/tensor.hpp>
@@ -1,13 +1,18 @@
 #pragma once
 #include <staticjson/basic.hpp>
 
+#include <algorithm>
 #include <array>
 #include <deque>
+#include <initializer_list>
 #include <list>
 #include <map>
 #include <memory>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace staticjson
@@ -46,6 +51,8 @@ protected:
         }
         if (internal.is_parsed())
         {
+            if (!nonpublic::charge_allocation(sizeof(ElementType), this->the_error))
+                return false;
             m_value->emplace_back(std::move(element));
             element = ElementType();
             internal.prepare_for_reuse();
@@ -88,6 +95,16 @@ public:
         return precheck("string") && postcheck(internal.String(str, length, copy));
     }
 
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && postcheck(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && postcheck(internal.RawNumber(str, length, copy));
+    }
+
     bool Key(const char* str, SizeType length, bool copy) override
     {
         return precheck("object") && postcheck(internal.Key(str, length, copy));
@@ -131,7 +148,7 @@ public:
 
     bool write(IHandler* output) const override
     {
-        if (!output->StartArray())
+        if (!output->StartSizedArray(static_cast<SizeType>(m_value->size())))
             return false;
         for (auto&& e : *m_value)
         {
@@ -150,13 +167,270 @@ public:
         internal.generate_schema(items, alloc);
         output.AddMember(rapidjson::StringRef("items"), items, alloc);
     }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
 };
 
+namespace nonpublic
+{
+    // `char` is left out because it stands in for `bool`
+    template <class T>
+    struct is_numeric_element
+        : public std::integral_constant<bool,
+                                        std::is_arithmetic<T>::value
+                                            && !std::is_same<T, bool>::value
+                                            && !std::is_same<T, char>::value>
+    {
+    };
+
+    template <class T>
+    void reserve_elements(std::vector<T>* v, std::size_t n)
+    {
+        v->reserve(v->size() + n);
+    }
+
+    template <class ArrayType>
+    void reserve_elements(ArrayType*, std::size_t)
+    {
+    }
+
+    // Writes contiguous elements as one array. Numbers of the types `IHandler::NumberArray`
+    // takes are handed over in one call, so writers can format them in bulk.
+    template <class T>
+    bool write_elements(IHandler* output, T* data, SizeType size)
+    {
+        if (!output->StartSizedArray(size))
+            return false;
+        for (SizeType i = 0; i < size; ++i)
+        {
+            Handler<T> h(data + i);
+            if (!h.write(output))
+                return false;
+        }
+        return output->EndArray(size);
+    }
+
+    inline bool write_elements(IHandler* output, int* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    inline bool write_elements(IHandler* output, unsigned* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    inline bool write_elements(IHandler* output, std::int64_t* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    inline bool write_elements(IHandler* output, std::uint64_t* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    inline bool write_elements(IHandler* output, float* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    inline bool write_elements(IHandler* output, double* data, SizeType size)
+    {
+        return output->NumberArray(data, size);
+    }
+
+    template <class T>
+    bool write_sequence(IHandler* output, std::vector<T>& v)
+    {
+        return write_elements(output, v.data(), static_cast<SizeType>(v.size()));
+    }
+
+    template <class ArrayType>
+    bool write_sequence(IHandler* output, ArrayType& v)
+    {
+        if (!output->StartSizedArray(static_cast<SizeType>(v.size())))
+            return false;
+        for (auto&& e : v)
+        {
+            Handler<typename ArrayType::value_type> h(&e);
+            if (!h.write(output))
+                return false;
+        }
+        return output->EndArray(static_cast<SizeType>(v.size()));
+    }
+}
+
+// Handles arrays of numbers. Every element is converted by the same scalar handler, which keeps
+// no state worth resetting, and appended by value, so there is no per-element move, reset or
+// `is_parsed` check as in `ArrayHandler`. Anything but a flat array of numbers is rejected with
+// the same errors `ArrayHandler` would report.
+template <class ArrayType>
+class NumericArrayHandler : public BaseHandler
+{
+public:
+    typedef typename ArrayType::value_type ElementType;
+
+protected:
+    // Sizes announced by binary formats are untrusted, so only this many elements are reserved
+    static const SizeType max_reserved = 1 << 16;
+
+    ElementType element;
+    Handler<ElementType> internal;
+    ArrayType* m_value;
+    int depth = 0;
+
+protected:
+    bool precheck(const char* type)
+    {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::TypeMismatchError(type_name(), type));
+            return false;
+        }
+        return true;
+    }
+
+    bool append(bool success)
+    {
+        if (!success)
+        {
+            the_error.reset(new error::ArrayElementError(m_value->size()));
+            return false;
+        }
+        if (!nonpublic::charge_allocation(sizeof(ElementType), this->the_error))
+            return false;
+        m_value->push_back(element);
+        return true;
+    }
+
+    void reset() override
+    {
+        internal.prepare_for_reuse();
+        depth = 0;
+    }
+
+public:
+    explicit NumericArrayHandler(ArrayType* value) : element(), internal(&element), m_value(value)
+    {
+    }
+
+    bool Null() override { return precheck("null") && append(internal.Null()); }
+
+    bool Bool(bool b) override { return precheck("bool") && append(internal.Bool(b)); }
+
+    bool Int(int i) override { return precheck("int") && append(internal.Int(i)); }
+
+    bool Uint(unsigned i) override { return precheck("unsigned") && append(internal.Uint(i)); }
+
+    bool Int64(std::int64_t i) override { return precheck("int64_t") && append(internal.Int64(i)); }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return precheck("uint64_t") && append(internal.Uint64(i));
+    }
+
+    bool Double(double d) override { return precheck("double") && append(internal.Double(d)); }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("string") && append(internal.String(str, length, copy));
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && append(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && append(internal.RawNumber(str, length, copy));
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("object") && append(internal.Key(str, length, copy));
+    }
+
+    bool StartObject() override { return precheck("object") && append(internal.StartObject()); }
+
+    bool EndObject(SizeType length) override
+    {
+        return precheck("object") && append(internal.EndObject(length));
+    }
+
+    bool StartArray() override
+    {
+        if (depth > 0)
+            return append(internal.StartArray());
+        ++depth;
+        return true;
+    }
+
+    bool StartSizedArray(SizeType length) override
+    {
+        if (depth == 0)
+            nonpublic::reserve_elements(m_value, std::min(length, max_reserved));
+        return StartArray();
+    }
+
+    bool EndArray(SizeType) override
+    {
+        --depth;
+        this->parsed = true;
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error)
+            return false;
+        stk.push(the_error.release());
+        internal.reap_error(stk);
+        return true;
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return nonpublic::write_sequence(output, *m_value);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("array"), alloc);
+        Value items;
+        internal.generate_schema(items, alloc);
+        output.AddMember(rapidjson::StringRef("items"), items, alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+};
+
+template <class ArrayType>
+const SizeType NumericArrayHandler<ArrayType>::max_reserved;
+
 template <class T>
-class Handler<std::vector<T>> : public ArrayHandler<std::vector<T>>
+class Handler<std::vector<T>>
+    : public std::conditional<nonpublic::is_numeric_element<T>::value,
+                              NumericArrayHandler<std::vector<T>>,
+                              ArrayHandler<std::vector<T>>>::type
 {
 public:
-    explicit Handler(std::vector<T>* value) : ArrayHandler<std::vector<T>>(value) {}
+    explicit Handler(std::vector<T>* value)
+        : std::conditional<nonpublic::is_numeric_element<T>::value,
+                           NumericArrayHandler<std::vector<T>>,
+                           ArrayHandler<std::vector<T>>>::type(value)
+    {
+    }
 
     std::string type_name() const override
     {
@@ -165,10 +439,18 @@ public:
 };
 
 template <class T>
-class Handler<std::deque<T>> : public ArrayHandler<std::deque<T>>
+class Handler<std::deque<T>>
+    : public std::conditional<nonpublic::is_numeric_element<T>::value,
+                              NumericArrayHandler<std::deque<T>>,
+                              ArrayHandler<std::deque<T>>>::type
 {
 public:
-    explicit Handler(std::deque<T>* value) : ArrayHandler<std::deque<T>>(value) {}
+    explicit Handler(std::deque<T>* value)
+        : std::conditional<nonpublic::is_numeric_element<T>::value,
+                           NumericArrayHandler<std::deque<T>>,
+                           ArrayHandler<std::deque<T>>>::type(value)
+    {
+    }
 
     std::string type_name() const override
     {
@@ -271,6 +553,16 @@ public:
         return precheck("string") && postcheck(internal.String(str, length, copy));
     }
 
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && postcheck(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && postcheck(internal.RawNumber(str, length, copy));
+    }
+
     bool Key(const char* str, SizeType length, bool copy) override
     {
         return precheck("object") && postcheck(internal.Key(str, length, copy));
@@ -318,15 +610,7 @@ public:
 
     bool write(IHandler* output) const override
     {
-        if (!output->StartArray())
-            return false;
-        for (auto&& e : *m_value)
-        {
-            Handler<T> h(&e);
-            if (!h.write(output))
-                return false;
-        }
-        return output->EndArray(static_cast<staticjson::SizeType>(m_value->size()));
+        return nonpublic::write_elements(output, m_value->data(), static_cast<SizeType>(N));
     }
 
     void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
@@ -340,12 +624,52 @@ public:
         output.AddMember(rapidjson::StringRef("maxItems"), static_cast<uint64_t>(N), alloc);
     }
 
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+
     std::string type_name() const override
     {
         return "std::array<" + internal.type_name() + ", " + std::to_string(N) + ">";
     }
 };
 
+// Allocates the objects smart pointers are parsed into. Specialize it to draw the pointees of a type
+// from a pool or a custom allocator; `create` must return a pointer the deleter of the
+// `std::unique_ptr` accepts.
+template <class T>
+struct PointeeAllocator
+{
+    template <class... Args>
+    static std::shared_ptr<T> make_shared(Args&&... args)
+    {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    static T* create(Args&&... args)
+    {
+        return new T(std::forward<Args>(args)...);
+    }
+};
+
+namespace nonpublic
+{
+    template <class T, class... Args>
+    void emplace_pointee(std::shared_ptr<T>* pointer, Args&&... args)
+    {
+        *pointer = PointeeAllocator<T>::make_shared(std::forward<Args>(args)...);
+    }
+
+    template <class T, class Deleter, class... Args>
+    void emplace_pointee(std::unique_ptr<T, Deleter>* pointer, Args&&... args)
+    {
+        pointer->reset(PointeeAllocator<T>::create(std::forward<Args>(args)...));
+    }
+}
+
 template <class PointerType>
 class PointerHandler : public BaseHandler
 {
@@ -353,33 +677,82 @@ public:
     typedef typename std::pointer_traits<PointerType>::element_type ElementType;
 
 protected:
-    mutable PointerType* m_value;
-    mutable std::unique_ptr<Handler<ElementType>> internal_handler;
+    // Movable pointees are parsed into a staging object which, like its handler, lives as long as
+    // this handler, and are moved into one fresh allocation once complete. In sequences of
+    // pointers, where this handler is reset for every element, neither is built again. Other
+    // pointees are allocated up front and parsed in place.
+    typedef std::integral_constant<bool,
+                                   std::is_move_constructible<ElementType>::value
+                                       && std::is_move_assignable<ElementType>::value>
+        staged;
+
+    PointerType* m_value;
+    std::unique_ptr<ElementType> staging;
+    std::unique_ptr<Handler<ElementType>> internal_handler;
     int depth = 0;
 
+    // Whether the staging object may hold part of a parsed value
+    bool dirty = false;
+
 protected:
     explicit PointerHandler(PointerType* value) : m_value(value) {}
 
-    void initialize()
+    void initialize(std::true_type)
     {
         if (!internal_handler)
         {
-            m_value->reset(new ElementType());
+            staging.reset(new ElementType());
+            internal_handler.reset(new Handler<ElementType>(staging.get()));
+        }
+        dirty = true;
+    }
+
+    void initialize(std::false_type)
+    {
+        if (!internal_handler)
+        {
+            nonpublic::emplace_pointee(m_value);
             internal_handler.reset(new Handler<ElementType>(m_value->get()));
         }
     }
 
+    void initialize() { initialize(staged()); }
+
+    void clean(std::true_type)
+    {
+        if (dirty)
+        {
+            *staging = ElementType();
+            internal_handler->prepare_for_reuse();
+            dirty = false;
+        }
+    }
+
+    void clean(std::false_type) { internal_handler.reset(); }
+
+    void commit(std::true_type)
+    {
+        nonpublic::emplace_pointee(m_value, std::move(*staging));
+        clean(staged());
+    }
+
+    void commit(std::false_type) {}
+
     void reset() override
     {
         depth = 0;
-        internal_handler.reset();
+        clean(staged());
         m_value->reset();
     }
 
     bool postcheck(bool success)
     {
         if (success)
+        {
             this->parsed = internal_handler->is_parsed();
+            if (this->parsed)
+                commit(staged());
+        }
         return success;
     }
 
@@ -405,11 +778,8 @@ public:
         {
             return out->Null();
         }
-        if (!internal_handler)
-        {
-            internal_handler.reset(new Handler<ElementType>(m_value->get()));
-        }
-        return internal_handler->write(out);
+        Handler<ElementType> h(m_value->get());
+        return h.write(out);
     }
 
     void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
@@ -426,6 +796,18 @@ public:
         output.AddMember(rapidjson::StringRef("anyOf"), anyOf, alloc);
     }
 
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        if (internal_handler)
+        {
+            footprint->bytes += sizeof(*internal_handler);
+            internal_handler->accumulate_footprint(footprint);
+        }
+        if (staging)
+            footprint->bytes += sizeof(ElementType);
+    }
+
     bool Bool(bool b) override
     {
         initialize();
@@ -468,6 +850,18 @@ public:
         return postcheck(internal_handler->String(str, len, copy));
     }
 
+    bool Binary(const std::uint8_t* data, SizeType len) override
+    {
+        initialize();
+        return postcheck(internal_handler->Binary(data, len));
+    }
+
+    bool RawNumber(const char* str, SizeType len, bool copy) override
+    {
+        initialize();
+        return postcheck(internal_handler->RawNumber(str, len, copy));
+    }
+
     bool Key(const char* str, SizeType len, bool copy) override
     {
         initialize();
@@ -587,6 +981,9 @@ protected:
         {
             if (internal_handler.is_parsed())
             {
+                if (!nonpublic::charge_allocation(
+                        sizeof(typename MapType::value_type) + current_key.size(), this->the_error))
+                    return false;
                 m_value->emplace(std::move(current_key), std::move(element));
                 element = ElementType();
                 internal_handler.prepare_for_reuse();
@@ -629,6 +1026,16 @@ public:
         return precheck("string") && postcheck(internal_handler.String(str, length, copy));
     }
 
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return precheck("binary") && postcheck(internal_handler.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return precheck("number") && postcheck(internal_handler.RawNumber(str, length, copy));
+    }
+
     bool Key(const char* str, SizeType length, bool copy) override
     {
         if (depth > 1)
@@ -677,7 +1084,7 @@ public:
 
     bool write(IHandler* out) const override
     {
-        if (!out->StartObject())
+        if (!out->StartSizedObject(static_cast<SizeType>(m_value->size())))
             return false;
         for (auto&& pair : *m_value)
         {
@@ -701,6 +1108,12 @@ public:
         output.AddMember(rapidjson::StringRef("properties"), empty_obj, alloc);
         output.AddMember(rapidjson::StringRef("additionalProperties"), internal_schema, alloc);
     }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal_handler.accumulate_footprint(footprint);
+    }
 };
 
 template <class T, class Hash, class Equal>
@@ -767,136 +1180,349 @@ public:
     }
 };
 
-template <std::size_t N>
-class TupleHander : public BaseHandler
+namespace nonpublic
 {
-protected:
-    std::array<std::unique_ptr<BaseHandler>, N> handlers;
+    // Stand-ins for the C++14 `std::index_sequence`. Sequences are built by doubling, so the
+    // depth of instantiation is logarithmic in their length.
+    template <std::size_t... Indices>
+    struct index_sequence
+    {
+    };
+
+    template <class First, class Second>
+    struct concat_index_sequence;
+
+    template <std::size_t... First, std::size_t... Second>
+    struct concat_index_sequence<index_sequence<First...>, index_sequence<Second...>>
+    {
+        typedef index_sequence<First..., (sizeof...(First) + Second)...> type;
+    };
+
+    template <std::size_t N>
+    struct make_index_sequence
+        : public concat_index_sequence<typename make_index_sequence<N / 2>::type,
+                                       typename make_index_sequence<N - N / 2>::type>
+    {
+    };
+
+    template <>
+    struct make_index_sequence<0>
+    {
+        typedef index_sequence<> type;
+    };
+
+    template <>
+    struct make_index_sequence<1>
+    {
+        typedef index_sequence<0> type;
+    };
+
+    inline std::string join_type_names(std::initializer_list<std::string> names)
+    {
+        std::string result;
+        for (const std::string& name : names)
+        {
+            if (!result.empty())
+                result += ", ";
+            result += name;
+        }
+        return result;
+    }
+
+    // Events forwarded to one element of a tuple. They are called on the element handler by its
+    // own type, so no virtual call is needed to reach it.
+    struct NullEvent
+    {
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Null();
+        }
+    };
+
+    struct BoolEvent
+    {
+        bool value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Bool(value);
+        }
+    };
+
+    struct IntEvent
+    {
+        int value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Int(value);
+        }
+    };
+
+    struct UintEvent
+    {
+        unsigned value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Uint(value);
+        }
+    };
+
+    struct Int64Event
+    {
+        std::int64_t value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Int64(value);
+        }
+    };
+
+    struct Uint64Event
+    {
+        std::uint64_t value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Uint64(value);
+        }
+    };
+
+    struct DoubleEvent
+    {
+        double value;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Double(value);
+        }
+    };
+
+    struct StringEvent
+    {
+        const char* str;
+        SizeType length;
+        bool copy;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.String(str, length, copy);
+        }
+    };
+
+    struct KeyEvent
+    {
+        const char* str;
+        SizeType length;
+        bool copy;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Key(str, length, copy);
+        }
+    };
+
+    struct RawNumberEvent
+    {
+        const char* str;
+        SizeType length;
+        bool copy;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.RawNumber(str, length, copy);
+        }
+    };
+
+    struct BinaryEvent
+    {
+        const std::uint8_t* data;
+        SizeType length;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.Binary(data, length);
+        }
+    };
+
+    struct StartArrayEvent
+    {
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.StartArray();
+        }
+    };
+
+    struct EndArrayEvent
+    {
+        SizeType length;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.EndArray(length);
+        }
+    };
+
+    struct StartObjectEvent
+    {
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.StartObject();
+        }
+    };
+
+    struct EndObjectEvent
+    {
+        SizeType length;
+
+        template <class H>
+        bool operator()(H& h) const
+        {
+            return h.EndObject(length);
+        }
+    };
+}
+
+// Parses a fixed-length array element by element into a tuple-like type. The element handlers
+// are held inline, so building one allocates nothing, and each event reaches the current one
+// through a comparison per element index, expanded at compile time. As with `std::array`, arrays
+// of any other length are rejected.
+template <class Tuple, class Indices, class... Ts>
+class InlineTupleHandler;
+
+template <class Tuple, std::size_t... Indices, class... Ts>
+class InlineTupleHandler<Tuple, nonpublic::index_sequence<Indices...>, Ts...>
+    : public BaseHandler
+{
+private:
+    static const std::size_t N = sizeof...(Ts);
+
+    std::tuple<Handler<Ts>...> elements;
     std::size_t index = 0;
     int depth = 0;
 
-    bool postcheck(bool success)
+    // Calls `event` on the handler of the current element and moves past it once it is parsed
+    template <class Event>
+    bool forward(const char* type, const Event& event)
     {
+        if (depth <= 0)
+        {
+            the_error.reset(new error::TypeMismatchError(type_name(), type));
+            return false;
+        }
+        if (index >= N)
+        {
+            the_error.reset(new error::ArrayLengthMismatchError());
+            return false;
+        }
+        bool success = true, done = false;
+        int expand[] = {0,
+                        (index == Indices ? (success = event(std::get<Indices>(elements)),
+                                             done = std::get<Indices>(elements).is_parsed(),
+                                             0)
+                                          : 0)...};
+        (void)expand;
         if (!success)
         {
             the_error.reset(new error::ArrayElementError(index));
             return false;
         }
-        if (handlers[index]->is_parsed())
-        {
+        if (done)
             ++index;
-        }
         return true;
     }
 
 protected:
+    std::string element_type_names() const
+    {
+        return nonpublic::join_type_names({std::get<Indices>(elements).type_name()...});
+    }
+
     void reset() override
     {
         index = 0;
         depth = 0;
-        for (auto&& h : handlers)
-            h->prepare_for_reuse();
+        int expand[] = {0, (std::get<Indices>(elements).prepare_for_reuse(), 0)...};
+        (void)expand;
     }
 
 public:
-    bool Null() override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Null());
-    }
+    explicit InlineTupleHandler(Tuple* t) : elements(&std::get<Indices>(*t)...) {}
 
-    bool Bool(bool b) override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Bool(b));
-    }
+    bool Null() override { return forward("null", nonpublic::NullEvent()); }
 
-    bool Int(int i) override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Int(i));
-    }
+    bool Bool(bool b) override { return forward("bool", nonpublic::BoolEvent{b}); }
 
-    bool Uint(unsigned i) override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Uint(i));
-    }
+    bool Int(int i) override { return forward("int", nonpublic::IntEvent{i}); }
 
-    bool Int64(std::int64_t i) override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Int64(i));
-    }
+    bool Uint(unsigned i) override { return forward("unsigned", nonpublic::UintEvent{i}); }
 
-    bool Uint64(std::uint64_t i) override
+    bool Int64(std::int64_t i) override { return forward("int64_t", nonpublic::Int64Event{i}); }
+
+    bool Uint64(std::uint64_t i) override { return forward("uint64_t", nonpublic::Uint64Event{i}); }
+
+    bool Double(double d) override { return forward("double", nonpublic::DoubleEvent{d}); }
+
+    bool String(const char* str, SizeType length, bool copy) override
     {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Uint64(i));
+        return forward("string", nonpublic::StringEvent{str, length, copy});
     }
 
-    bool Double(double d) override
+    bool Binary(const std::uint8_t* data, SizeType length) override
     {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Double(d));
+        return forward("binary", nonpublic::BinaryEvent{data, length});
     }
 
-    bool String(const char* str, SizeType length, bool copy) override
+    bool RawNumber(const char* str, SizeType length, bool copy) override
     {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->String(str, length, copy));
+        return forward("number", nonpublic::RawNumberEvent{str, length, copy});
     }
 
     bool Key(const char* str, SizeType length, bool copy) override
     {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->Key(str, length, copy));
+        return forward("object", nonpublic::KeyEvent{str, length, copy});
     }
 
     bool StartArray() override
     {
         if (++depth > 1)
-        {
-            if (index >= N)
-                return true;
-            return postcheck(handlers[index]->StartArray());
-        }
+            return forward("array", nonpublic::StartArrayEvent());
         return true;
     }
 
     bool EndArray(SizeType length) override
     {
         if (--depth > 0)
+            return forward("array", nonpublic::EndArrayEvent{length});
+        if (index != N)
         {
-            if (index >= N)
-                return true;
-            return postcheck(handlers[index]->EndArray(length));
+            the_error.reset(new error::ArrayLengthMismatchError());
+            return false;
         }
         this->parsed = true;
         return true;
     }
 
-    bool StartObject() override
-    {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->StartObject());
-    }
+    bool StartObject() override { return forward("object", nonpublic::StartObjectEvent()); }
 
     bool EndObject(SizeType length) override
     {
-        if (index >= N)
-            return true;
-        return postcheck(handlers[index]->EndObject(length));
+        return forward("object", nonpublic::EndObjectEvent{length});
     }
 
     bool reap_error(ErrorStack& errs) override
@@ -905,21 +1531,19 @@ public:
             return false;
 
         errs.push(this->the_error.release());
-        for (auto&& h : handlers)
-            h->reap_error(errs);
+        int expand[] = {0, (std::get<Indices>(elements).reap_error(errs), 0)...};
+        (void)expand;
         return true;
     }
 
     bool write(IHandler* out) const override
     {
-        if (!out->StartArray())
+        if (!out->StartSizedArray(N))
             return false;
-        for (auto&& h : handlers)
-        {
-            if (!h->write(out))
-                return false;
-        }
-        return out->EndArray(N);
+        bool success = true;
+        int expand[] = {0, (success = success && std::get<Indices>(elements).write(out), 0)...};
+        (void)expand;
+        return success && out->EndArray(N);
     }
 
     void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
@@ -927,65 +1551,65 @@ public:
         output.SetObject();
         output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("array"), alloc);
         Value items(rapidjson::kArrayType);
-        for (auto&& h : handlers)
-        {
-            Value item;
-            h->generate_schema(item, alloc);
-            items.PushBack(item, alloc);
-        }
+        Value item[N + 1];
+        int expand[] = {0,
+                        (std::get<Indices>(elements).generate_schema(item[Indices], alloc),
+                         items.PushBack(item[Indices], alloc),
+                         0)...};
+        (void)expand;
         output.AddMember(rapidjson::StringRef("items"), items, alloc);
     }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        int expand[] = {0, (std::get<Indices>(elements).accumulate_footprint(footprint), 0)...};
+        (void)expand;
+    }
 };
 
-namespace nonpublic
+template <class Tuple, std::size_t... Indices, class... Ts>
+const std::size_t InlineTupleHandler<Tuple, nonpublic::index_sequence<Indices...>, Ts...>::N;
+
+template <typename... Ts>
+class Handler<std::tuple<Ts...>>
+    : public InlineTupleHandler<std::tuple<Ts...>,
+                                typename nonpublic::make_index_sequence<sizeof...(Ts)>::type,
+                                Ts...>
 {
-    template <std::size_t index, std::size_t N, typename Tuple>
-    struct TupleIniter
+public:
+    explicit Handler(std::tuple<Ts...>* t)
+        : InlineTupleHandler<std::tuple<Ts...>,
+                             typename nonpublic::make_index_sequence<sizeof...(Ts)>::type,
+                             Ts...>(t)
     {
-        void operator()(std::unique_ptr<BaseHandler>* handlers, Tuple& t) const
-        {
-            handlers[index].reset(
-                new Handler<typename std::tuple_element<index, Tuple>::type>(&std::get<index>(t)));
-            TupleIniter<index + 1, N, Tuple>{}(handlers, t);
-        }
-    };
+    }
 
-    template <std::size_t N, typename Tuple>
-    struct TupleIniter<N, N, Tuple>
+    std::string type_name() const override
     {
-        void operator()(std::unique_ptr<BaseHandler>* handlers, Tuple& t) const
-        {
-            (void)handlers;
-            (void)t;
-        }
-    };
-}
+        return "std::tuple<" + this->element_type_names() + ">";
+    }
+};
 
-template <typename... Ts>
-class Handler<std::tuple<Ts...>> : public TupleHander<std::tuple_size<std::tuple<Ts...>>::value>
+template <class First, class Second>
+class Handler<std::pair<First, Second>>
+    : public InlineTupleHandler<std::pair<First, Second>,
+                                nonpublic::index_sequence<0, 1>,
+                                First,
+                                Second>
 {
-private:
-    static const std::size_t N = std::tuple_size<std::tuple<Ts...>>::value;
-
 public:
-    explicit Handler(std::tuple<Ts...>* t)
+    explicit Handler(std::pair<First, Second>* p)
+        : InlineTupleHandler<std::pair<First, Second>,
+                             nonpublic::index_sequence<0, 1>,
+                             First,
+                             Second>(p)
     {
-        nonpublic::TupleIniter<0, N, std::tuple<Ts...>> initer;
-        initer(this->handlers.data(), *t);
     }
 
     std::string type_name() const override
     {
-        std::string str = "std::tuple<";
-        for (auto&& h : this->handlers)
-        {
-            str += h->type_name();
-            str += ", ";
-        }
-        str.pop_back();
-        str.pop_back();
-        str += '>';
-        return str;
+        return "std::pair<" + this->element_type_names() + ">";
     }
 };
 }
@@ -0,0 +1,359 @@
+#pragma once
+
+#include <staticjson/primitive_types.hpp>
+#include <staticjson/stl_types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace staticjson
+{
+// How a member described by a table is stored. Numbers, strings, nested table-driven objects and
+// `std::vector`s of these are handled by one shared loop; anything else is `Custom` and goes
+// through its own `Handler<T>`.
+enum class TableKind : unsigned char
+{
+    Bool,
+    Int,
+    Unsigned,
+    Int64,
+    Uint64,
+    Float,
+    Double,
+    String,
+    Object,
+    Sequence,
+    Custom
+};
+
+struct TypeTable;
+struct TableSequence;
+
+struct TableType
+{
+    TableKind kind;
+
+    // Object: the table of the nested type
+    const TypeTable& (*table)();
+
+    // Sequence: the operations on the vector
+    const TableSequence* sequence;
+
+    // Custom: a `Handler<T>` of the value, built in `storage` when it fits in `size` bytes and on
+    // the heap otherwise, and the schema of `T`
+    BaseHandler* (*make_handler)(void* value, void* storage, std::size_t size);
+    void (*schema)(Value& output, MemoryPoolAllocator& alloc);
+};
+
+// The operations of a `std::vector` needed to parse and write it
+struct TableSequence
+{
+    std::size_t (*size)(const void* sequence);
+    void* (*at)(const void* sequence, std::size_t index);
+
+    // Default constructs one more element and returns it
+    void* (*append)(void* sequence);
+
+    std::size_t element_size;
+    TableType element;
+};
+
+struct TableField
+{
+    const char* name;
+    SizeType length;
+    std::size_t offset;
+    unsigned flags;
+    TableType type;
+};
+
+// Describes an object type as plain data: its members, where they live and how they are stored.
+// `flags` are the object flags of `ObjectHandler::set_flags`.
+struct TypeTable
+{
+    const TableField* fields;
+    std::size_t size;
+    unsigned flags;
+};
+
+// Parses and writes any object type described by a `TypeTable`. All table-driven types share
+// this one handler, so each adds a table to the binary instead of a family of handler classes.
+class TableHandler : public BaseHandler
+{
+private:
+    struct Frame
+    {
+        // Objects have a table, arrays a sequence
+        const TypeTable* table;
+        const TableSequence* sequence;
+        void* base;
+
+        // Objects: the member whose value comes next, or null when it is skipped
+        const TableField* field;
+
+        // Objects: the position of the first member in `seen`
+        std::size_t seen;
+    };
+
+    const TypeTable* m_table;
+    void* m_value;
+
+    std::vector<Frame> frames;
+    std::vector<unsigned char> seen;
+
+    // Nesting inside a skipped member, and inside the value a custom handler parses
+    std::size_t skip_depth = 0, custom_depth = 0;
+    BaseHandler* custom = nullptr;
+    alignas(std::max_align_t) unsigned char custom_storage[128];
+
+    // Errors of the handler that failed, when not in `the_error`, and how many frames enclose
+    // the error
+    ErrorStack leaf;
+    std::size_t error_frames = 0;
+
+private:
+    bool fail(ErrorBase* error, std::size_t enclosing);
+    bool fail_value(BaseHandler& h);
+    void push_object(const TypeTable& table, void* base);
+    bool begin_value(const char* type, const TableType** value_type, void** value);
+    void finish_value();
+    bool forward(bool success);
+    void destroy_custom();
+
+    template <class Event>
+    bool scalar(const char* type, Event event);
+
+    template <class T, class Event>
+    bool store(void* value, Event& event);
+
+    template <class Event>
+    bool deliver(const TableType& value_type, void* value, const char* type, Event& event);
+
+protected:
+    void reset() override;
+
+public:
+    explicit TableHandler(const TypeTable& table, void* value);
+
+    ~TableHandler();
+
+    std::string type_name() const override;
+
+    bool Null() override;
+    bool Bool(bool) override;
+    bool Int(int) override;
+    bool Uint(unsigned) override;
+    bool Int64(std::int64_t) override;
+    bool Uint64(std::uint64_t) override;
+    bool Double(double) override;
+    bool String(const char*, SizeType, bool) override;
+    bool RawNumber(const char*, SizeType, bool) override;
+    bool Binary(const std::uint8_t*, SizeType) override;
+    bool StartObject() override;
+    bool Key(const char*, SizeType, bool) override;
+    bool EndObject(SizeType) override;
+    bool StartArray() override;
+    bool EndArray(SizeType) override;
+    bool has_error() const override;
+    bool reap_error(ErrorStack& stk) override;
+
+    bool write(IHandler* output) const override;
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override;
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override;
+};
+
+namespace nonpublic
+{
+    template <class Class, class Member>
+    std::size_t member_offset(Member Class::*member)
+    {
+        // Never constructed; only the address of the member is taken
+        union Storage
+        {
+            char bytes[sizeof(Class)];
+            Class object;
+            Storage() {}
+            ~Storage() {}
+        } storage;
+        return static_cast<std::size_t>(reinterpret_cast<char*>(&(storage.object.*member))
+                                        - storage.bytes);
+    }
+
+    template <class T>
+    class has_table
+    {
+        template <class U>
+        static std::true_type test(decltype(&Handler<U>::table));
+        template <class U>
+        static std::false_type test(...);
+
+    public:
+        static const bool value = decltype(test<T>(nullptr))::value;
+    };
+
+    template <class T>
+    BaseHandler* make_table_handler(void* value, void* storage, std::size_t size)
+    {
+        if (sizeof(Handler<T>) <= size && alignof(Handler<T>) <= alignof(std::max_align_t))
+            return new (storage) Handler<T>(static_cast<T*>(value));
+        return new Handler<T>(static_cast<T*>(value));
+    }
+
+    // Destroys a handler made by `make_table_handler`
+    void destroy_table_handler(BaseHandler* h, const void* storage);
+
+    template <class T>
+    void table_schema(Value& output, MemoryPoolAllocator& alloc)
+    {
+        T value{};
+        Handler<T> h(&value);
+        h.generate_schema(output, alloc);
+    }
+
+    template <class T, class Enable = void>
+    struct TableTypeOf
+    {
+        static TableType get()
+        {
+            return {TableKind::Custom, nullptr, nullptr, &make_table_handler<T>, &table_schema<T>};
+        }
+    };
+
+    template <TableKind kind>
+    struct ScalarTableType
+    {
+        static TableType get() { return {kind, nullptr, nullptr, nullptr, nullptr}; }
+    };
+
+    // Other integer types are `Custom`, so that every integer member is accessed through its own
+    // type
+    template <class T>
+    struct is_table_integer
+        : public std::integral_constant<bool,
+                                        std::is_same<T, int>::value
+                                            || std::is_same<T, unsigned>::value
+                                            || std::is_same<T, std::int64_t>::value
+                                            || std::is_same<T, std::uint64_t>::value>
+    {
+    };
+
+    template <class T>
+    struct TableTypeOf<T, typename std::enable_if<is_table_integer<T>::value>::type>
+        : public ScalarTableType<std::is_same<T, int>::value
+                                     ? TableKind::Int
+                                     : std::is_same<T, unsigned>::value
+                                         ? TableKind::Unsigned
+                                         : std::is_same<T, std::int64_t>::value
+                                             ? TableKind::Int64
+                                             : TableKind::Uint64>
+    {
+    };
+
+    template <>
+    struct TableTypeOf<bool> : public ScalarTableType<TableKind::Bool>
+    {
+    };
+
+    template <>
+    struct TableTypeOf<float> : public ScalarTableType<TableKind::Float>
+    {
+    };
+
+    template <>
+    struct TableTypeOf<double> : public ScalarTableType<TableKind::Double>
+    {
+    };
+
+    template <>
+    struct TableTypeOf<std::string> : public ScalarTableType<TableKind::String>
+    {
+    };
+
+    template <class T>
+    struct TableTypeOf<T, typename std::enable_if<has_table<T>::value>::type>
+    {
+        static TableType get()
+        {
+            return {TableKind::Object, &Handler<T>::table, nullptr, nullptr, nullptr};
+        }
+    };
+
+    template <class T>
+    struct SequenceTable
+    {
+        static std::size_t size(const void* sequence)
+        {
+            return static_cast<const std::vector<T>*>(sequence)->size();
+        }
+
+        static void* at(const void* sequence, std::size_t index)
+        {
+            return const_cast<T*>(static_cast<const std::vector<T>*>(sequence)->data() + index);
+        }
+
+        static void* append(void* sequence)
+        {
+            auto v = static_cast<std::vector<T>*>(sequence);
+            v->emplace_back();
+            return &v->back();
+        }
+
+        static const TableSequence* get()
+        {
+            static const TableSequence sequence
+                = {&size, &at, &append, sizeof(T), TableTypeOf<T>::get()};
+            return &sequence;
+        }
+    };
+
+    // `std::vector<bool>` has no contiguous elements to point to
+    template <class T>
+    struct TableTypeOf<std::vector<T>, typename std::enable_if<!std::is_same<T, bool>::value>::type>
+    {
+        static TableType get()
+        {
+            return {TableKind::Sequence, nullptr, SequenceTable<T>::get(), nullptr, nullptr};
+        }
+    };
+}
+
+// Describes the member `member` of a table-driven type, written under `name`
+template <class Class, class Member>
+TableField table_field(const char* name, Member Class::*member, unsigned flags = Flags::Default)
+{
+    return {name,
+            static_cast<SizeType>(std::strlen(name)),
+            nonpublic::member_offset(member),
+            flags,
+            nonpublic::TableTypeOf<Member>::get()};
+}
+}
+
+// Makes `type` table-driven: `Handler<type>` becomes a `TableHandler` over the fields listed, each
+// a `staticjson::table_field`. `flags` are the object flags. It must not be used inside a
+// namespace.
+#define STATICJSON_DECLARE_TABLE(type, flags, ...)                                                 \
+    namespace staticjson                                                                           \
+    {                                                                                              \
+        template <>                                                                                \
+        class Handler<type> : public TableHandler                                                  \
+        {                                                                                          \
+        public:                                                                                    \
+            explicit Handler(type* value) : TableHandler(table(), value) {}                        \
+                                                                                                   \
+            static const TypeTable& table()                                                        \
+            {                                                                                      \
+                static const TableField fields[] = {__VA_ARGS__};                                  \
+                static const TypeTable t = {fields, sizeof(fields) / sizeof(fields[0]), flags};    \
+                return t;                                                                          \
+            }                                                                                      \
+        };                                                                                         \
+    }
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <staticjson/stl_types.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace staticjson
+{
+// A dense array of numbers with `Rank` dimensions, stored contiguously in row-major order. In JSON
+// it is `Rank` levels of nested arrays with the numbers at the innermost level.
+//
+// Parsing takes each extent from the first array completed at that level and requires every other
+// array at the same level to match. Extents fixed with `fix_extent` are enforced from the start.
+template <class T, std::size_t Rank>
+class Tensor
+{
+    static_assert(Rank > 0, "A tensor needs at least one dimension");
+    static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are allowed");
+
+    friend class Handler<Tensor<T, Rank>>;
+
+public:
+    typedef T value_type;
+    typedef std::array<std::size_t, Rank> shape_type;
+
+    // The extent of a dimension that is not fixed
+    static const std::size_t any = static_cast<std::size_t>(-1);
+
+private:
+    std::vector<T> m_values;
+    shape_type m_shape;
+    shape_type m_fixed;
+
+public:
+    Tensor()
+    {
+        m_shape.fill(0);
+        m_fixed.fill(any);
+    }
+
+    explicit Tensor(const shape_type& shape) : Tensor() { reshape(shape); }
+
+    static std::size_t element_count(const shape_type& shape)
+    {
+        std::size_t count = 1;
+        for (std::size_t extent : shape)
+            count *= extent;
+        return count;
+    }
+
+    // Keeps the values in their flat order; added values are zero
+    void reshape(const shape_type& shape)
+    {
+        m_shape = shape;
+        m_values.resize(element_count(shape));
+    }
+
+    const shape_type& shape() const { return m_shape; }
+
+    std::size_t extent(std::size_t axis) const { return m_shape[axis]; }
+
+    // Requires `axis` to have `extent` elements in every parsed document, or lifts the
+    // requirement when `extent` is `any`
+    void fix_extent(std::size_t axis, std::size_t extent) { m_fixed[axis] = extent; }
+
+    std::size_t fixed_extent(std::size_t axis) const { return m_fixed[axis]; }
+
+    // A failed parse leaves the shape all zeros
+    std::size_t size() const { return element_count(m_shape); }
+
+    bool empty() const { return size() == 0; }
+
+    T* data() { return m_values.data(); }
+
+    const T* data() const { return m_values.data(); }
+
+    template <class... Indices>
+    T& operator()(Indices... indices)
+    {
+        return m_values[offset(indices...)];
+    }
+
+    template <class... Indices>
+    const T& operator()(Indices... indices) const
+    {
+        return m_values[offset(indices...)];
+    }
+
+    bool operator==(const Tensor& that) const
+    {
+        return m_shape == that.m_shape && m_values == that.m_values;
+    }
+
+    bool operator!=(const Tensor& that) const { return !(*this == that); }
+
+private:
+    template <class... Indices>
+    std::size_t offset(Indices... indices) const
+    {
+        static_assert(sizeof...(Indices) == Rank, "One index per dimension is required");
+        const std::size_t index[] = {static_cast<std::size_t>(indices)...};
+        std::size_t result = 0;
+        for (std::size_t axis = 0; axis < Rank; ++axis)
+            result = result * m_shape[axis] + index[axis];
+        return result;
+    }
+};
+
+template <class T, std::size_t Rank>
+const std::size_t Tensor<T, Rank>::any;
+
+// Parses straight into the flat buffer of the tensor; a parse replaces its previous contents.
+// Errors name the position of the offending array or number with one `ArrayElementError` per
+// enclosing level.
+template <class T, std::size_t Rank>
+class Handler<Tensor<T, Rank>> : public BaseHandler
+{
+private:
+    T element;
+    Handler<T> internal;
+    Tensor<T, Rank>* m_value;
+
+    // Children started so far by the open array of each level, and the extents known so far. The
+    // shape of the tensor is only updated once the whole tensor is parsed.
+    std::array<std::size_t, Rank> counts, extents;
+    std::array<bool, Rank> known;
+    std::size_t depth = 0;
+
+    // Levels of `ArrayElementError` leading to the error, and whether the element handler has it
+    std::size_t error_depth = 0;
+    bool element_failed = false;
+
+private:
+    void begin()
+    {
+        m_value->m_values.clear();
+        m_value->m_shape.fill(0);
+        for (std::size_t axis = 0; axis < Rank; ++axis)
+        {
+            known[axis] = m_value->m_fixed[axis] != Tensor<T, Rank>::any;
+            extents[axis] = known[axis] ? m_value->m_fixed[axis] : 0;
+        }
+    }
+
+    bool fail(ErrorBase* error, std::size_t levels)
+    {
+        the_error.reset(error);
+        error_depth = levels;
+        return false;
+    }
+
+    // Counts a new child of the innermost open array
+    bool enter_child()
+    {
+        std::size_t axis = depth - 1;
+        ++counts[axis];
+        if (known[axis] && counts[axis] > extents[axis])
+            return fail(new error::ArrayLengthMismatchError(), axis);
+        return true;
+    }
+
+    // Whether a value other than an array can go to the element handler at this point
+    bool at_element(const char* type)
+    {
+        if (depth == 0)
+            return fail(new error::TypeMismatchError(type_name(), type), 0);
+        if (!enter_child())
+            return false;
+        if (depth < Rank)
+            return fail(new error::TypeMismatchError("array", type), depth);
+        return true;
+    }
+
+    bool store(bool success)
+    {
+        if (!success)
+        {
+            element_failed = true;
+            error_depth = Rank;
+            return false;
+        }
+        if (!nonpublic::charge_allocation(sizeof(T), the_error))
+        {
+            error_depth = Rank;
+            return false;
+        }
+        m_value->m_values.push_back(element);
+        return true;
+    }
+
+    bool write_level(IHandler* output, std::size_t axis, T* data, std::size_t stride) const
+    {
+        SizeType extent = static_cast<SizeType>(m_value->m_shape[axis]);
+        if (axis + 1 == Rank)
+            return nonpublic::write_elements(output, data, extent);
+        stride = extent == 0 ? 0 : stride / extent;
+        if (!output->StartSizedArray(extent))
+            return false;
+        for (SizeType i = 0; i < extent; ++i)
+        {
+            if (!write_level(output, axis + 1, data + i * stride, stride))
+                return false;
+        }
+        return output->EndArray(extent);
+    }
+
+protected:
+    void reset() override
+    {
+        internal.prepare_for_reuse();
+        depth = 0;
+        error_depth = 0;
+        element_failed = false;
+    }
+
+public:
+    explicit Handler(Tensor<T, Rank>* value) : element(), internal(&element), m_value(value)
+    {
+        counts.fill(0);
+        extents.fill(0);
+        known.fill(false);
+    }
+
+    bool Null() override { return at_element("null") && store(internal.Null()); }
+
+    bool Bool(bool b) override { return at_element("bool") && store(internal.Bool(b)); }
+
+    bool Int(int i) override { return at_element("int") && store(internal.Int(i)); }
+
+    bool Uint(unsigned i) override { return at_element("unsigned") && store(internal.Uint(i)); }
+
+    bool Int64(std::int64_t i) override
+    {
+        return at_element("int64_t") && store(internal.Int64(i));
+    }
+
+    bool Uint64(std::uint64_t i) override
+    {
+        return at_element("uint64_t") && store(internal.Uint64(i));
+    }
+
+    bool Double(double d) override { return at_element("double") && store(internal.Double(d)); }
+
+    bool String(const char* str, SizeType length, bool copy) override
+    {
+        return at_element("string") && store(internal.String(str, length, copy));
+    }
+
+    bool Binary(const std::uint8_t* data, SizeType length) override
+    {
+        return at_element("binary") && store(internal.Binary(data, length));
+    }
+
+    bool RawNumber(const char* str, SizeType length, bool copy) override
+    {
+        return at_element("number") && store(internal.RawNumber(str, length, copy));
+    }
+
+    bool StartObject() override
+    {
+        return at_element("object") && store(internal.StartObject());
+    }
+
+    bool Key(const char* str, SizeType length, bool copy) override
+    {
+        return at_element("object") && store(internal.Key(str, length, copy));
+    }
+
+    bool EndObject(SizeType length) override
+    {
+        return at_element("object") && store(internal.EndObject(length));
+    }
+
+    bool StartArray() override
+    {
+        if (depth == Rank)
+            return at_element("array") && store(internal.StartArray());
+        if (depth == 0)
+            begin();
+        else if (!enter_child())
+            return false;
+        counts[depth] = 0;
+        ++depth;
+        return true;
+    }
+
+    bool EndArray(SizeType) override
+    {
+        std::size_t axis = depth - 1;
+        if (!known[axis])
+        {
+            extents[axis] = counts[axis];
+            known[axis] = true;
+        }
+        else if (counts[axis] != extents[axis])
+        {
+            return fail(new error::ArrayLengthMismatchError(), axis);
+        }
+        --depth;
+        if (depth == 0)
+        {
+            m_value->m_shape = extents;
+            this->parsed = true;
+        }
+        return true;
+    }
+
+    bool reap_error(ErrorStack& stk) override
+    {
+        if (!the_error && !element_failed)
+            return false;
+        for (std::size_t axis = 0; axis < error_depth; ++axis)
+            stk.push(new error::ArrayElementError(counts[axis] - 1));
+        if (element_failed)
+            internal.reap_error(stk);
+        else
+            stk.push(the_error.release());
+        return true;
+    }
+
+    bool write(IHandler* output) const override
+    {
+        return write_level(output, 0, m_value->data(), m_value->size());
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        internal.generate_schema(output, alloc);
+        for (std::size_t axis = Rank; axis-- > 0;)
+        {
+            Value array(rapidjson::kObjectType);
+            array.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("array"), alloc);
+            array.AddMember(rapidjson::StringRef("items"), output, alloc);
+            std::size_t fixed = m_value->m_fixed[axis];
+            if (fixed != Tensor<T, Rank>::any)
+            {
+                array.AddMember(
+                    rapidjson::StringRef("minItems"), static_cast<uint64_t>(fixed), alloc);
+                array.AddMember(
+                    rapidjson::StringRef("maxItems"), static_cast<uint64_t>(fixed), alloc);
+            }
+            output = array;
+        }
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        internal.accumulate_footprint(footprint);
+    }
+
+    std::string type_name() const override
+    {
+        return "staticjson::Tensor<" + internal.type_name() + ", " + std::to_string(Rank) + ">";
+    }
+};
+}
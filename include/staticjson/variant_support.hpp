@@ -0,0 +1,154 @@
+#pragma once
+
+#include "stl_types.hpp"
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace staticjson
+{
+// Names the discriminator key of a variant and the tag of each alternative, in the order of the
+// alternatives. Specialize it with `STATICJSON_DECLARE_VARIANT`.
+template <class Variant>
+struct VariantTags;
+
+// A variant is written as an object of its current alternative with one more member, the
+// discriminator, naming that alternative: {"type": "circle", "radius": 1}. Writing always puts the
+// discriminator first, which lets parsing send the rest of the object straight to the handler of
+// the alternative. Every alternative must be an object type.
+template <class... Ts>
+class Handler<std::variant<Ts...>> : public DiscriminatedHandler
+{
+private:
+    typedef std::variant<Ts...> VariantType;
+    typedef VariantTags<VariantType> Tags;
+    static const std::size_t N = sizeof...(Ts);
+
+    VariantType* m_value;
+
+    // Built on first use and kept, bound to the storage of the variant, which an alternative
+    // occupies at the same address every time it is emplaced
+    std::tuple<std::optional<Handler<Ts>>...> alternatives;
+
+private:
+    template <std::size_t I>
+    BaseHandler* emplace_alternative()
+    {
+        m_value->template emplace<I>();
+        auto& h = std::get<I>(alternatives);
+        if (h)
+            h->prepare_for_reuse();
+        else
+            h.emplace(&std::get<I>(*m_value));
+        return &*h;
+    }
+
+    template <std::size_t... Is>
+    BaseHandler* emplace_alternative(std::size_t index, std::index_sequence<Is...>)
+    {
+        typedef BaseHandler* (Handler::*Emplacer)();
+        static const Emplacer emplacers[] = {&Handler::template emplace_alternative<Is>...};
+        return (this->*emplacers[index])();
+    }
+
+    template <std::size_t I>
+    void add_alternative_schema(Value& any_of, MemoryPoolAllocator& alloc) const
+    {
+        typename std::variant_alternative<I, VariantType>::type value{};
+        Handler<typename std::variant_alternative<I, VariantType>::type> h(&value);
+        Value schema;
+        h.generate_schema(schema, alloc);
+        nonpublic::add_discriminator_schema(schema, Tags::key(), Tags::name(I), alloc);
+        any_of.PushBack(schema, alloc);
+    }
+
+    template <std::size_t... Is>
+    void add_alternative_schemas(Value& any_of,
+                                 MemoryPoolAllocator& alloc,
+                                 std::index_sequence<Is...>) const
+    {
+        (add_alternative_schema<Is>(any_of, alloc), ...);
+    }
+
+protected:
+    BaseHandler* select(const char* name, SizeType length) override
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            const char* candidate = Tags::name(i);
+            if (std::strlen(candidate) == length && std::memcmp(candidate, name, length) == 0)
+                return emplace_alternative(i, std::index_sequence_for<Ts...>());
+        }
+        return nullptr;
+    }
+
+public:
+    explicit Handler(VariantType* value) : DiscriminatedHandler(Tags::key()), m_value(value) {}
+
+    bool write(IHandler* output) const override
+    {
+        if (m_value->valueless_by_exception())
+            return output->Null();
+        nonpublic::TaggedObjectWriter tagged_output(output, Tags::key(), Tags::name(m_value->index()));
+        return std::visit(
+            [&](auto& alternative) {
+                Handler<typename std::decay<decltype(alternative)>::type> h(&alternative);
+                return h.write(&tagged_output);
+            },
+            *m_value);
+    }
+
+    void generate_schema(Value& output, MemoryPoolAllocator& alloc) const override
+    {
+        output.SetObject();
+        Value any_of(rapidjson::kArrayType);
+        add_alternative_schemas(any_of, alloc, std::index_sequence_for<Ts...>());
+        output.AddMember(rapidjson::StringRef("anyOf"), any_of, alloc);
+    }
+
+    void accumulate_footprint(HandlerFootprint* footprint) const override
+    {
+        ++footprint->handlers;
+        std::apply(
+            [&](const auto&... h) {
+                ((h ? h->accumulate_footprint(footprint) : void()), ...);
+            },
+            alternatives);
+    }
+
+    std::string type_name() const override
+    {
+        std::string names;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            if (i > 0)
+                names += ", ";
+            names += Tags::name(i);
+        }
+        return "std::variant<" + names + ">";
+    }
+};
+}
+
+// Declares the discriminator key of `type`, a `std::variant`, and the tags of its alternatives in
+// order. Like `STATICJSON_DECLARE_ENUM`, it must not be used inside a namespace, and a variant
+// whose name contains commas needs a typedef.
+#define STATICJSON_DECLARE_VARIANT(type, key_name, ...)                                            \
+    namespace staticjson                                                                           \
+    {                                                                                              \
+        template <>                                                                                \
+        struct VariantTags<type>                                                                   \
+        {                                                                                          \
+            static const char* key() { return key_name; }                                          \
+            static const char* name(std::size_t index)                                             \
+            {                                                                                      \
+                static const char* const names[] = {__VA_ARGS__};                                  \
+                return names[index];                                                               \
+            }                                                                                      \
+        };                                                                                         \
+    }
@@ -5,13 +5,32 @@
 #include <rapidjson/error/error.h>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/filewritestream.h>
+#include <rapidjson/internal/dtoa.h>
+#include <rapidjson/internal/itoa.h>
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/reader.h>
 #include <rapidjson/writer.h>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <limits>
+#include <random>
 
 namespace staticjson
 {
@@ -238,6 +257,24 @@ std::string error::ArrayLengthMismatchError::description() const
     return "The JSON array has different length than the required type";
 }
 
+std::string error::ParseCancelledError::description() const
+{
+    return stringprintf("Parsing was cancelled at offset %lld", static_cast<long long>(m_offset));
+}
+
+std::string error::DeadlineExceededError::description() const
+{
+    return stringprintf("Parsing missed its deadline at offset %lld",
+                        static_cast<long long>(m_offset));
+}
+
+std::string error::LimitExceededError::description() const
+{
+    return stringprintf("Input exceeds the limit %s = %llu",
+                        m_limit_name.c_str(),
+                        static_cast<unsigned long long>(m_limit));
+}
+
 std::string error::InvalidEnumError::description() const
 {
     return quote(m_name) + " is an invalid enum name";
@@ -286,427 +323,4363 @@ bool BaseHandler::set_type_mismatch(const char* actual_type)
     return false;
 }
 
-bool IHandler::RawNumber(const char*, SizeType, bool)
+namespace nonpublic
 {
-    fprintf(stderr, "%s", "Calling non-overridden IHandler::RawNumber() is a programming bug!\n");
-    std::terminate();
-}
+    // Eisel-Lemire conversion of decimal text to the nearest binary floating point number, after
+    // Daniel Lemire, "Number Parsing at a Gigabyte per Second" (2021) and its fast_float library.
+    // Inputs it cannot decide fall back to strtod, which is correctly rounded but slow.
 
-ObjectHandler::ObjectHandler() {}
+    // 128-bit approximations of 5^q for q in [-342, 308], with the most significant bit set
+    static const std::uint64_t powers_of_five[][2] = {
+        {0xeef453d6923bd65a, 0x113faa2906a13b3f}, {0x9558b4661b6565f8, 0x4ac7ca59a424c507},
+        {0xbaaee17fa23ebf76, 0x5d79bcf00d2df649}, {0xe95a99df8ace6f53, 0xf4d82c2c107973dc},
+        {0x91d8a02bb6c10594, 0x79071b9b8a4be869}, {0xb64ec836a47146f9, 0x9748e2826cdee284},
+        {0xe3e27a444d8d98b7, 0xfd1b1b2308169b25}, {0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7},
+        {0xb208ef855c969f4f, 0xbdbd2d335e51a935}, {0xde8b2b66b3bc4723, 0xad2c788035e61382},
+        {0x8b16fb203055ac76, 0x4c3bcb5021afcc31}, {0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d},
+        {0xd953e8624b85dd78, 0xd71d6dad34a2af0d}, {0x87d4713d6f33aa6b, 0x8672648c40e5ad68},
+        {0xa9c98d8ccb009506, 0x680efdaf511f18c2}, {0xd43bf0effdc0ba48, 0x0212bd1b2566def2},
+        {0x84a57695fe98746d, 0x014bb630f7604b57}, {0xa5ced43b7e3e9188, 0x419ea3bd35385e2d},
+        {0xcf42894a5dce35ea, 0x52064cac828675b9}, {0x818995ce7aa0e1b2, 0x7343efebd1940993},
+        {0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8}, {0xca66fa129f9b60a6, 0xd41a26e077774ef6},
+        {0xfd00b897478238d0, 0x8920b098955522b4}, {0x9e20735e8cb16382, 0x55b46e5f5d5535b0},
+        {0xc5a890362fddbc62, 0xeb2189f734aa831d}, {0xf712b443bbd52b7b, 0xa5e9ec7501d523e4},
+        {0x9a6bb0aa55653b2d, 0x47b233c92125366e}, {0xc1069cd4eabe89f8, 0x999ec0bb696e840a},
+        {0xf148440a256e2c76, 0xc00670ea43ca250d}, {0x96cd2a865764dbca, 0x380406926a5e5728},
+        {0xbc807527ed3e12bc, 0xc605083704f5ecf2}, {0xeba09271e88d976b, 0xf7864a44c633682e},
+        {0x93445b8731587ea3, 0x7ab3ee6afbe0211d}, {0xb8157268fdae9e4c, 0x5960ea05bad82964},
+        {0xe61acf033d1a45df, 0x6fb92487298e33bd}, {0x8fd0c16206306bab, 0xa5d3b6d479f8e056},
+        {0xb3c4f1ba87bc8696, 0x8f48a4899877186c}, {0xe0b62e2929aba83c, 0x331acdabfe94de87},
+        {0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14}, {0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9},
+        {0xdb71e91432b1a24a, 0xc9e82cd9f69d6150}, {0x892731ac9faf056e, 0xbe311c083a225cd2},
+        {0xab70fe17c79ac6ca, 0x6dbd630a48aaf406}, {0xd64d3d9db981787d, 0x092cbbccdad5b108},
+        {0x85f0468293f0eb4e, 0x25bbf56008c58ea5}, {0xa76c582338ed2621, 0xaf2af2b80af6f24e},
+        {0xd1476e2c07286faa, 0x1af5af660db4aee1}, {0x82cca4db847945ca, 0x50d98d9fc890ed4d},
+        {0xa37fce126597973c, 0xe50ff107bab528a0}, {0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8},
+        {0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a}, {0x9faacf3df73609b1, 0x77b191618c54e9ac},
+        {0xc795830d75038c1d, 0xd59df5b9ef6a2417}, {0xf97ae3d0d2446f25, 0x4b0573286b44ad1d},
+        {0x9becce62836ac577, 0x4ee367f9430aec32}, {0xc2e801fb244576d5, 0x229c41f793cda73f},
+        {0xf3a20279ed56d48a, 0x6b43527578c1110f}, {0x9845418c345644d6, 0x830a13896b78aaa9},
+        {0xbe5691ef416bd60c, 0x23cc986bc656d553}, {0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8},
+        {0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9}, {0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53},
+        {0xe858ad248f5c22c9, 0xd1b3400f8f9cff68}, {0x91376c36d99995be, 0x23100809b9c21fa1},
+        {0xb58547448ffffb2d, 0xabd40a0c2832a78a}, {0xe2e69915b3fff9f9, 0x16c90c8f323f516c},
+        {0x8dd01fad907ffc3b, 0xae3da7d97f6792e3}, {0xb1442798f49ffb4a, 0x99cd11cfdf41779c},
+        {0xdd95317f31c7fa1d, 0x40405643d711d583}, {0x8a7d3eef7f1cfc52, 0x482835ea666b2572},
+        {0xad1c8eab5ee43b66, 0xda3243650005eecf}, {0xd863b256369d4a40, 0x90bed43e40076a82},
+        {0x873e4f75e2224e68, 0x5a7744a6e804a291}, {0xa90de3535aaae202, 0x711515d0a205cb36},
+        {0xd3515c2831559a83, 0x0d5a5b44ca873e03}, {0x8412d9991ed58091, 0xe858790afe9486c2},
+        {0xa5178fff668ae0b6, 0x626e974dbe39a872}, {0xce5d73ff402d98e3, 0xfb0a3d212dc8128f},
+        {0x80fa687f881c7f8e, 0x7ce66634bc9d0b99}, {0xa139029f6a239f72, 0x1c1fffc1ebc44e80},
+        {0xc987434744ac874e, 0xa327ffb266b56220}, {0xfbe9141915d7a922, 0x4bf1ff9f0062baa8},
+        {0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9}, {0xc4ce17b399107c22, 0xcb550fb4384d21d3},
+        {0xf6019da07f549b2b, 0x7e2a53a146606a48}, {0x99c102844f94e0fb, 0x2eda7444cbfc426d},
+        {0xc0314325637a1939, 0xfa911155fefb5308}, {0xf03d93eebc589f88, 0x793555ab7eba27ca},
+        {0x96267c7535b763b5, 0x4bc1558b2f3458de}, {0xbbb01b9283253ca2, 0x9eb1aaedfb016f16},
+        {0xea9c227723ee8bcb, 0x465e15a979c1cadc}, {0x92a1958a7675175f, 0x0bfacd89ec191ec9},
+        {0xb749faed14125d36, 0xcef980ec671f667b}, {0xe51c79a85916f484, 0x82b7e12780e7401a},
+        {0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810}, {0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15},
+        {0xdfbdcece67006ac9, 0x67a791e093e1d49a}, {0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0},
+        {0xaecc49914078536d, 0x58fae9f773886e18}, {0xda7f5bf590966848, 0xaf39a475506a899e},
+        {0x888f99797a5e012d, 0x6d8406c952429603}, {0xaab37fd7d8f58178, 0xc8e5087ba6d33b83},
+        {0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64}, {0x855c3be0a17fcd26, 0x5cf2eea09a55067f},
+        {0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e}, {0xd0601d8efc57b08b, 0xf13b94daf124da26},
+        {0x823c12795db6ce57, 0x76c53d08d6b70858}, {0xa2cb1717b52481ed, 0x54768c4b0c64ca6e},
+        {0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09}, {0xfe5d54150b090b02, 0xd3f93b35435d7c4c},
+        {0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf}, {0xc6b8e9b0709f109a, 0x359ab6419ca1091b},
+        {0xf867241c8cc6d4c0, 0xc30163d203c94b62}, {0x9b407691d7fc44f8, 0x79e0de63425dcf1d},
+        {0xc21094364dfb5636, 0x985915fc12f542e4}, {0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d},
+        {0x979cf3ca6cec5b5a, 0xa705992ceecf9c42}, {0xbd8430bd08277231, 0x50c6ff782a838353},
+        {0xece53cec4a314ebd, 0xa4f8bf5635246428}, {0x940f4613ae5ed136, 0x871b7795e136be99},
+        {0xb913179899f68584, 0x28e2557b59846e3f}, {0xe757dd7ec07426e5, 0x331aeada2fe589cf},
+        {0x9096ea6f3848984f, 0x3ff0d2c85def7621}, {0xb4bca50b065abe63, 0x0fed077a756b53a9},
+        {0xe1ebce4dc7f16dfb, 0xd3e8495912c62894}, {0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c},
+        {0xb080392cc4349dec, 0xbd8d794d96aacfb3}, {0xdca04777f541c567, 0xecf0d7a0fc5583a0},
+        {0x89e42caaf9491b60, 0xf41686c49db57244}, {0xac5d37d5b79b6239, 0x311c2875c522ced5},
+        {0xd77485cb25823ac7, 0x7d633293366b828b}, {0x86a8d39ef77164bc, 0xae5dff9c02033197},
+        {0xa8530886b54dbdeb, 0xd9f57f830283fdfc}, {0xd267caa862a12d66, 0xd072df63c324fd7b},
+        {0x8380dea93da4bc60, 0x4247cb9e59f71e6d}, {0xa46116538d0deb78, 0x52d9be85f074e608},
+        {0xcd795be870516656, 0x67902e276c921f8b}, {0x806bd9714632dff6, 0x00ba1cd8a3db53b6},
+        {0xa086cfcd97bf97f3, 0x80e8a40eccd228a4}, {0xc8a883c0fdaf7df0, 0x6122cd128006b2cd},
+        {0xfad2a4b13d1b5d6c, 0x796b805720085f81}, {0x9cc3a6eec6311a63, 0xcbe3303674053bb0},
+        {0xc3f490aa77bd60fc, 0xbedbfc4411068a9c}, {0xf4f1b4d515acb93b, 0xee92fb5515482d44},
+        {0x991711052d8bf3c5, 0x751bdd152d4d1c4a}, {0xbf5cd54678eef0b6, 0xd262d45a78a0635d},
+        {0xef340a98172aace4, 0x86fb897116c87c34}, {0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0},
+        {0xbae0a846d2195712, 0x8974836059cca109}, {0xe998d258869facd7, 0x2bd1a438703fc94b},
+        {0x91ff83775423cc06, 0x7b6306a34627ddcf}, {0xb67f6455292cbf08, 0x1a3bc84c17b1d542},
+        {0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93}, {0x8e938662882af53e, 0x547eb47b7282ee9c},
+        {0xb23867fb2a35b28d, 0xe99e619a4f23aa43}, {0xdec681f9f4c31f31, 0x6405fa00e2ec94d4},
+        {0x8b3c113c38f9f37e, 0xde83bc408dd3dd04}, {0xae0b158b4738705e, 0x9624ab50b148d445},
+        {0xd98ddaee19068c76, 0x3badd624dd9b0957}, {0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6},
+        {0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c}, {0xd47487cc8470652b, 0x7647c3200069671f},
+        {0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073}, {0xa5fb0a17c777cf09, 0xf468107100525890},
+        {0xcf79cc9db955c2cc, 0x7182148d4066eeb4}, {0x81ac1fe293d599bf, 0xc6f14cd848405530},
+        {0xa21727db38cb002f, 0xb8ada00e5a506a7c}, {0xca9cf1d206fdc03b, 0xa6d90811f0e4851c},
+        {0xfd442e4688bd304a, 0x908f4a166d1da663}, {0x9e4a9cec15763e2e, 0x9a598e4e043287fe},
+        {0xc5dd44271ad3cdba, 0x40eff1e1853f29fd}, {0xf7549530e188c128, 0xd12bee59e68ef47c},
+        {0x9a94dd3e8cf578b9, 0x82bb74f8301958ce}, {0xc13a148e3032d6e7, 0xe36a52363c1faf01},
+        {0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1}, {0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9},
+        {0xbcb2b812db11a5de, 0x7415d448f6b6f0e7}, {0xebdf661791d60f56, 0x111b495b3464ad21},
+        {0x936b9fcebb25c995, 0xcab10dd900beec34}, {0xb84687c269ef3bfb, 0x3d5d514f40eea742},
+        {0xe65829b3046b0afa, 0x0cb4a5a3112a5112}, {0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab},
+        {0xb3f4e093db73a093, 0x59ed216765690f56}, {0xe0f218b8d25088b8, 0x306869c13ec3532c},
+        {0x8c974f7383725573, 0x1e414218c73a13fb}, {0xafbd2350644eeacf, 0xe5d1929ef90898fa},
+        {0xdbac6c247d62a583, 0xdf45f746b74abf39}, {0x894bc396ce5da772, 0x6b8bba8c328eb783},
+        {0xab9eb47c81f5114f, 0x066ea92f3f326564}, {0xd686619ba27255a2, 0xc80a537b0efefebd},
+        {0x8613fd0145877585, 0xbd06742ce95f5f36}, {0xa798fc4196e952e7, 0x2c48113823b73704},
+        {0xd17f3b51fca3a7a0, 0xf75a15862ca504c5}, {0x82ef85133de648c4, 0x9a984d73dbe722fb},
+        {0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba}, {0xcc963fee10b7d1b3, 0x318df905079926a8},
+        {0xffbbcfe994e5c61f, 0xfdf17746497f7052}, {0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633},
+        {0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0}, {0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0},
+        {0x9c1661a651213e2d, 0x06bea10ca65c084e}, {0xc31bfa0fe5698db8, 0x486e494fcff30a62},
+        {0xf3e2f893dec3f126, 0x5a89dba3c3efccfa}, {0x986ddb5c6b3a76b7, 0xf89629465a75e01c},
+        {0xbe89523386091465, 0xf6bbb397f1135823}, {0xee2ba6c0678b597f, 0x746aa07ded582e2c},
+        {0x94db483840b717ef, 0xa8c2a44eb4571cdc}, {0xba121a4650e4ddeb, 0x92f34d62616ce413},
+        {0xe896a0d7e51e1566, 0x77b020baf9c81d17}, {0x915e2486ef32cd60, 0x0ace1474dc1d122e},
+        {0xb5b5ada8aaff80b8, 0x0d819992132456ba}, {0xe3231912d5bf60e6, 0x10e1fff697ed6c69},
+        {0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1}, {0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2},
+        {0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde}, {0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b},
+        {0xad4ab7112eb3929d, 0x86c16c98d2c953c6}, {0xd89d64d57a607744, 0xe871c7bf077ba8b7},
+        {0x87625f056c7c4a8b, 0x11471cd764ad4972}, {0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf},
+        {0xd389b47879823479, 0x4aff1d108d4ec2c3}, {0x843610cb4bf160cb, 0xcedf722a585139ba},
+        {0xa54394fe1eedb8fe, 0xc2974eb4ee658828}, {0xce947a3da6a9273e, 0x733d226229feea32},
+        {0x811ccc668829b887, 0x0806357d5a3f525f}, {0xa163ff802a3426a8, 0xca07c2dcb0cf26f7},
+        {0xc9bcff6034c13052, 0xfc89b393dd02f0b5}, {0xfc2c3f3841f17c67, 0xbbac2078d443ace2},
+        {0x9d9ba7832936edc0, 0xd54b944b84aa4c0d}, {0xc5029163f384a931, 0x0a9e795e65d4df11},
+        {0xf64335bcf065d37d, 0x4d4617b5ff4a16d5}, {0x99ea0196163fa42e, 0x504bced1bf8e4e45},
+        {0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6}, {0xf07da27a82c37088, 0x5d767327bb4e5a4c},
+        {0x964e858c91ba2655, 0x3a6a07f8d510f86f}, {0xbbe226efb628afea, 0x890489f70a55368b},
+        {0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e}, {0x92c8ae6b464fc96f, 0x3b0b8bc90012929d},
+        {0xb77ada0617e3bbcb, 0x09ce6ebb40173744}, {0xe55990879ddcaabd, 0xcc420a6a101d0515},
+        {0x8f57fa54c2a9eab6, 0x9fa946824a12232d}, {0xb32df8e9f3546564, 0x47939822dc96abf9},
+        {0xdff9772470297ebd, 0x59787e2b93bc56f7}, {0x8bfbea76c619ef36, 0x57eb4edb3c55b65a},
+        {0xaefae51477a06b03, 0xede622920b6b23f1}, {0xdab99e59958885c4, 0xe95fab368e45eced},
+        {0x88b402f7fd75539b, 0x11dbcb0218ebb414}, {0xaae103b5fcd2a881, 0xd652bdc29f26a119},
+        {0xd59944a37c0752a2, 0x4be76d3346f0495f}, {0x857fcae62d8493a5, 0x6f70a4400c562ddb},
+        {0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952}, {0xd097ad07a71f26b2, 0x7e2000a41346a7a7},
+        {0x825ecc24c873782f, 0x8ed400668c0c28c8}, {0xa2f67f2dfa90563b, 0x728900802f0f32fa},
+        {0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9}, {0xfea126b7d78186bc, 0xe2f610c84987bfa8},
+        {0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9}, {0xc6ede63fa05d3143, 0x91503d1c79720dbb},
+        {0xf8a95fcf88747d94, 0x75a44c6397ce912a}, {0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba},
+        {0xc24452da229b021b, 0xfbe85badce996168}, {0xf2d56790ab41c2a2, 0xfae27299423fb9c3},
+        {0x97c560ba6b0919a5, 0xdccd879fc967d41a}, {0xbdb6b8e905cb600f, 0x5400e987bbc1c920},
+        {0xed246723473e3813, 0x290123e9aab23b68}, {0x9436c0760c86e30b, 0xf9a0b6720aaf6521},
+        {0xb94470938fa89bce, 0xf808e40e8d5b3e69}, {0xe7958cb87392c2c2, 0xb60b1d1230b20e04},
+        {0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2}, {0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3},
+        {0xe2280b6c20dd5232, 0x25c6da63c38de1b0}, {0x8d590723948a535f, 0x579c487e5a38ad0e},
+        {0xb0af48ec79ace837, 0x2d835a9df0c6d851}, {0xdcdb1b2798182244, 0xf8e431456cf88e65},
+        {0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff}, {0xac8b2d36eed2dac5, 0xe272467e3d222f3f},
+        {0xd7adf884aa879177, 0x5b0ed81dcc6abb0f}, {0x86ccbb52ea94baea, 0x98e947129fc2b4e9},
+        {0xa87fea27a539e9a5, 0x3f2398d747b36224}, {0xd29fe4b18e88640e, 0x8eec7f0d19a03aad},
+        {0x83a3eeeef9153e89, 0x1953cf68300424ac}, {0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7},
+        {0xcdb02555653131b6, 0x3792f412cb06794d}, {0x808e17555f3ebf11, 0xe2bbd88bbee40bd0},
+        {0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4}, {0xc8de047564d20a8b, 0xf245825a5a445275},
+        {0xfb158592be068d2e, 0xeed6e2f0f0d56712}, {0x9ced737bb6c4183d, 0x55464dd69685606b},
+        {0xc428d05aa4751e4c, 0xaa97e14c3c26b886}, {0xf53304714d9265df, 0xd53dd99f4b3066a8},
+        {0x993fe2c6d07b7fab, 0xe546a8038efe4029}, {0xbf8fdb78849a5f96, 0xde98520472bdd033},
+        {0xef73d256a5c0f77c, 0x963e66858f6d4440}, {0x95a8637627989aad, 0xdde7001379a44aa8},
+        {0xbb127c53b17ec159, 0x5560c018580d5d52}, {0xe9d71b689dde71af, 0xaab8f01e6e10b4a6},
+        {0x9226712162ab070d, 0xcab3961304ca70e8}, {0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22},
+        {0xe45c10c42a2b3b05, 0x8cb89a7db77c506a}, {0x8eb98a7a9a5b04e3, 0x77f3608e92adb242},
+        {0xb267ed1940f1c61c, 0x55f038b237591ed3}, {0xdf01e85f912e37a3, 0x6b6c46dec52f6688},
+        {0x8b61313bbabce2c6, 0x2323ac4b3b3da015}, {0xae397d8aa96c1b77, 0xabec975e0a0d081a},
+        {0xd9c7dced53c72255, 0x96e7bd358c904a21}, {0x881cea14545c7575, 0x7e50d64177da2e54},
+        {0xaa242499697392d2, 0xdde50bd1d5d0b9e9}, {0xd4ad2dbfc3d07787, 0x955e4ec64b44e864},
+        {0x84ec3c97da624ab4, 0xbd5af13bef0b113e}, {0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e},
+        {0xcfb11ead453994ba, 0x67de18eda5814af2}, {0x81ceb32c4b43fcf4, 0x80eacf948770ced7},
+        {0xa2425ff75e14fc31, 0xa1258379a94d028d}, {0xcad2f7f5359a3b3e, 0x096ee45813a04330},
+        {0xfd87b5f28300ca0d, 0x8bca9d6e188853fc}, {0x9e74d1b791e07e48, 0x775ea264cf55347e},
+        {0xc612062576589dda, 0x95364afe032a819e}, {0xf79687aed3eec551, 0x3a83ddbd83f52205},
+        {0x9abe14cd44753b52, 0xc4926a9672793543}, {0xc16d9a0095928a27, 0x75b7053c0f178294},
+        {0xf1c90080baf72cb1, 0x5324c68b12dd6339}, {0x971da05074da7bee, 0xd3f6fc16ebca5e04},
+        {0xbce5086492111aea, 0x88f4bb1ca6bcf585}, {0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6},
+        {0x9392ee8e921d5d07, 0x3aff322e62439fd0}, {0xb877aa3236a4b449, 0x09befeb9fad487c3},
+        {0xe69594bec44de15b, 0x4c2ebe687989a9b4}, {0x901d7cf73ab0acd9, 0x0f9d37014bf60a11},
+        {0xb424dc35095cd80f, 0x538484c19ef38c95}, {0xe12e13424bb40e13, 0x2865a5f206b06fba},
+        {0x8cbccc096f5088cb, 0xf93f87b7442e45d4}, {0xafebff0bcb24aafe, 0xf78f69a51539d749},
+        {0xdbe6fecebdedd5be, 0xb573440e5a884d1c}, {0x89705f4136b4a597, 0x31680a88f8953031},
+        {0xabcc77118461cefc, 0xfdc20d2b36ba7c3e}, {0xd6bf94d5e57a42bc, 0x3d32907604691b4d},
+        {0x8637bd05af6c69b5, 0xa63f9a49c2c1b110}, {0xa7c5ac471b478423, 0x0fcf80dc33721d54},
+        {0xd1b71758e219652b, 0xd3c36113404ea4a9}, {0x83126e978d4fdf3b, 0x645a1cac083126ea},
+        {0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4}, {0xcccccccccccccccc, 0xcccccccccccccccd},
+        {0x8000000000000000, 0x0000000000000000}, {0xa000000000000000, 0x0000000000000000},
+        {0xc800000000000000, 0x0000000000000000}, {0xfa00000000000000, 0x0000000000000000},
+        {0x9c40000000000000, 0x0000000000000000}, {0xc350000000000000, 0x0000000000000000},
+        {0xf424000000000000, 0x0000000000000000}, {0x9896800000000000, 0x0000000000000000},
+        {0xbebc200000000000, 0x0000000000000000}, {0xee6b280000000000, 0x0000000000000000},
+        {0x9502f90000000000, 0x0000000000000000}, {0xba43b74000000000, 0x0000000000000000},
+        {0xe8d4a51000000000, 0x0000000000000000}, {0x9184e72a00000000, 0x0000000000000000},
+        {0xb5e620f480000000, 0x0000000000000000}, {0xe35fa931a0000000, 0x0000000000000000},
+        {0x8e1bc9bf04000000, 0x0000000000000000}, {0xb1a2bc2ec5000000, 0x0000000000000000},
+        {0xde0b6b3a76400000, 0x0000000000000000}, {0x8ac7230489e80000, 0x0000000000000000},
+        {0xad78ebc5ac620000, 0x0000000000000000}, {0xd8d726b7177a8000, 0x0000000000000000},
+        {0x878678326eac9000, 0x0000000000000000}, {0xa968163f0a57b400, 0x0000000000000000},
+        {0xd3c21bcecceda100, 0x0000000000000000}, {0x84595161401484a0, 0x0000000000000000},
+        {0xa56fa5b99019a5c8, 0x0000000000000000}, {0xcecb8f27f4200f3a, 0x0000000000000000},
+        {0x813f3978f8940984, 0x4000000000000000}, {0xa18f07d736b90be5, 0x5000000000000000},
+        {0xc9f2c9cd04674ede, 0xa400000000000000}, {0xfc6f7c4045812296, 0x4d00000000000000},
+        {0x9dc5ada82b70b59d, 0xf020000000000000}, {0xc5371912364ce305, 0x6c28000000000000},
+        {0xf684df56c3e01bc6, 0xc732000000000000}, {0x9a130b963a6c115c, 0x3c7f400000000000},
+        {0xc097ce7bc90715b3, 0x4b9f100000000000}, {0xf0bdc21abb48db20, 0x1e86d40000000000},
+        {0x96769950b50d88f4, 0x1314448000000000}, {0xbc143fa4e250eb31, 0x17d955a000000000},
+        {0xeb194f8e1ae525fd, 0x5dcfab0800000000}, {0x92efd1b8d0cf37be, 0x5aa1cae500000000},
+        {0xb7abc627050305ad, 0xf14a3d9e40000000}, {0xe596b7b0c643c719, 0x6d9ccd05d0000000},
+        {0x8f7e32ce7bea5c6f, 0xe4820023a2000000}, {0xb35dbf821ae4f38b, 0xdda2802c8a800000},
+        {0xe0352f62a19e306e, 0xd50b2037ad200000}, {0x8c213d9da502de45, 0x4526f422cc340000},
+        {0xaf298d050e4395d6, 0x9670b12b7f410000}, {0xdaf3f04651d47b4c, 0x3c0cdd765f114000},
+        {0x88d8762bf324cd0f, 0xa5880a69fb6ac800}, {0xab0e93b6efee0053, 0x8eea0d047a457a00},
+        {0xd5d238a4abe98068, 0x72a4904598d6d880}, {0x85a36366eb71f041, 0x47a6da2b7f864750},
+        {0xa70c3c40a64e6c51, 0x999090b65f67d924}, {0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d},
+        {0x82818f1281ed449f, 0xbff8f10e7a8921a4}, {0xa321f2d7226895c7, 0xaff72d52192b6a0d},
+        {0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490}, {0xfee50b7025c36a08, 0x02f236d04753d5b4},
+        {0x9f4f2726179a2245, 0x01d762422c946590}, {0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5},
+        {0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2}, {0x9b934c3b330c8577, 0x63cc55f49f88eb2f},
+        {0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb}, {0xf316271c7fc3908a, 0x8bef464e3945ef7a},
+        {0x97edd871cfda3a56, 0x97758bf0e3cbb5ac}, {0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317},
+        {0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd}, {0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a},
+        {0xb975d6b6ee39e436, 0xb3e2fd538e122b44}, {0xe7d34c64a9c85d44, 0x60dbbca87196b616},
+        {0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd}, {0xb51d13aea4a488dd, 0x6babab6398bdbe41},
+        {0xe264589a4dcdab14, 0xc696963c7eed2dd1}, {0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2},
+        {0xb0de65388cc8ada8, 0x3b25a55f43294bcb}, {0xdd15fe86affad912, 0x49ef0eb713f39ebe},
+        {0x8a2dbf142dfcc7ab, 0x6e3569326c784337}, {0xacb92ed9397bf996, 0x49c2c37f07965404},
+        {0xd7e77a8f87daf7fb, 0xdc33745ec97be906}, {0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3},
+        {0xa8acd7c0222311bc, 0xc40832ea0d68ce0c}, {0xd2d80db02aabd62b, 0xf50a3fa490c30190},
+        {0x83c7088e1aab65db, 0x792667c6da79e0fa}, {0xa4b8cab1a1563f52, 0x577001b891185938},
+        {0xcde6fd5e09abcf26, 0xed4c0226b55e6f86}, {0x80b05e5ac60b6178, 0x544f8158315b05b4},
+        {0xa0dc75f1778e39d6, 0x696361ae3db1c721}, {0xc913936dd571c84c, 0x03bc3a19cd1e38e9},
+        {0xfb5878494ace3a5f, 0x04ab48a04065c723}, {0x9d174b2dcec0e47b, 0x62eb0d64283f9c76},
+        {0xc45d1df942711d9a, 0x3ba5d0bd324f8394}, {0xf5746577930d6500, 0xca8f44ec7ee36479},
+        {0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb}, {0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e},
+        {0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e}, {0x95d04aee3b80ece5, 0xbba1f1d158724a12},
+        {0xbb445da9ca61281f, 0x2a8a6e45ae8edc97}, {0xea1575143cf97226, 0xf52d09d71a3293bd},
+        {0x924d692ca61be758, 0x593c2626705f9c56}, {0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c},
+        {0xe498f455c38b997a, 0x0b6dfb9c0f956447}, {0x8edf98b59a373fec, 0x4724bd4189bd5eac},
+        {0xb2977ee300c50fe7, 0x58edec91ec2cb657}, {0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed},
+        {0x8b865b215899f46c, 0xbd79e0d20082ee74}, {0xae67f1e9aec07187, 0xecd8590680a3aa11},
+        {0xda01ee641a708de9, 0xe80e6f4820cc9495}, {0x884134fe908658b2, 0x3109058d147fdcdd},
+        {0xaa51823e34a7eede, 0xbd4b46f0599fd415}, {0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a},
+        {0x850fadc09923329e, 0x03e2cf6bc604ddb0}, {0xa6539930bf6bff45, 0x84db8346b786151c},
+        {0xcfe87f7cef46ff16, 0xe612641865679a63}, {0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e},
+        {0xa26da3999aef7749, 0xe3be5e330f38f09d}, {0xcb090c8001ab551c, 0x5cadf5bfd3072cc5},
+        {0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6}, {0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa},
+        {0xc646d63501a1511d, 0xb281e1fd541501b8}, {0xf7d88bc24209a565, 0x1f225a7ca91a4226},
+        {0x9ae757596946075f, 0x3375788de9b06958}, {0xc1a12d2fc3978937, 0x0052d6b1641c83ae},
+        {0xf209787bb47d6b84, 0xc0678c5dbd23a49a}, {0x9745eb4d50ce6332, 0xf840b7ba963646e0},
+        {0xbd176620a501fbff, 0xb650e5a93bc3d898}, {0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe},
+        {0x93ba47c980e98cdf, 0xc66f336c36b10137}, {0xb8a8d9bbe123f017, 0xb80b0047445d4184},
+        {0xe6d3102ad96cec1d, 0xa60dc059157491e5}, {0x9043ea1ac7e41392, 0x87c89837ad68db2f},
+        {0xb454e4a179dd1877, 0x29babe4598c311fb}, {0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a},
+        {0x8ce2529e2734bb1d, 0x1899e4a65f58660c}, {0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f},
+        {0xdc21a1171d42645d, 0x76707543f4fa1f73}, {0x899504ae72497eba, 0x6a06494a791c53a8},
+        {0xabfa45da0edbde69, 0x0487db9d17636892}, {0xd6f8d7509292d603, 0x45a9d2845d3c42b6},
+        {0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2}, {0xa7f26836f282b732, 0x8e6cac7768d7141e},
+        {0xd1ef0244af2364ff, 0x3207d795430cd926}, {0x8335616aed761f1f, 0x7f44e6bd49e807b8},
+        {0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6}, {0xcd036837130890a1, 0x36dba887c37a8c0f},
+        {0x802221226be55a64, 0xc2494954da2c9789}, {0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c},
+        {0xc83553c5c8965d3d, 0x6f92829494e5acc7}, {0xfa42a8b73abbf48c, 0xcb772339ba1f17f9},
+        {0x9c69a97284b578d7, 0xff2a760414536efb}, {0xc38413cf25e2d70d, 0xfef5138519684aba},
+        {0xf46518c2ef5b8cd1, 0x7eb258665fc25d69}, {0x98bf2f79d5993802, 0xef2f773ffbd97a61},
+        {0xbeeefb584aff8603, 0xaafb550ffacfd8fa}, {0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38},
+        {0x952ab45cfa97a0b2, 0xdd945a747bf26183}, {0xba756174393d88df, 0x94f971119aeef9e4},
+        {0xe912b9d1478ceb17, 0x7a37cd5601aab85d}, {0x91abb422ccb812ee, 0xac62e055c10ab33a},
+        {0xb616a12b7fe617aa, 0x577b986b314d6009}, {0xe39c49765fdf9d94, 0xed5a7e85fda0b80b},
+        {0x8e41ade9fbebc27d, 0x14588f13be847307}, {0xb1d219647ae6b31c, 0x596eb2d8ae258fc8},
+        {0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb}, {0x8aec23d680043bee, 0x25de7bb9480d5854},
+        {0xada72ccc20054ae9, 0xaf561aa79a10ae6a}, {0xd910f7ff28069da4, 0x1b2ba1518094da04},
+        {0x87aa9aff79042286, 0x90fb44d2f05d0842}, {0xa99541bf57452b28, 0x353a1607ac744a53},
+        {0xd3fa922f2d1675f2, 0x42889b8997915ce8}, {0x847c9b5d7c2e09b7, 0x69956135febada11},
+        {0xa59bc234db398c25, 0x43fab9837e699095}, {0xcf02b2c21207ef2e, 0x94f967e45e03f4bb},
+        {0x8161afb94b44f57d, 0x1d1be0eebac278f5}, {0xa1ba1ba79e1632dc, 0x6462d92a69731732},
+        {0xca28a291859bbf93, 0x7d7b8f7503cfdcfe}, {0xfcb2cb35e702af78, 0x5cda735244c3d43e},
+        {0x9defbf01b061adab, 0x3a0888136afa64a7}, {0xc56baec21c7a1916, 0x088aaa1845b8fdd0},
+        {0xf6c69a72a3989f5b, 0x8aad549e57273d45}, {0x9a3c2087a63f6399, 0x36ac54e2f678864b},
+        {0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd}, {0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5},
+        {0x969eb7c47859e743, 0x9f644ae5a4b1b325}, {0xbc4665b596706114, 0x873d5d9f0dde1fee},
+        {0xeb57ff22fc0c7959, 0xa90cb506d155a7ea}, {0x9316ff75dd87cbd8, 0x09a7f12442d588f2},
+        {0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f}, {0xe5d3ef282a242e81, 0x8f1668c8a86da5fa},
+        {0x8fa475791a569d10, 0xf96e017d694487bc}, {0xb38d92d760ec4455, 0x37c981dcc395a9ac},
+        {0xe070f78d3927556a, 0x85bbe253f47b1417}, {0x8c469ab843b89562, 0x93956d7478ccec8e},
+        {0xaf58416654a6babb, 0x387ac8d1970027b2}, {0xdb2e51bfe9d0696a, 0x06997b05fcc0319e},
+        {0x88fcf317f22241e2, 0x441fece3bdf81f03}, {0xab3c2fddeeaad25a, 0xd527e81cad7626c3},
+        {0xd60b3bd56a5586f1, 0x8a71e223d8d3b074}, {0x85c7056562757456, 0xf6872d5667844e49},
+        {0xa738c6bebb12d16c, 0xb428f8ac016561db}, {0xd106f86e69d785c7, 0xe13336d701beba52},
+        {0x82a45b450226b39c, 0xecc0024661173473}, {0xa34d721642b06084, 0x27f002d7f95d0190},
+        {0xcc20ce9bd35c78a5, 0x31ec038df7b441f4}, {0xff290242c83396ce, 0x7e67047175a15271},
+        {0x9f79a169bd203e41, 0x0f0062c6e984d386}, {0xc75809c42c684dd1, 0x52c07b78a3e60868},
+        {0xf92e0c3537826145, 0xa7709a56ccdf8a82}, {0x9bbcc7a142b17ccb, 0x88a66076400bb691},
+        {0xc2abf989935ddbfe, 0x6acff893d00ea435}, {0xf356f7ebf83552fe, 0x0583f6b8c4124d43},
+        {0x98165af37b2153de, 0xc3727a337a8b704a}, {0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c},
+        {0xeda2ee1c7064130c, 0x1162def06f79df73}, {0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8},
+        {0xb9a74a0637ce2ee1, 0x6d953e2bd7173692}, {0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437},
+        {0x910ab1d4db9914a0, 0x1d9c9892400a22a2}, {0xb54d5e4a127f59c8, 0x2503beb6d00cab4b},
+        {0xe2a0b5dc971f303a, 0x2e44ae64840fd61d}, {0x8da471a9de737e24, 0x5ceaecfed289e5d2},
+        {0xb10d8e1456105dad, 0x7425a83e872c5f47}, {0xdd50f1996b947518, 0xd12f124e28f77719},
+        {0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f}, {0xace73cbfdc0bfb7b, 0x636cc64d1001550b},
+        {0xd8210befd30efa5a, 0x3c47f7e05401aa4e}, {0x8714a775e3e95c78, 0x65acfaec34810a71},
+        {0xa8d9d1535ce3b396, 0x7f1839a741a14d0d}, {0xd31045a8341ca07c, 0x1ede48111209a050},
+        {0x83ea2b892091e44d, 0x934aed0aab460432}, {0xa4e4b66b68b65d60, 0xf81da84d5617853f},
+        {0xce1de40642e3f4b9, 0x36251260ab9d668e}, {0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019},
+        {0xa1075a24e4421730, 0xb24cf65b8612f81f}, {0xc94930ae1d529cfc, 0xdee033f26797b627},
+        {0xfb9b7cd9a4a7443c, 0x169840ef017da3b1}, {0x9d412e0806e88aa5, 0x8e1f289560ee864e},
+        {0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2}, {0xf5b5d7ec8acb58a2, 0xae10af696774b1db},
+        {0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29}, {0xbff610b0cc6edd3f, 0x17fd090a58d32af3},
+        {0xeff394dcff8a948e, 0xddfc4b4cef07f5b0}, {0x95f83d0a1fb69cd9, 0x4abdaf101564f98e},
+        {0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1}, {0xea53df5fd18d5513, 0x84c86189216dc5ed},
+        {0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4}, {0xb7118682dbb66a77, 0x3fbc8c33221dc2a1},
+        {0xe4d5e82392a40515, 0x0fabaf3feaa5334a}, {0x8f05b1163ba6832d, 0x29cb4d87f2a7400e},
+        {0xb2c71d5bca9023f8, 0x743e20e9ef511012}, {0xdf78e4b2bd342cf6, 0x914da9246b255416},
+        {0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e}, {0xae9672aba3d0c320, 0xa184ac2473b529b1},
+        {0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e}, {0x8865899617fb1871, 0x7e2fa67c7a658892},
+        {0xaa7eebfb9df9de8d, 0xddbb901b98feeab7}, {0xd51ea6fa85785631, 0x552a74227f3ea565},
+        {0x8533285c936b35de, 0xd53a88958f87275f}, {0xa67ff273b8460356, 0x8a892abaf368f137},
+        {0xd01fef10a657842c, 0x2d2b7569b0432d85}, {0x8213f56a67f6b29b, 0x9c3b29620e29fc73},
+        {0xa298f2c501f45f42, 0x8349f3ba91b47b8f}, {0xcb3f2f7642717713, 0x241c70a936219a73},
+        {0xfe0efb53d30dd4d7, 0xed238cd383aa0110}, {0x9ec95d1463e8a506, 0xf4363804324a40aa},
+        {0xc67bb4597ce2ce48, 0xb143c6053edcd0d5}, {0xf81aa16fdc1b81da, 0xdd94b7868e94050a},
+        {0x9b10a4e5e9913128, 0xca7cf2b4191c8326}, {0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0},
+        {0xf24a01a73cf2dccf, 0xbc633b39673c8cec}, {0x976e41088617ca01, 0xd5be0503e085d813},
+        {0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18}, {0xec9c459d51852ba2, 0xddf8e7d60ed1219e},
+        {0x93e1ab8252f33b45, 0xcabb90e5c942b503}, {0xb8da1662e7b00a17, 0x3d6a751f3b936243},
+        {0xe7109bfba19c0c9d, 0x0cc512670a783ad4}, {0x906a617d450187e2, 0x27fb2b80668b24c5},
+        {0xb484f9dc9641e9da, 0xb1f9f660802dedf6}, {0xe1a63853bbd26451, 0x5e7873f8a0396973},
+        {0x8d07e33455637eb2, 0xdb0b487b6423e1e8}, {0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62},
+        {0xdc5c5301c56b75f7, 0x7641a140cc7810fb}, {0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d},
+        {0xac2820d9623bf429, 0x546345fa9fbdcd44}, {0xd732290fbacaf133, 0xa97c177947ad4095},
+        {0x867f59a9d4bed6c0, 0x49ed8eabcccc485d}, {0xa81f301449ee8c70, 0x5c68f256bfff5a74},
+        {0xd226fc195c6a2f8c, 0x73832eec6fff3111}, {0x83585d8fd9c25db7, 0xc831fd53c5ff7eab},
+        {0xa42e74f3d032f525, 0xba3e7ca8b77f5e55}, {0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb},
+        {0x80444b5e7aa7cf85, 0x7980d163cf5b81b3}, {0xa0555e361951c366, 0xd7e105bcc332621f},
+        {0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7}, {0xfa856334878fc150, 0xb14f98f6f0feb951},
+        {0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3}, {0xc3b8358109e84f07, 0x0a862f80ec4700c8},
+        {0xf4a642e14c6262c8, 0xcd27bb612758c0fa}, {0x98e7e9cccfbd7dbd, 0x8038d51cb897789c},
+        {0xbf21e44003acdd2c, 0xe0470a63e6bd56c3}, {0xeeea5d5004981478, 0x1858ccfce06cac74},
+        {0x95527a5202df0ccb, 0x0f37801e0c43ebc8}, {0xbaa718e68396cffd, 0xd30560258f54e6ba},
+        {0xe950df20247c83fd, 0x47c6b82ef32a2069}, {0x91d28b7416cdd27e, 0x4cdc331d57fa5441},
+        {0xb6472e511c81471d, 0xe0133fe4adf8e952}, {0xe3d8f9e563a198e5, 0x58180fddd97723a6},
+        {0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648},
+    };
 
-ObjectHandler::~ObjectHandler() {}
+    static const int smallest_power_of_five = -342;
 
-std::string ObjectHandler::type_name() const { return "object"; }
+    static void multiply_128(std::uint64_t a, std::uint64_t b, std::uint64_t* hi, std::uint64_t* lo)
+    {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 uint128;
+        uint128 r = static_cast<uint128>(a) * b;
+        *hi = static_cast<std::uint64_t>(r >> 64);
+        *lo = static_cast<std::uint64_t>(r);
+#else
+        std::uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+        std::uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+        std::uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+        std::uint64_t middle = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+        *lo = (middle << 32) | (ll & 0xffffffffu);
+        *hi = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+#endif
+    }
 
-bool ObjectHandler::precheck(const char* actual_type)
-{
-    if (depth <= 0)
+    static int leading_zeros(std::uint64_t x)
     {
-        the_error.reset(new error::TypeMismatchError(type_name(), actual_type));
-        return false;
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(x);
+#else
+        int n = 0;
+        for (std::uint64_t bit = std::uint64_t(1) << 63; !(x & bit); bit >>= 1)
+            ++n;
+        return n;
+#endif
     }
-    if (current && current->handler && current->handler->is_parsed())
+
+    template <class Float>
+    struct FloatFormat;
+
+    template <>
+    struct FloatFormat<double>
     {
-        if (flags & Flags::AllowDuplicateKey)
+        typedef std::uint64_t Bits;
+        static const int mantissa_bits = 52, minimum_exponent = -1023, infinite_power = 0x7ff,
+                         min_round_to_even = -4, max_round_to_even = 23,
+                         smallest_power_of_ten = -342, largest_power_of_ten = 308,
+                         max_exact_power_of_ten = 22;
+
+        static double exact_power_of_ten(int q)
         {
-            current->handler->prepare_for_reuse();
+            static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                            1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                            1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            return powers[q];
         }
-        else
+
+        static double fallback(const char* str) { return std::strtod(str, nullptr); }
+    };
+
+    template <>
+    struct FloatFormat<float>
+    {
+        typedef std::uint32_t Bits;
+        static const int mantissa_bits = 23, minimum_exponent = -127, infinite_power = 0xff,
+                         min_round_to_even = -17, max_round_to_even = 10,
+                         smallest_power_of_ten = -65, largest_power_of_ten = 38,
+                         max_exact_power_of_ten = 10;
+
+        static float exact_power_of_ten(int q)
         {
-            the_error.reset(new error::DuplicateKeyError(current_name));
+            static const float powers[]
+                = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+            return powers[q];
+        }
+
+        static float fallback(const char* str) { return std::strtof(str, nullptr); }
+    };
+
+    // A JSON number as `mantissa * 10^exponent`, keeping at most 19 significant digits
+    struct DecimalNumber
+    {
+        bool negative;
+        bool truncated;
+        std::uint64_t mantissa;
+        int exponent;
+    };
+
+    static bool parse_decimal(const char* p, const char* end, DecimalNumber* d)
+    {
+        d->negative = p != end && *p == '-';
+        if (d->negative)
+            ++p;
+        d->truncated = false;
+        d->mantissa = 0;
+        d->exponent = 0;
+        int digits = 0;
+        bool seen_digit = false, in_fraction = false;
+        for (; p != end; ++p)
+        {
+            if (*p == '.' && !in_fraction && seen_digit)
+            {
+                in_fraction = true;
+                seen_digit = false;
+                continue;
+            }
+            if (*p < '0' || *p > '9')
+                break;
+            seen_digit = true;
+            unsigned digit = static_cast<unsigned>(*p - '0');
+            if (digits < 19)
+            {
+                d->mantissa = d->mantissa * 10 + digit;
+                digits += d->mantissa != 0;
+                d->exponent -= in_fraction;
+            }
+            else
+            {
+                d->truncated |= digit != 0;
+                d->exponent += !in_fraction;
+            }
+        }
+        if (!seen_digit)
             return false;
+        if (p != end && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+            bool negative_exponent = p != end && *p == '-';
+            if (p != end && (*p == '-' || *p == '+'))
+                ++p;
+            if (p == end)
+                return false;
+            int e = 0;
+            for (; p != end && *p >= '0' && *p <= '9'; ++p)
+                if (e < 100000)
+                    e = e * 10 + (*p - '0');
+            d->exponent += negative_exponent ? -e : e;
         }
+        return p == end;
     }
-    return true;
-}
 
-bool ObjectHandler::postcheck(bool success)
-{
-    if (!success)
+    // Returns the bits of the floating point number nearest to w * 10^q, for a nonzero w
+    template <class Float>
+    static typename FloatFormat<Float>::Bits eisel_lemire(std::uint64_t w, int q)
     {
-        the_error.reset(new error::ObjectMemberError(current_name));
+        typedef FloatFormat<Float> F;
+        typedef typename F::Bits Bits;
+        if (q < F::smallest_power_of_ten)
+            return 0;
+        if (q > F::largest_power_of_ten)
+            return Bits(F::infinite_power) << F::mantissa_bits;
+
+        int lz = leading_zeros(w);
+        w <<= lz;
+        const std::uint64_t* power = powers_of_five[q - smallest_power_of_five];
+        std::uint64_t hi, lo;
+        multiply_128(w, power[0], &hi, &lo);
+        const std::uint64_t precision_mask = ~std::uint64_t(0) >> (F::mantissa_bits + 3);
+        if ((hi & precision_mask) == precision_mask)
+        {
+            std::uint64_t hi2, lo2;
+            multiply_128(w, power[1], &hi2, &lo2);
+            lo += hi2;
+            if (hi2 > lo)
+                ++hi;
+        }
+
+        int upperbit = static_cast<int>(hi >> 63);
+        int shift = upperbit + 64 - F::mantissa_bits - 3;
+        std::uint64_t mantissa = hi >> shift;
+        int power2 = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz - F::minimum_exponent;
+
+        if (power2 <= 0)
+        {
+            // Subnormal, or rounds up to the smallest normal number
+            if (-power2 + 1 >= 64)
+                return 0;
+            mantissa >>= -power2 + 1;
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            power2 = mantissa < (std::uint64_t(1) << F::mantissa_bits) ? 0 : 1;
+            return static_cast<Bits>(mantissa | (std::uint64_t(power2) << F::mantissa_bits));
+        }
+
+        // Exactly halfway between two numbers: round to even instead of up
+        if (lo <= 1 && q >= F::min_round_to_even && q <= F::max_round_to_even && (mantissa & 3) == 1
+            && (mantissa << shift) == hi)
+            mantissa &= ~std::uint64_t(1);
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        if (mantissa >= (std::uint64_t(2) << F::mantissa_bits))
+        {
+            mantissa = std::uint64_t(1) << F::mantissa_bits;
+            ++power2;
+        }
+        mantissa &= ~(std::uint64_t(1) << F::mantissa_bits);
+        if (power2 >= F::infinite_power)
+            return Bits(F::infinite_power) << F::mantissa_bits;
+        return static_cast<Bits>(mantissa | (std::uint64_t(power2) << F::mantissa_bits));
     }
-    return success;
-}
 
-void ObjectHandler::set_missing_required(const std::string& name)
-{
-    if (!the_error || the_error->type() != error::MISSING_REQUIRED)
-        the_error.reset(new error::RequiredFieldMissingError());
+    template <class Float>
+    static bool parse_floating_point(const char* str, std::size_t length, Float* out)
+    {
+        typedef FloatFormat<Float> F;
+        typedef typename F::Bits Bits;
+        DecimalNumber d;
+        if (!parse_decimal(str, str + length, &d))
+            return false;
 
-    std::vector<std::string>& missing
-        = static_cast<error::RequiredFieldMissingError*>(the_error.get())->missing_members();
+        Float result;
+        if (d.mantissa == 0 && !d.truncated)
+        {
+            result = 0;
+        }
+        else if (!d.truncated && d.exponent >= -F::max_exact_power_of_ten
+                 && d.exponent <= F::max_exact_power_of_ten
+                 && d.mantissa <= (std::uint64_t(1) << (F::mantissa_bits + 1)))
+        {
+            // Both operands are exact, so a single rounding gives the correct result
+            result = static_cast<Float>(d.mantissa);
+            if (d.exponent < 0)
+                result /= F::exact_power_of_ten(-d.exponent);
+            else
+                result *= F::exact_power_of_ten(d.exponent);
+        }
+        else
+        {
+            Bits bits = eisel_lemire<Float>(d.mantissa, d.exponent);
+            // The dropped digits put the value between w and w + 1
+            if (d.truncated && bits != eisel_lemire<Float>(d.mantissa + 1, d.exponent))
+            {
+                std::string text(str + d.negative, length - d.negative);
+                result = F::fallback(text.c_str());
+            }
+            else
+            {
+                std::memcpy(&result, &bits, sizeof(result));
+            }
+        }
+        if (std::isinf(result))
+            return false;
+        *out = d.negative ? -result : result;
+        return true;
+    }
 
-    missing.push_back(name);
-}
+    bool parse_double(const char* str, std::size_t length, double* out)
+    {
+        return parse_floating_point(str, length, out);
+    }
 
-#define POSTCHECK(x) (!current || !(current->handler) || postcheck(x))
+    bool parse_float(const char* str, std::size_t length, float* out)
+    {
+        return parse_floating_point(str, length, out);
+    }
+}
 
-bool ObjectHandler::Double(double value)
+namespace nonpublic
 {
-    if (!precheck("double"))
-        return false;
-    return POSTCHECK(current->handler->Double(value));
+    // Set when `IHandler::RawNumber` meets a number no double can hold, or `Handler<float>` one no
+    // float can. The parser only sees the handler fail, and the error is reported as it would have
+    // been for a double without the flag.
+    static thread_local bool number_too_big = false;
+
+    void report_number_too_big() { number_too_big = true; }
 }
 
-bool ObjectHandler::Int(int value)
+// Reached when parsing with kParseNumbersAsStringsFlag. The text is converted to the event the
+// parser would have produced without the flag, with doubles correctly rounded.
+bool IHandler::RawNumber(const char* str, SizeType length, bool)
 {
-    if (!precheck("int"))
+    const char *p = str, *end = str + length;
+    bool negative = p != end && *p == '-';
+    if (negative)
+        ++p;
+    const char* digits = p;
+    std::uint64_t v = 0;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p)
+    {
+        unsigned digit = static_cast<unsigned>(*p - '0');
+        if (v > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+            break;
+        v = v * 10 + digit;
+    }
+    if (p == end && p != digits)
+    {
+        if (!negative)
+        {
+            if (v <= std::numeric_limits<unsigned>::max())
+                return Uint(static_cast<unsigned>(v));
+            return Uint64(v);
+        }
+        if (v <= std::uint64_t(1) << 31)
+            return Int(static_cast<int>(-static_cast<std::int64_t>(v)));
+        if (v < std::uint64_t(1) << 63)
+            return Int64(-static_cast<std::int64_t>(v));
+        if (v == std::uint64_t(1) << 63)
+            return Int64(std::numeric_limits<std::int64_t>::min());
+    }
+    double d;
+    if (!nonpublic::parse_double(str, length, &d))
+    {
+        nonpublic::number_too_big = true;
         return false;
-    return POSTCHECK(current->handler->Int(value));
+    }
+    return Double(d);
 }
 
-bool ObjectHandler::Uint(unsigned value)
+bool IHandler::Binary(const std::uint8_t* data, SizeType size)
 {
-    if (!precheck("unsigned"))
-        return false;
-    return POSTCHECK(current->handler->Uint(value));
+    std::string encoded = nonpublic::base64_encode(data, size);
+    return String(encoded.data(), static_cast<SizeType>(encoded.size()), true);
 }
 
-bool ObjectHandler::Bool(bool value)
+bool IHandler::StartSizedArray(SizeType) { return StartArray(); }
+
+bool IHandler::StartSizedObject(SizeType) { return StartObject(); }
+
+namespace
 {
-    if (!precheck("bool"))
-        return false;
-    return POSTCHECK(current->handler->Bool(value));
+    bool write_number(IHandler* h, int v) { return h->Int(v); }
+
+    bool write_number(IHandler* h, unsigned v) { return h->Uint(v); }
+
+    bool write_number(IHandler* h, std::int64_t v) { return h->Int64(v); }
+
+    bool write_number(IHandler* h, std::uint64_t v) { return h->Uint64(v); }
+
+    bool write_number(IHandler* h, double v) { return h->Double(v); }
+
+    template <class Number>
+    bool write_numbers(IHandler* h, const Number* data, SizeType size)
+    {
+        if (!h->StartSizedArray(size))
+            return false;
+        for (SizeType i = 0; i < size; ++i)
+        {
+            if (!write_number(h, data[i]))
+                return false;
+        }
+        return h->EndArray(size);
+    }
 }
 
-bool ObjectHandler::Int64(std::int64_t value)
+bool IHandler::NumberArray(const int* data, SizeType size)
 {
-    if (!precheck("std::int64_t"))
-        return false;
-    return POSTCHECK(current->handler->Int64(value));
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::Uint64(std::uint64_t value)
+bool IHandler::NumberArray(const unsigned* data, SizeType size)
 {
-    if (!precheck("std::uint64_t"))
-        return false;
-    return POSTCHECK(current->handler->Uint64(value));
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::Null()
+bool IHandler::NumberArray(const std::int64_t* data, SizeType size)
 {
-    if (!precheck("null"))
-        return false;
-    return POSTCHECK(current->handler->Null());
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::StartArray()
+bool IHandler::NumberArray(const std::uint64_t* data, SizeType size)
 {
-    if (!precheck("array"))
-        return false;
-    return POSTCHECK(current->handler->StartArray());
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::EndArray(SizeType sz)
+bool IHandler::NumberArray(const float* data, SizeType size)
 {
-    if (!precheck("array"))
-        return false;
-    return POSTCHECK(current->handler->EndArray(sz));
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::String(const char* str, SizeType sz, bool copy)
+bool IHandler::NumberArray(const double* data, SizeType size)
 {
-    if (!precheck("string"))
-        return false;
-    return POSTCHECK(current->handler->String(str, sz, copy));
+    return write_numbers(this, data, size);
 }
 
-bool ObjectHandler::Key(const char* str, SizeType sz, bool copy)
+namespace nonpublic
 {
-    if (depth <= 0)
+    bool EventRecorder::record(Kind kind, std::uint64_t payload, SizeType length)
     {
-        the_error.reset(new error::CorruptedDOMError());
-        return false;
+        Event e = {kind, length, payload};
+        m_events.push_back(e);
+        return true;
     }
-    if (depth == 1)
+
+    bool EventRecorder::record_text(Kind kind, const char* data, SizeType length)
     {
-        current_name.assign(str, sz);
-        auto it = internals.find(current_name);
-        if (it == internals.end())
-        {
-            current = nullptr;
-            if ((flags & Flags::DisallowUnknownKey))
-            {
-                the_error.reset(new error::UnknownFieldError(str, sz));
-                return false;
-            }
-        }
-        else if (it->second.flags & Flags::IgnoreRead)
-        {
-            current = nullptr;
-        }
-        else
-        {
-            current = &it->second;
-        }
-        return true;
+        std::uint64_t offset = m_text.size();
+        m_text.append(data, length);
+        return record(kind, offset, length);
     }
-    else
+
+    bool EventRecorder::Null() { return record(NULL_EVENT); }
+
+    bool EventRecorder::Bool(bool b) { return record(BOOL_EVENT, b); }
+
+    bool EventRecorder::Int(int i) { return record(INT_EVENT, static_cast<std::int64_t>(i)); }
+
+    bool EventRecorder::Uint(unsigned i) { return record(UINT_EVENT, i); }
+
+    bool EventRecorder::Int64(std::int64_t i) { return record(INT64_EVENT, i); }
+
+    bool EventRecorder::Uint64(std::uint64_t i) { return record(UINT64_EVENT, i); }
+
+    bool EventRecorder::Double(double d)
     {
-        return POSTCHECK(current->handler->Key(str, sz, copy));
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        return record(DOUBLE_EVENT, bits);
     }
-}
 
-bool ObjectHandler::StartObject()
-{
-    ++depth;
-    if (depth > 1)
+    bool EventRecorder::String(const char* str, SizeType length, bool)
     {
-        return POSTCHECK(current->handler->StartObject());
+        return record_text(STRING_EVENT, str, length);
     }
-    return true;
-}
 
-bool ObjectHandler::EndObject(SizeType sz)
-{
-    --depth;
-    if (depth > 0)
+    bool EventRecorder::RawNumber(const char* str, SizeType length, bool)
     {
-        return POSTCHECK(current->handler->EndObject(sz));
+        return record_text(RAW_NUMBER_EVENT, str, length);
     }
-    for (auto&& pair : internals)
+
+    bool EventRecorder::Binary(const std::uint8_t* data, SizeType length)
     {
-        if (pair.second.handler && !(pair.second.flags & Flags::Optional)
-            && !pair.second.handler->is_parsed())
+        return record_text(BINARY_EVENT, reinterpret_cast<const char*>(data), length);
+    }
+
+    bool EventRecorder::StartObject() { return record(START_OBJECT_EVENT); }
+
+    bool EventRecorder::Key(const char* str, SizeType length, bool)
+    {
+        return record_text(KEY_EVENT, str, length);
+    }
+
+    bool EventRecorder::EndObject(SizeType length) { return record(END_OBJECT_EVENT, 0, length); }
+
+    bool EventRecorder::StartArray() { return record(START_ARRAY_EVENT); }
+
+    bool EventRecorder::EndArray(SizeType length) { return record(END_ARRAY_EVENT, 0, length); }
+
+    bool EventRecorder::replay(IHandler* output) const
+    {
+        for (const Event& e : m_events)
         {
-            set_missing_required(pair.first);
+            const char* text = m_text.data() + e.payload;
+            bool success = false;
+            switch (e.kind)
+            {
+            case NULL_EVENT:
+                success = output->Null();
+                break;
+            case BOOL_EVENT:
+                success = output->Bool(e.payload != 0);
+                break;
+            case INT_EVENT:
+                success = output->Int(static_cast<int>(static_cast<std::int64_t>(e.payload)));
+                break;
+            case UINT_EVENT:
+                success = output->Uint(static_cast<unsigned>(e.payload));
+                break;
+            case INT64_EVENT:
+                success = output->Int64(static_cast<std::int64_t>(e.payload));
+                break;
+            case UINT64_EVENT:
+                success = output->Uint64(e.payload);
+                break;
+            case DOUBLE_EVENT:
+            {
+                double d;
+                std::memcpy(&d, &e.payload, sizeof(d));
+                success = output->Double(d);
+                break;
+            }
+            case STRING_EVENT:
+                success = output->String(text, e.length, true);
+                break;
+            case RAW_NUMBER_EVENT:
+                success = output->RawNumber(text, e.length, true);
+                break;
+            case BINARY_EVENT:
+                success = output->Binary(reinterpret_cast<const std::uint8_t*>(text), e.length);
+                break;
+            case KEY_EVENT:
+                success = output->Key(text, e.length, true);
+                break;
+            case START_OBJECT_EVENT:
+                success = output->StartObject();
+                break;
+            case END_OBJECT_EVENT:
+                success = output->EndObject(e.length);
+                break;
+            case START_ARRAY_EVENT:
+                success = output->StartArray();
+                break;
+            case END_ARRAY_EVENT:
+                success = output->EndArray(e.length);
+                break;
+            }
+            if (!success)
+                return false;
         }
+        return true;
     }
-    if (!the_error)
+
+    void EventRecorder::prepare_for_reuse()
     {
-        this->parsed = true;
-        return true;
+        m_events.clear();
+        m_text.clear();
     }
-    return false;
-}
 
-void ObjectHandler::reset()
-{
-    current = nullptr;
-    current_name.clear();
-    depth = 0;
-    for (auto&& pair : internals)
+    bool TaggedObjectWriter::write_tag()
     {
-        if (pair.second.handler)
-            pair.second.handler->prepare_for_reuse();
+        return m_output->Key(m_key, static_cast<SizeType>(std::strlen(m_key)), true)
+            && m_output->String(m_tag, static_cast<SizeType>(std::strlen(m_tag)), true);
     }
-}
 
-void ObjectHandler::add_handler(std::string&& name, ObjectHandler::FlaggedHandler&& fh)
+    bool TaggedObjectWriter::Null() { return m_output->Null(); }
+
+    bool TaggedObjectWriter::Bool(bool b) { return m_output->Bool(b); }
+
+    bool TaggedObjectWriter::Int(int i) { return m_output->Int(i); }
+
+    bool TaggedObjectWriter::Uint(unsigned i) { return m_output->Uint(i); }
+
+    bool TaggedObjectWriter::Int64(std::int64_t i) { return m_output->Int64(i); }
+
+    bool TaggedObjectWriter::Uint64(std::uint64_t i) { return m_output->Uint64(i); }
+
+    bool TaggedObjectWriter::Double(double d) { return m_output->Double(d); }
+
+    bool TaggedObjectWriter::String(const char* str, SizeType length, bool copy)
+    {
+        return m_output->String(str, length, copy);
+    }
+
+    bool TaggedObjectWriter::RawNumber(const char* str, SizeType length, bool copy)
+    {
+        return m_output->RawNumber(str, length, copy);
+    }
+
+    bool TaggedObjectWriter::Binary(const std::uint8_t* data, SizeType length)
+    {
+        return m_output->Binary(data, length);
+    }
+
+    bool TaggedObjectWriter::StartObject()
+    {
+        if (depth++ > 0)
+            return m_output->StartObject();
+        return m_output->StartObject() && write_tag();
+    }
+
+    bool TaggedObjectWriter::StartSizedObject(SizeType length)
+    {
+        if (depth++ > 0)
+            return m_output->StartSizedObject(length);
+        return m_output->StartSizedObject(length + 1) && write_tag();
+    }
+
+    bool TaggedObjectWriter::Key(const char* str, SizeType length, bool copy)
+    {
+        return m_output->Key(str, length, copy);
+    }
+
+    bool TaggedObjectWriter::EndObject(SizeType length)
+    {
+        return m_output->EndObject(--depth > 0 ? length : length + 1);
+    }
+
+    bool TaggedObjectWriter::StartArray()
+    {
+        ++depth;
+        return m_output->StartArray();
+    }
+
+    bool TaggedObjectWriter::StartSizedArray(SizeType length)
+    {
+        ++depth;
+        return m_output->StartSizedArray(length);
+    }
+
+    bool TaggedObjectWriter::EndArray(SizeType length)
+    {
+        --depth;
+        return m_output->EndArray(length);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const int* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const unsigned* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const std::int64_t* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const std::uint64_t* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const float* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+
+    bool TaggedObjectWriter::NumberArray(const double* data, SizeType size)
+    {
+        return m_output->NumberArray(data, size);
+    }
+}
+
+DiscriminatedHandler::DiscriminatedHandler(std::string key) : m_key(std::move(key)) {}
+
+bool DiscriminatedHandler::fail(ErrorBase* error, bool about_name)
 {
-    internals.emplace(std::move(name), std::move(fh));
+    the_error.reset(error);
+    name_error = about_name;
+    return false;
 }
 
-bool ObjectHandler::reap_error(ErrorStack& stack)
+bool DiscriminatedHandler::begin_object(const char* name, SizeType length)
 {
-    if (!the_error)
+    at_name = false;
+    active = select(name, length);
+    if (!active)
+        return fail(new error::InvalidEnumError(std::string(name, length)), true);
+    named = true;
+    if (!active->StartObject())
         return false;
-    stack.push(the_error.release());
-    if (current && current->handler)
-        current->handler->reap_error(stack);
-    return true;
+    bool success = recorder.replay(active);
+    recorder.prepare_for_reuse();
+    return success;
 }
 
-bool ObjectHandler::write(IHandler* output) const
+IHandler* DiscriminatedHandler::target(const char* type)
 {
-    SizeType count = 0;
-    if (!output->StartObject())
+    if (depth == 0)
+    {
+        fail(new error::TypeMismatchError(type_name(), type), false);
+        return nullptr;
+    }
+    if (at_name)
+    {
+        fail(new error::TypeMismatchError("string", type), true);
+        return nullptr;
+    }
+    if (active)
+        return active;
+    return &recorder;
+}
+
+void DiscriminatedHandler::reset()
+{
+    active = nullptr;
+    recorder.prepare_for_reuse();
+    depth = 0;
+    at_name = named = name_error = false;
+}
+
+bool DiscriminatedHandler::Null()
+{
+    IHandler* h = target("null");
+    return h && h->Null();
+}
+
+bool DiscriminatedHandler::Bool(bool b)
+{
+    IHandler* h = target("bool");
+    return h && h->Bool(b);
+}
+
+bool DiscriminatedHandler::Int(int i)
+{
+    IHandler* h = target("int");
+    return h && h->Int(i);
+}
+
+bool DiscriminatedHandler::Uint(unsigned i)
+{
+    IHandler* h = target("unsigned");
+    return h && h->Uint(i);
+}
+
+bool DiscriminatedHandler::Int64(std::int64_t i)
+{
+    IHandler* h = target("int64_t");
+    return h && h->Int64(i);
+}
+
+bool DiscriminatedHandler::Uint64(std::uint64_t i)
+{
+    IHandler* h = target("uint64_t");
+    return h && h->Uint64(i);
+}
+
+bool DiscriminatedHandler::Double(double d)
+{
+    IHandler* h = target("double");
+    return h && h->Double(d);
+}
+
+bool DiscriminatedHandler::String(const char* str, SizeType length, bool copy)
+{
+    if (depth == 1 && at_name)
+        return begin_object(str, length);
+    IHandler* h = target("string");
+    return h && h->String(str, length, copy);
+}
+
+bool DiscriminatedHandler::RawNumber(const char* str, SizeType length, bool copy)
+{
+    IHandler* h = target("number");
+    return h && h->RawNumber(str, length, copy);
+}
+
+bool DiscriminatedHandler::Binary(const std::uint8_t* data, SizeType length)
+{
+    IHandler* h = target("binary");
+    return h && h->Binary(data, length);
+}
+
+bool DiscriminatedHandler::StartObject()
+{
+    if (depth == 0)
+    {
+        depth = 1;
+        return true;
+    }
+    IHandler* h = target("object");
+    ++depth;
+    return h && h->StartObject();
+}
+
+bool DiscriminatedHandler::Key(const char* str, SizeType length, bool copy)
+{
+    if (depth == 1 && m_key.size() == length && std::memcmp(m_key.data(), str, length) == 0)
+    {
+        if (named)
+            return fail(new error::DuplicateKeyError(m_key), false);
+        at_name = true;
+        return true;
+    }
+    IHandler* h = target("object");
+    return h && h->Key(str, length, copy);
+}
+
+bool DiscriminatedHandler::EndObject(SizeType length)
+{
+    if (--depth > 0)
+    {
+        IHandler* h = target("object");
+        return h && h->EndObject(length);
+    }
+    if (!named)
+    {
+        error::RequiredFieldMissingError* error = new error::RequiredFieldMissingError();
+        error->missing_members().push_back(m_key);
+        return fail(error, false);
+    }
+    if (!active->EndObject(length > 0 ? length - 1 : 0))
         return false;
+    this->parsed = active->is_parsed();
+    return true;
+}
 
-    for (auto&& pair : internals)
+bool DiscriminatedHandler::StartArray()
+{
+    IHandler* h = target("array");
+    ++depth;
+    return h && h->StartArray();
+}
+
+bool DiscriminatedHandler::EndArray(SizeType length)
+{
+    --depth;
+    IHandler* h = target("array");
+    return h && h->EndArray(length);
+}
+
+bool DiscriminatedHandler::has_error() const
+{
+    return BaseHandler::has_error() || (active && active->has_error());
+}
+
+bool DiscriminatedHandler::reap_error(ErrorStack& stk)
+{
+    if (the_error)
     {
-        if (!pair.second.handler || (pair.second.flags & Flags::IgnoreWrite))
-            continue;
-        if (!output->Key(
-                pair.first.data(), static_cast<staticjson::SizeType>(pair.first.size()), true))
-            return false;
-        if (!pair.second.handler->write(output))
-            return false;
-        ++count;
+        if (name_error)
+            stk.push(new error::ObjectMemberError(m_key));
+        stk.push(the_error.release());
+        return true;
     }
-    return output->EndObject(count);
+    return active && active->reap_error(stk);
 }
 
-void ObjectHandler::generate_schema(Value& output, MemoryPoolAllocator& alloc) const
+namespace nonpublic
 {
-    output.SetObject();
-    output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+    void add_discriminator_schema(Value& schema,
+                                  const char* key,
+                                  const char* name,
+                                  MemoryPoolAllocator& alloc)
+    {
+        if (!schema.IsObject() || !schema.HasMember("properties"))
+            return;
+        Value names(rapidjson::kArrayType);
+        names.PushBack(Value(name, alloc), alloc);
+        Value descriptor(rapidjson::kObjectType);
+        descriptor.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("string"), alloc);
+        descriptor.AddMember(rapidjson::StringRef("enum"), names, alloc);
+        schema["properties"].AddMember(Value(key, alloc), descriptor, alloc);
+        if (!schema.HasMember("required"))
+            schema.AddMember(rapidjson::StringRef("required"), Value(rapidjson::kArrayType), alloc);
+        schema["required"].PushBack(Value(key, alloc), alloc);
+    }
+}
 
-    Value properties(rapidjson::kObjectType);
-    Value required(rapidjson::kArrayType);
-    for (auto&& pair : internals)
+ObjectHandler::ObjectHandler() {}
+
+ObjectHandler::~ObjectHandler() {}
+
+std::string ObjectHandler::type_name() const { return "object"; }
+
+bool ObjectHandler::precheck(const char* actual_type)
+{
+    if (depth <= 0)
     {
-        Value schema;
-        if (pair.second.handler)
-            pair.second.handler->generate_schema(schema, alloc);
+        the_error.reset(new error::TypeMismatchError(type_name(), actual_type));
+        return false;
+    }
+    if (current && current->handler && current->handler->is_parsed())
+    {
+        if (flags & Flags::AllowDuplicateKey)
+        {
+            current->handler->prepare_for_reuse();
+        }
         else
-            std::abort();
-        Value key;
-        key.SetString(pair.first.c_str(), static_cast<SizeType>(pair.first.size()), alloc);
-        properties.AddMember(key, schema, alloc);
-        if (!(pair.second.flags & Flags::Optional))
         {
-            key.SetString(pair.first.c_str(), static_cast<SizeType>(pair.first.size()), alloc);
-            required.PushBack(key, alloc);
+            the_error.reset(new error::DuplicateKeyError(current_name));
+            return false;
         }
     }
-    output.AddMember(rapidjson::StringRef("properties"), properties, alloc);
-    if (!required.Empty())
+    return true;
+}
+
+bool ObjectHandler::postcheck(bool success)
+{
+    if (!success)
     {
-        output.AddMember(rapidjson::StringRef("required"), required, alloc);
+        the_error.reset(new error::ObjectMemberError(current_name));
     }
-    output.AddMember(rapidjson::StringRef("additionalProperties"),
-                     !(get_flags() & Flags::DisallowUnknownKey),
-                     alloc);
+    return success;
 }
 
-namespace nonpublic
+void ObjectHandler::set_missing_required(const std::string& name)
 {
-    template <class T>
-    class IHandlerAdapter : public IHandler
-    {
-    private:
-        T* t;
+    if (!the_error || the_error->type() != error::MISSING_REQUIRED)
+        the_error.reset(new error::RequiredFieldMissingError());
+
+    std::vector<std::string>& missing
+        = static_cast<error::RequiredFieldMissingError*>(the_error.get())->missing_members();
+
+    missing.push_back(name);
+}
+
+#define POSTCHECK(x) (!current || !(current->handler) || postcheck(x))
+
+bool ObjectHandler::Double(double value)
+{
+    if (!precheck("double"))
+        return false;
+    return POSTCHECK(current->handler->Double(value));
+}
+
+bool ObjectHandler::Int(int value)
+{
+    if (!precheck("int"))
+        return false;
+    return POSTCHECK(current->handler->Int(value));
+}
+
+bool ObjectHandler::Uint(unsigned value)
+{
+    if (!precheck("unsigned"))
+        return false;
+    return POSTCHECK(current->handler->Uint(value));
+}
+
+bool ObjectHandler::Bool(bool value)
+{
+    if (!precheck("bool"))
+        return false;
+    return POSTCHECK(current->handler->Bool(value));
+}
+
+bool ObjectHandler::Int64(std::int64_t value)
+{
+    if (!precheck("std::int64_t"))
+        return false;
+    return POSTCHECK(current->handler->Int64(value));
+}
+
+bool ObjectHandler::Uint64(std::uint64_t value)
+{
+    if (!precheck("std::uint64_t"))
+        return false;
+    return POSTCHECK(current->handler->Uint64(value));
+}
+
+bool ObjectHandler::Null()
+{
+    if (!precheck("null"))
+        return false;
+    return POSTCHECK(current->handler->Null());
+}
+
+bool ObjectHandler::StartArray()
+{
+    if (!precheck("array"))
+        return false;
+    return POSTCHECK(current->handler->StartArray());
+}
+
+bool ObjectHandler::EndArray(SizeType sz)
+{
+    if (!precheck("array"))
+        return false;
+    return POSTCHECK(current->handler->EndArray(sz));
+}
+
+bool ObjectHandler::String(const char* str, SizeType sz, bool copy)
+{
+    if (!precheck("string"))
+        return false;
+    return POSTCHECK(current->handler->String(str, sz, copy));
+}
+
+bool ObjectHandler::Binary(const std::uint8_t* data, SizeType sz)
+{
+    if (!precheck("binary"))
+        return false;
+    return POSTCHECK(current->handler->Binary(data, sz));
+}
+
+bool ObjectHandler::RawNumber(const char* str, SizeType sz, bool copy)
+{
+    if (!precheck("number"))
+        return false;
+    return POSTCHECK(current->handler->RawNumber(str, sz, copy));
+}
+
+namespace nonpublic
+{
+    thread_local AllocationBudget* active_budget = nullptr;
+
+    bool exceed_allocation_budget(std::unique_ptr<ErrorBase>& error)
+    {
+        error.reset(new error::LimitExceededError("max_allocation", active_budget->limit));
+        return false;
+    }
+
+    thread_local ParseStatistics* active_statistics = nullptr;
+}
+
+bool ObjectHandler::Key(const char* str, SizeType sz, bool copy)
+{
+    if (depth <= 0)
+    {
+        the_error.reset(new error::CorruptedDOMError());
+        return false;
+    }
+    if (depth == 1)
+    {
+        current_name.assign(str, sz);
+        auto it = internals.find(current_name);
+        if (it == internals.end())
+        {
+            current = nullptr;
+            nonpublic::count_unknown_key();
+            if ((flags & Flags::DisallowUnknownKey))
+            {
+                the_error.reset(new error::UnknownFieldError(str, sz));
+                return false;
+            }
+        }
+        else if (it->second.flags & Flags::IgnoreRead)
+        {
+            current = nullptr;
+        }
+        else
+        {
+            current = &it->second;
+        }
+        return true;
+    }
+    else
+    {
+        return POSTCHECK(current->handler->Key(str, sz, copy));
+    }
+}
+
+bool ObjectHandler::StartObject()
+{
+    ++depth;
+    if (depth > 1)
+    {
+        return POSTCHECK(current->handler->StartObject());
+    }
+    return true;
+}
+
+bool ObjectHandler::EndObject(SizeType sz)
+{
+    --depth;
+    if (depth > 0)
+    {
+        return POSTCHECK(current->handler->EndObject(sz));
+    }
+    for (auto&& pair : internals)
+    {
+        if (pair.second.handler && !(pair.second.flags & Flags::Optional)
+            && !pair.second.handler->is_parsed())
+        {
+            set_missing_required(pair.first);
+        }
+    }
+    if (!the_error)
+    {
+        this->parsed = true;
+        return true;
+    }
+    return false;
+}
+
+void ObjectHandler::reset()
+{
+    current = nullptr;
+    current_name.clear();
+    depth = 0;
+    for (auto&& pair : internals)
+    {
+        if (pair.second.handler)
+            pair.second.handler->prepare_for_reuse();
+    }
+}
+
+void ObjectHandler::add_handler(std::string&& name, ObjectHandler::FlaggedHandler&& fh)
+{
+    internals.emplace(std::move(name), std::move(fh));
+}
+
+bool ObjectHandler::reap_error(ErrorStack& stack)
+{
+    if (!the_error)
+        return false;
+    stack.push(the_error.release());
+    if (current && current->handler)
+        current->handler->reap_error(stack);
+    return true;
+}
+
+bool ObjectHandler::write(IHandler* output) const
+{
+    const unsigned skipped = output->writes_ignored_members() ? 0 : Flags::IgnoreWrite;
+    SizeType count = 0;
+    for (auto&& pair : internals)
+    {
+        if (pair.second.handler && !(pair.second.flags & skipped))
+            ++count;
+    }
+    if (!output->StartSizedObject(count))
+        return false;
+    count = 0;
+
+    for (auto&& pair : internals)
+    {
+        if (!pair.second.handler || (pair.second.flags & skipped))
+            continue;
+        if (!output->Key(
+                pair.first.data(), static_cast<staticjson::SizeType>(pair.first.size()), true))
+            return false;
+        if (!pair.second.handler->write(output))
+            return false;
+        ++count;
+    }
+    return output->EndObject(count);
+}
+
+void ObjectHandler::accumulate_footprint(HandlerFootprint* footprint) const
+{
+    ++footprint->handlers;
+    ++footprint->maps;
+    footprint->map_entries += internals.size();
+    for (auto&& pair : internals)
+    {
+        // Estimated: besides the value, a tree node typically holds three links and a color
+        footprint->bytes += sizeof(pair) + 4 * sizeof(void*);
+        const char* key = pair.first.data();
+        bool is_inline = key >= reinterpret_cast<const char*>(&pair.first)
+            && key < reinterpret_cast<const char*>(&pair.first + 1);
+        if (!is_inline)
+            footprint->bytes += pair.first.capacity() + 1;
+        if (pair.second.handler)
+        {
+            footprint->bytes += pair.second.size;
+            pair.second.handler->accumulate_footprint(footprint);
+        }
+    }
+}
+
+void ObjectHandler::generate_schema(Value& output, MemoryPoolAllocator& alloc) const
+{
+    output.SetObject();
+    output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+
+    Value properties(rapidjson::kObjectType);
+    Value required(rapidjson::kArrayType);
+    for (auto&& pair : internals)
+    {
+        Value schema;
+        if (pair.second.handler)
+            pair.second.handler->generate_schema(schema, alloc);
+        else
+            std::abort();
+        Value key;
+        key.SetString(pair.first.c_str(), static_cast<SizeType>(pair.first.size()), alloc);
+        properties.AddMember(key, schema, alloc);
+        if (!(pair.second.flags & Flags::Optional))
+        {
+            key.SetString(pair.first.c_str(), static_cast<SizeType>(pair.first.size()), alloc);
+            required.PushBack(key, alloc);
+        }
+    }
+    output.AddMember(rapidjson::StringRef("properties"), properties, alloc);
+    if (!required.Empty())
+    {
+        output.AddMember(rapidjson::StringRef("required"), required, alloc);
+    }
+    output.AddMember(rapidjson::StringRef("additionalProperties"),
+                     !(get_flags() & Flags::DisallowUnknownKey),
+                     alloc);
+}
+
+TableHandler::TableHandler(const TypeTable& table, void* value) : m_table(&table), m_value(value)
+{
+}
+
+TableHandler::~TableHandler()
+{
+    if (custom)
+        destroy_custom();
+}
+
+std::string TableHandler::type_name() const { return "object"; }
+
+bool TableHandler::fail(ErrorBase* error, std::size_t enclosing)
+{
+    the_error.reset(error);
+    error_frames = enclosing;
+    return false;
+}
+
+bool TableHandler::fail_value(BaseHandler& h)
+{
+    h.reap_error(leaf);
+    error_frames = frames.size();
+    return false;
+}
+
+void TableHandler::push_object(const TypeTable& table, void* base)
+{
+    Frame f = {&table, nullptr, base, nullptr, seen.size()};
+    frames.push_back(f);
+    seen.resize(seen.size() + table.size, 0);
+}
+
+// Finds where the value starting with an event of `type` goes. `*value` is left null when the
+// value belongs to a member that is skipped.
+bool TableHandler::begin_value(const char* type, const TableType** value_type, void** value)
+{
+    if (frames.empty())
+        return fail(new error::TypeMismatchError(type_name(), type), 0);
+    Frame& f = frames.back();
+    if (f.table)
+    {
+        if (f.field)
+        {
+            if (seen[f.seen + (f.field - f.table->fields)]
+                && !(f.table->flags & Flags::AllowDuplicateKey))
+                return fail(new error::DuplicateKeyError(f.field->name), frames.size() - 1);
+            *value_type = &f.field->type;
+            *value = static_cast<char*>(f.base) + f.field->offset;
+        }
+        return true;
+    }
+    if (!nonpublic::charge_allocation(f.sequence->element_size, the_error))
+    {
+        error_frames = frames.size() - 1;
+        return false;
+    }
+    *value_type = &f.sequence->element;
+    *value = f.sequence->append(f.base);
+    return true;
+}
+
+void TableHandler::finish_value()
+{
+    if (frames.empty())
+    {
+        this->parsed = true;
+        return;
+    }
+    Frame& f = frames.back();
+    if (f.table && f.field)
+        seen[f.seen + (f.field - f.table->fields)] = 1;
+}
+
+namespace nonpublic
+{
+    void destroy_table_handler(BaseHandler* h, const void* storage)
+    {
+        if (h == storage)
+            h->~BaseHandler();
+        else
+            delete h;
+    }
+}
+
+void TableHandler::destroy_custom()
+{
+    nonpublic::destroy_table_handler(custom, custom_storage);
+    custom = nullptr;
+}
+
+bool TableHandler::forward(bool success)
+{
+    if (!success)
+    {
+        fail_value(*custom);
+        destroy_custom();
+        return false;
+    }
+    if (custom_depth > 0)
+        return true;
+    bool complete = custom->is_parsed();
+    destroy_custom();
+    if (complete)
+        finish_value();
+    return true;
+}
+
+template <class T, class Event>
+bool TableHandler::store(void* value, Event& event)
+{
+    Handler<T> h(static_cast<T*>(value));
+    if (!event(h))
+        return fail_value(h);
+    finish_value();
+    return true;
+}
+
+// Hands an event starting a value of any kind but `Object` and `Sequence` to a handler of the
+// value. Scalars are parsed by a handler on the stack, so they follow the same rules as in
+// `ObjectHandler`.
+template <class Event>
+bool TableHandler::deliver(const TableType& value_type,
+                           void* value,
+                           const char* type,
+                           Event& event)
+{
+    switch (value_type.kind)
+    {
+    case TableKind::Bool:
+        return store<bool>(value, event);
+    case TableKind::Int:
+        return store<int>(value, event);
+    case TableKind::Unsigned:
+        return store<unsigned>(value, event);
+    case TableKind::Int64:
+        return store<std::int64_t>(value, event);
+    case TableKind::Uint64:
+        return store<std::uint64_t>(value, event);
+    case TableKind::Float:
+        return store<float>(value, event);
+    case TableKind::Double:
+        return store<double>(value, event);
+    case TableKind::String:
+        return store<std::string>(value, event);
+    case TableKind::Object:
+        return fail(new error::TypeMismatchError("object", type), frames.size());
+    case TableKind::Sequence:
+        return fail(new error::TypeMismatchError("array", type), frames.size());
+    case TableKind::Custom:
+        break;
+    }
+    custom = value_type.make_handler(value, custom_storage, sizeof(custom_storage));
+    return forward(event(*custom));
+}
+
+template <class Event>
+bool TableHandler::scalar(const char* type, Event event)
+{
+    if (custom)
+        return forward(event(*custom));
+    if (skip_depth > 0)
+        return true;
+    const TableType* value_type = nullptr;
+    void* value = nullptr;
+    if (!begin_value(type, &value_type, &value))
+        return false;
+    if (!value)
+        return true;
+    return deliver(*value_type, value, type, event);
+}
+
+bool TableHandler::Null()
+{
+    return scalar("null", [](BaseHandler& h) { return h.Null(); });
+}
+
+bool TableHandler::Bool(bool b)
+{
+    return scalar("bool", [=](BaseHandler& h) { return h.Bool(b); });
+}
+
+bool TableHandler::Int(int i)
+{
+    return scalar("int", [=](BaseHandler& h) { return h.Int(i); });
+}
+
+bool TableHandler::Uint(unsigned i)
+{
+    return scalar("unsigned", [=](BaseHandler& h) { return h.Uint(i); });
+}
+
+bool TableHandler::Int64(std::int64_t i)
+{
+    return scalar("std::int64_t", [=](BaseHandler& h) { return h.Int64(i); });
+}
+
+bool TableHandler::Uint64(std::uint64_t i)
+{
+    return scalar("std::uint64_t", [=](BaseHandler& h) { return h.Uint64(i); });
+}
+
+bool TableHandler::Double(double d)
+{
+    return scalar("double", [=](BaseHandler& h) { return h.Double(d); });
+}
+
+bool TableHandler::String(const char* str, SizeType length, bool copy)
+{
+    return scalar("string", [=](BaseHandler& h) { return h.String(str, length, copy); });
+}
+
+bool TableHandler::RawNumber(const char* str, SizeType length, bool copy)
+{
+    return scalar("number", [=](BaseHandler& h) { return h.RawNumber(str, length, copy); });
+}
+
+bool TableHandler::Binary(const std::uint8_t* data, SizeType length)
+{
+    return scalar("binary", [=](BaseHandler& h) { return h.Binary(data, length); });
+}
+
+bool TableHandler::StartObject()
+{
+    if (custom)
+    {
+        ++custom_depth;
+        return forward(custom->StartObject());
+    }
+    if (skip_depth > 0)
+    {
+        ++skip_depth;
+        return true;
+    }
+    if (frames.empty())
+    {
+        push_object(*m_table, m_value);
+        return true;
+    }
+    const TableType* value_type = nullptr;
+    void* value = nullptr;
+    if (!begin_value("object", &value_type, &value))
+        return false;
+    if (!value)
+    {
+        skip_depth = 1;
+        return true;
+    }
+    if (value_type->kind == TableKind::Object)
+    {
+        push_object(value_type->table(), value);
+        return true;
+    }
+    custom_depth = 1;
+    auto event = [](BaseHandler& h) { return h.StartObject(); };
+    return deliver(*value_type, value, "object", event);
+}
+
+bool TableHandler::Key(const char* str, SizeType length, bool copy)
+{
+    if (custom)
+        return forward(custom->Key(str, length, copy));
+    if (skip_depth > 0)
+        return true;
+    if (frames.empty() || !frames.back().table)
+        return fail(new error::CorruptedDOMError(), frames.size());
+
+    Frame& f = frames.back();
+    const TypeTable& table = *f.table;
+
+    // Members mostly come in the order of the table, so the search starts after the last one
+    std::size_t start = f.field ? static_cast<std::size_t>(f.field - table.fields) + 1 : 0;
+    const TableField* field = nullptr;
+    for (std::size_t n = 0; n < table.size; ++n)
+    {
+        std::size_t i = start + n < table.size ? start + n : start + n - table.size;
+        const TableField& candidate = table.fields[i];
+        if (candidate.length == length && std::memcmp(candidate.name, str, length) == 0)
+        {
+            field = &candidate;
+            break;
+        }
+    }
+
+    if (!field)
+    {
+        nonpublic::count_unknown_key();
+        if (table.flags & Flags::DisallowUnknownKey)
+            return fail(new error::UnknownFieldError(str, length), frames.size() - 1);
+    }
+    else if (field->flags & Flags::IgnoreRead)
+    {
+        field = nullptr;
+    }
+    f.field = field;
+    return true;
+}
+
+bool TableHandler::EndObject(SizeType length)
+{
+    if (custom)
+    {
+        --custom_depth;
+        return forward(custom->EndObject(length));
+    }
+    if (skip_depth > 0)
+    {
+        --skip_depth;
+        return true;
+    }
+
+    Frame& f = frames.back();
+    for (std::size_t i = 0; i < f.table->size; ++i)
+    {
+        const TableField& field = f.table->fields[i];
+        if (!(field.flags & Flags::Optional) && !seen[f.seen + i])
+        {
+            if (!the_error)
+                the_error.reset(new error::RequiredFieldMissingError());
+            static_cast<error::RequiredFieldMissingError*>(the_error.get())
+                ->missing_members()
+                .push_back(field.name);
+        }
+    }
+    if (the_error)
+    {
+        error_frames = frames.size() - 1;
+        return false;
+    }
+    seen.resize(f.seen);
+    frames.pop_back();
+    finish_value();
+    return true;
+}
+
+bool TableHandler::StartArray()
+{
+    if (custom)
+    {
+        ++custom_depth;
+        return forward(custom->StartArray());
+    }
+    if (skip_depth > 0)
+    {
+        ++skip_depth;
+        return true;
+    }
+    const TableType* value_type = nullptr;
+    void* value = nullptr;
+    if (!begin_value("array", &value_type, &value))
+        return false;
+    if (!value)
+    {
+        skip_depth = 1;
+        return true;
+    }
+    if (value_type->kind == TableKind::Sequence)
+    {
+        Frame f = {nullptr, value_type->sequence, value, nullptr, 0};
+        frames.push_back(f);
+        return true;
+    }
+    custom_depth = 1;
+    auto event = [](BaseHandler& h) { return h.StartArray(); };
+    return deliver(*value_type, value, "array", event);
+}
+
+bool TableHandler::EndArray(SizeType length)
+{
+    if (custom)
+    {
+        --custom_depth;
+        return forward(custom->EndArray(length));
+    }
+    if (skip_depth > 0)
+    {
+        --skip_depth;
+        return true;
+    }
+    frames.pop_back();
+    finish_value();
+    return true;
+}
+
+bool TableHandler::has_error() const { return BaseHandler::has_error() || !leaf.empty(); }
+
+bool TableHandler::reap_error(ErrorStack& stk)
+{
+    if (!has_error())
+        return false;
+    for (std::size_t i = 0; i < error_frames; ++i)
+    {
+        const Frame& f = frames[i];
+        if (f.table)
+            stk.push(new error::ObjectMemberError(f.field->name));
+        else
+            stk.push(new error::ArrayElementError(f.sequence->size(f.base) - 1));
+    }
+    if (the_error)
+        stk.push(the_error.release());
+
+    // Moved over in the order they have in `leaf`
+    std::vector<ErrorBase*> errors;
+    while (ErrorBase* e = leaf.pop())
+        errors.push_back(e);
+    for (auto it = errors.rbegin(); it != errors.rend(); ++it)
+        stk.push(*it);
+    return true;
+}
+
+void TableHandler::reset()
+{
+    frames.clear();
+    seen.clear();
+    skip_depth = 0;
+    custom_depth = 0;
+    if (custom)
+        destroy_custom();
+    ErrorStack empty;
+    leaf.swap(empty);
+    error_frames = 0;
+}
+
+namespace nonpublic
+{
+    static bool write_table(IHandler* output, const TypeTable& table, const void* base);
+
+    template <class T>
+    static bool write_table_numbers(IHandler* output, const TableSequence& s, const void* sequence)
+    {
+        return write_elements(
+            output, static_cast<T*>(s.at(sequence, 0)), static_cast<SizeType>(s.size(sequence)));
+    }
+
+    static bool write_table_value(IHandler* output, const TableType& type, const void* value)
+    {
+        switch (type.kind)
+        {
+        case TableKind::Bool:
+            return output->Bool(*static_cast<const bool*>(value));
+        case TableKind::Int:
+            return output->Int(*static_cast<const int*>(value));
+        case TableKind::Unsigned:
+            return output->Uint(*static_cast<const unsigned*>(value));
+        case TableKind::Int64:
+            return output->Int64(*static_cast<const std::int64_t*>(value));
+        case TableKind::Uint64:
+            return output->Uint64(*static_cast<const std::uint64_t*>(value));
+        case TableKind::Float:
+            return output->Double(*static_cast<const float*>(value));
+        case TableKind::Double:
+            return output->Double(*static_cast<const double*>(value));
+        case TableKind::String:
+        {
+            auto str = static_cast<const std::string*>(value);
+            return output->String(str->data(), static_cast<SizeType>(str->size()), true);
+        }
+        case TableKind::Object:
+            return write_table(output, type.table(), value);
+        case TableKind::Sequence:
+            break;
+        case TableKind::Custom:
+        {
+            alignas(std::max_align_t) unsigned char storage[128];
+            BaseHandler* h = type.make_handler(const_cast<void*>(value), storage, sizeof(storage));
+            bool success = h->write(output);
+            destroy_table_handler(h, storage);
+            return success;
+        }
+        }
+
+        const TableSequence& s = *type.sequence;
+        switch (s.element.kind)
+        {
+        case TableKind::Int:
+            return write_table_numbers<int>(output, s, value);
+        case TableKind::Unsigned:
+            return write_table_numbers<unsigned>(output, s, value);
+        case TableKind::Int64:
+            return write_table_numbers<std::int64_t>(output, s, value);
+        case TableKind::Uint64:
+            return write_table_numbers<std::uint64_t>(output, s, value);
+        case TableKind::Float:
+            return write_table_numbers<float>(output, s, value);
+        case TableKind::Double:
+            return write_table_numbers<double>(output, s, value);
+        default:
+            break;
+        }
+        SizeType size = static_cast<SizeType>(s.size(value));
+        if (!output->StartSizedArray(size))
+            return false;
+        for (SizeType i = 0; i < size; ++i)
+        {
+            if (!write_table_value(output, s.element, s.at(value, i)))
+                return false;
+        }
+        return output->EndArray(size);
+    }
+
+    static bool write_table(IHandler* output, const TypeTable& table, const void* base)
+    {
+        const unsigned skipped = output->writes_ignored_members() ? 0 : Flags::IgnoreWrite;
+        SizeType count = 0;
+        for (std::size_t i = 0; i < table.size; ++i)
+        {
+            if (!(table.fields[i].flags & skipped))
+                ++count;
+        }
+        if (!output->StartSizedObject(count))
+            return false;
+        for (std::size_t i = 0; i < table.size; ++i)
+        {
+            const TableField& field = table.fields[i];
+            if (field.flags & skipped)
+                continue;
+            if (!output->Key(field.name, field.length, true)
+                || !write_table_value(
+                       output, field.type, static_cast<const char*>(base) + field.offset))
+                return false;
+        }
+        return output->EndObject(count);
+    }
+
+    template <class T>
+    static void table_scalar_schema(Value& output, MemoryPoolAllocator& alloc)
+    {
+        T value{};
+        Handler<T> h(&value);
+        h.generate_schema(output, alloc);
+    }
+
+    static void table_object_schema(Value& output, const TypeTable& table, MemoryPoolAllocator& alloc);
+
+    static void table_value_schema(Value& output, const TableType& type, MemoryPoolAllocator& alloc)
+    {
+        switch (type.kind)
+        {
+        case TableKind::Bool:
+            return table_scalar_schema<bool>(output, alloc);
+        case TableKind::Int:
+            return table_scalar_schema<int>(output, alloc);
+        case TableKind::Unsigned:
+            return table_scalar_schema<unsigned>(output, alloc);
+        case TableKind::Int64:
+            return table_scalar_schema<std::int64_t>(output, alloc);
+        case TableKind::Uint64:
+            return table_scalar_schema<std::uint64_t>(output, alloc);
+        case TableKind::Float:
+            return table_scalar_schema<float>(output, alloc);
+        case TableKind::Double:
+            return table_scalar_schema<double>(output, alloc);
+        case TableKind::String:
+            return table_scalar_schema<std::string>(output, alloc);
+        case TableKind::Object:
+            return table_object_schema(output, type.table(), alloc);
+        case TableKind::Sequence:
+        {
+            output.SetObject();
+            output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("array"), alloc);
+            Value items;
+            table_value_schema(items, type.sequence->element, alloc);
+            output.AddMember(rapidjson::StringRef("items"), items, alloc);
+            return;
+        }
+        case TableKind::Custom:
+            return type.schema(output, alloc);
+        }
+    }
+
+    static void table_object_schema(Value& output, const TypeTable& table, MemoryPoolAllocator& alloc)
+    {
+        output.SetObject();
+        output.AddMember(rapidjson::StringRef("type"), rapidjson::StringRef("object"), alloc);
+
+        Value properties(rapidjson::kObjectType);
+        Value required(rapidjson::kArrayType);
+        for (std::size_t i = 0; i < table.size; ++i)
+        {
+            const TableField& field = table.fields[i];
+            Value schema;
+            table_value_schema(schema, field.type, alloc);
+            Value key;
+            key.SetString(field.name, field.length, alloc);
+            properties.AddMember(key, schema, alloc);
+            if (!(field.flags & Flags::Optional))
+            {
+                key.SetString(field.name, field.length, alloc);
+                required.PushBack(key, alloc);
+            }
+        }
+        output.AddMember(rapidjson::StringRef("properties"), properties, alloc);
+        if (!required.Empty())
+        {
+            output.AddMember(rapidjson::StringRef("required"), required, alloc);
+        }
+        output.AddMember(rapidjson::StringRef("additionalProperties"),
+                         !(table.flags & Flags::DisallowUnknownKey),
+                         alloc);
+    }
+}
+
+bool TableHandler::write(IHandler* output) const
+{
+    return nonpublic::write_table(output, *m_table, m_value);
+}
+
+void TableHandler::generate_schema(Value& output, MemoryPoolAllocator& alloc) const
+{
+    nonpublic::table_object_schema(output, *m_table, alloc);
+}
+
+void TableHandler::accumulate_footprint(HandlerFootprint* footprint) const
+{
+    ++footprint->handlers;
+    footprint->bytes += frames.capacity() * sizeof(Frame) + seen.capacity();
+}
+
+namespace nonpublic
+{
+    // Formatting of whole arrays of numbers into one buffer, with the same digits rapidjson's
+    // writer produces for each value
+    static char* format_number(int v, char* p)
+    {
+        return rapidjson::internal::i32toa(v, p);
+    }
+
+    static char* format_number(unsigned v, char* p)
+    {
+        return rapidjson::internal::u32toa(v, p);
+    }
+
+    static char* format_number(std::int64_t v, char* p)
+    {
+        return rapidjson::internal::i64toa(v, p);
+    }
+
+    static char* format_number(std::uint64_t v, char* p)
+    {
+        return rapidjson::internal::u64toa(v, p);
+    }
+
+    static char* format_number(double v, char* p)
+    {
+        // The writer refuses NaN and infinity; the caller falls back to it to report them
+        if (!std::isfinite(v))
+            return nullptr;
+        return rapidjson::internal::dtoa(v, p);
+    }
+
+    template <class Number>
+    static bool format_number_array(const Number* data, SizeType size, std::string& out)
+    {
+        // Enough for the longest output of dtoa and i64toa, plus a separator
+        static const std::size_t max_width = 26;
+        out.resize(2 + std::size_t(size) * max_width);
+        char* begin = &out[0];
+        char* p = begin;
+        *p++ = '[';
+        for (SizeType i = 0; i < size; ++i)
+        {
+            if (i > 0)
+                *p++ = ',';
+            p = format_number(data[i], p);
+            if (!p)
+                return false;
+        }
+        *p++ = ']';
+        out.resize(static_cast<std::size_t>(p - begin));
+        return true;
+    }
+
+    // Only the compact writer can take a preformatted array; pretty printing lays out each
+    // element by itself
+    template <class T>
+    struct is_compact_writer : public std::false_type
+    {
+    };
+
+    template <class OutputStream, class SourceEncoding, class TargetEncoding, class Allocator,
+              unsigned writeFlags>
+    struct is_compact_writer<
+        rapidjson::Writer<OutputStream, SourceEncoding, TargetEncoding, Allocator, writeFlags>>
+        : public std::integral_constant<bool,
+                                        (writeFlags & rapidjson::kWriteNanAndInfFlag) == 0>
+    {
+    };
+
+    template <class T>
+    class IHandlerAdapter : public IHandler
+    {
+    private:
+        T* t;
+        std::string numbers;
+
+        template <class Number>
+        bool write_numbers(const Number* data, SizeType size, std::true_type)
+        {
+            if (!format_number_array(data, size, numbers))
+                return IHandler::NumberArray(data, size);
+            return t->RawValue(numbers.data(), numbers.size(), rapidjson::kArrayType);
+        }
+
+        template <class Number>
+        bool write_numbers(const Number* data, SizeType size, std::false_type)
+        {
+            return IHandler::NumberArray(data, size);
+        }
+
+        template <class Number>
+        bool write_numbers(const Number* data, SizeType size)
+        {
+            return write_numbers(data, size, is_compact_writer<T>());
+        }
+
+    public:
+        explicit IHandlerAdapter(T* t) : t(t) {}
+
+        virtual bool Null() override { return t->Null(); }
+
+        virtual bool Bool(bool v) override { return t->Bool(v); }
+
+        virtual bool Int(int v) override { return t->Int(v); }
+
+        virtual bool Uint(unsigned v) override { return t->Uint(v); }
+
+        virtual bool Int64(std::int64_t v) override { return t->Int64(v); }
+
+        virtual bool Uint64(std::uint64_t v) override { return t->Uint64(v); }
+
+        virtual bool Double(double v) override { return t->Double(v); }
+
+        virtual bool String(const char* str, SizeType sz, bool copy) override
+        {
+            return t->String(str, sz, copy);
+        }
+
+        virtual bool StartObject() override { return t->StartObject(); }
+
+        virtual bool Key(const char* str, SizeType sz, bool copy) override
+        {
+            return t->Key(str, sz, copy);
+        }
+
+        virtual bool EndObject(SizeType sz) override { return t->EndObject(sz); }
+
+        virtual bool StartArray() override { return t->StartArray(); }
+
+        virtual bool EndArray(SizeType sz) override { return t->EndArray(sz); }
+
+        virtual bool NumberArray(const int* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual bool NumberArray(const unsigned* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual bool NumberArray(const std::int64_t* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual bool NumberArray(const std::uint64_t* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual bool NumberArray(const float* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual bool NumberArray(const double* data, SizeType sz) override
+        {
+            return write_numbers(data, sz);
+        }
+
+        virtual void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    // Counts the events passing through to the wrapped handler. Parsers only see it when
+    // statistics are enabled, so parses without them never pay for the counting.
+    class StatisticsHandler final : public IHandler
+    {
+    private:
+        IHandler* h;
+        ParseStatistics* stats;
+        std::size_t depth = 0;
+
+        void enter()
+        {
+            if (++depth > stats->max_depth)
+                stats->max_depth = depth;
+        }
+
+    public:
+        explicit StatisticsHandler(IHandler* h, ParseStatistics* stats) : h(h), stats(stats) {}
+
+        bool Null() override
+        {
+            ++stats->nulls;
+            return h->Null();
+        }
+
+        bool Bool(bool v) override
+        {
+            ++stats->bools;
+            return h->Bool(v);
+        }
+
+        bool Int(int v) override
+        {
+            ++stats->integers;
+            return h->Int(v);
+        }
+
+        bool Uint(unsigned v) override
+        {
+            ++stats->integers;
+            return h->Uint(v);
+        }
+
+        bool Int64(std::int64_t v) override
+        {
+            ++stats->integers;
+            return h->Int64(v);
+        }
+
+        bool Uint64(std::uint64_t v) override
+        {
+            ++stats->integers;
+            return h->Uint64(v);
+        }
+
+        bool Double(double v) override
+        {
+            ++stats->doubles;
+            return h->Double(v);
+        }
+
+        bool RawNumber(const char* str, SizeType sz, bool copy) override
+        {
+            ++stats->doubles;
+            return h->RawNumber(str, sz, copy);
+        }
+
+        bool String(const char* str, SizeType sz, bool copy) override
+        {
+            ++stats->strings;
+            stats->string_bytes += sz;
+            return h->String(str, sz, copy);
+        }
+
+        bool Binary(const std::uint8_t* data, SizeType sz) override
+        {
+            ++stats->binaries;
+            stats->string_bytes += sz;
+            return h->Binary(data, sz);
+        }
+
+        bool StartObject() override
+        {
+            ++stats->objects;
+            enter();
+            return h->StartObject();
+        }
+
+        bool StartSizedObject(SizeType sz) override
+        {
+            ++stats->objects;
+            enter();
+            return h->StartSizedObject(sz);
+        }
+
+        bool Key(const char* str, SizeType sz, bool copy) override
+        {
+            ++stats->keys;
+            stats->string_bytes += sz;
+            return h->Key(str, sz, copy);
+        }
+
+        bool EndObject(SizeType sz) override
+        {
+            --depth;
+            return h->EndObject(sz);
+        }
+
+        bool StartArray() override
+        {
+            ++stats->arrays;
+            enter();
+            return h->StartArray();
+        }
+
+        bool StartSizedArray(SizeType sz) override
+        {
+            ++stats->arrays;
+            enter();
+            return h->StartSizedArray(sz);
+        }
+
+        bool EndArray(SizeType sz) override
+        {
+            --depth;
+            return h->EndArray(sz);
+        }
+
+        void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    // Resets the statistics and publishes them to the handlers for the duration of one parse
+    class StatisticsScope : private NonMobile
+    {
+    private:
+        ParseStatistics* stats;
+        ParseStatistics* previous;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        explicit StatisticsScope(ParseStatistics* stats)
+            : stats(stats), previous(active_statistics), start(std::chrono::steady_clock::now())
+        {
+            *stats = ParseStatistics();
+            active_statistics = stats;
+        }
+
+        ~StatisticsScope()
+        {
+            stats->elapsed_ns = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count());
+            active_statistics = previous;
+        }
+    };
+
+    // Fails the next event once the deadline has passed, the cancellation flag is raised or the
+    // event would break one of the structural limits
+    class GuardHandler final : public IHandler
+    {
+    public:
+        enum Reason
+        {
+            NONE,
+            CANCELLED,
+            DEADLINE_EXCEEDED,
+            LIMIT_EXCEEDED
+        };
+
+    private:
+        struct Container
+        {
+            bool is_object;
+            std::size_t size;
+        };
+
+        IHandler* h;
+        const ParseOptions* options;
+        const ParseLimits& limits;
+        std::size_t countdown = 1;
+        Reason m_reason = NONE;
+        std::unique_ptr<ErrorBase> m_limit_error;
+        std::vector<Container> m_containers;
+
+        bool check()
+        {
+            if (--countdown > 0)
+                return true;
+            countdown = options->check_interval > 0 ? options->check_interval : 1;
+            if (options->cancel && options->cancel->load(std::memory_order_relaxed))
+                m_reason = CANCELLED;
+            else if (std::chrono::steady_clock::now() >= options->deadline)
+                m_reason = DEADLINE_EXCEEDED;
+            return m_reason == NONE;
+        }
+
+        bool fail(ErrorBase* error)
+        {
+            m_reason = LIMIT_EXCEEDED;
+            m_limit_error.reset(error);
+            return false;
+        }
+
+        bool check_size(std::size_t size)
+        {
+            return size <= limits.max_container_size
+                || fail(new error::LimitExceededError("max_container_size",
+                                                      limits.max_container_size));
+        }
+
+        bool check_length(SizeType length)
+        {
+            return length <= limits.max_string_length
+                || fail(new error::LimitExceededError("max_string_length",
+                                                      limits.max_string_length));
+        }
+
+        // Counts a value against the enclosing array; object members are counted by their keys
+        bool value()
+        {
+            if (!check())
+                return false;
+            if (m_containers.empty() || m_containers.back().is_object)
+                return true;
+            return check_size(++m_containers.back().size);
+        }
+
+        bool enter(bool is_object)
+        {
+            if (!value())
+                return false;
+            if (m_containers.size() >= limits.max_depth)
+                return fail(new error::RecursionTooDeepError());
+            Container c = {is_object, 0};
+            m_containers.push_back(c);
+            return true;
+        }
+
+        bool leave()
+        {
+            if (!m_containers.empty())
+                m_containers.pop_back();
+            return check();
+        }
+
+    public:
+        explicit GuardHandler(IHandler* h, const ParseOptions* options)
+            : h(h), options(options), limits(options->limits)
+        {
+        }
+
+        Reason reason() const { return m_reason; }
+
+        std::unique_ptr<ErrorBase>& limit_error() { return m_limit_error; }
+
+        bool Null() override { return value() && h->Null(); }
+
+        bool Bool(bool v) override { return value() && h->Bool(v); }
+
+        bool Int(int v) override { return value() && h->Int(v); }
+
+        bool Uint(unsigned v) override { return value() && h->Uint(v); }
+
+        bool Int64(std::int64_t v) override { return value() && h->Int64(v); }
+
+        bool Uint64(std::uint64_t v) override { return value() && h->Uint64(v); }
+
+        bool Double(double v) override { return value() && h->Double(v); }
+
+        bool RawNumber(const char* str, SizeType sz, bool copy) override
+        {
+            return value() && h->RawNumber(str, sz, copy);
+        }
+
+        bool String(const char* str, SizeType sz, bool copy) override
+        {
+            return check_length(sz) && value() && h->String(str, sz, copy);
+        }
+
+        bool Binary(const std::uint8_t* data, SizeType sz) override
+        {
+            return check_length(sz) && value() && h->Binary(data, sz);
+        }
+
+        bool StartObject() override { return enter(true) && h->StartObject(); }
+
+        bool StartSizedObject(SizeType sz) override
+        {
+            return check_size(sz) && enter(true) && h->StartSizedObject(sz);
+        }
+
+        bool Key(const char* str, SizeType sz, bool copy) override
+        {
+            if (!check() || !check_length(sz))
+                return false;
+            if (!m_containers.empty() && !check_size(++m_containers.back().size))
+                return false;
+            return h->Key(str, sz, copy);
+        }
+
+        bool EndObject(SizeType sz) override { return leave() && h->EndObject(sz); }
+
+        bool StartArray() override { return enter(false) && h->StartArray(); }
+
+        bool StartSizedArray(SizeType sz) override
+        {
+            return check_size(sz) && enter(false) && h->StartSizedArray(sz);
+        }
+
+        bool EndArray(SizeType sz) override { return leave() && h->EndArray(sz); }
+
+        void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    // Drops array elements past their cap, and ends the document early once no more elements
+    // can be accepted
+    class SamplingHandler final : public IHandler
+    {
+    private:
+        struct Frame
+        {
+            bool is_array;
+            bool stops_parse;
+            std::size_t count;
+            std::size_t cap;
+            std::string key;
+        };
+
+        IHandler* h;
+        const SamplingOptions& options;
+        std::vector<Frame> m_frames;
+        std::size_t m_arrays = 0;
+        std::size_t m_skip_depth = 0;
+        bool m_stopped = false;
+
+        std::string current_path() const
+        {
+            std::string path;
+            for (auto&& f : m_frames)
+            {
+                path += '/';
+                if (f.is_array)
+                {
+                    path += '*';
+                    continue;
+                }
+                for (char c : f.key)
+                {
+                    if (c == '~')
+                        path += "~0";
+                    else if (c == '/')
+                        path += "~1";
+                    else
+                        path += c;
+                }
+            }
+            return path;
+        }
+
+        std::size_t cap_of_new_array() const
+        {
+            if (!options.max_array_elements_at.empty())
+            {
+                auto it = options.max_array_elements_at.find(current_path());
+                if (it != options.max_array_elements_at.end())
+                    return it->second;
+            }
+            return options.max_array_elements;
+        }
+
+        // Whether the next value belongs in the result; counts it against its array if so
+        bool accept()
+        {
+            if (m_skip_depth > 0 || m_frames.empty() || !m_frames.back().is_array)
+                return m_skip_depth == 0;
+            Frame& f = m_frames.back();
+            if (f.count >= f.cap)
+                return false;
+            ++f.count;
+            return true;
+        }
+
+        // Called after a whole value has been forwarded. Closes every open container and stops
+        // the parse when the enclosing array has just been filled.
+        bool value_done()
+        {
+            if (m_frames.empty() || !m_frames.back().stops_parse
+                || m_frames.back().count < m_frames.back().cap)
+                return true;
+            while (!m_frames.empty())
+            {
+                Frame& f = m_frames.back();
+                SizeType count = static_cast<SizeType>(f.count);
+                if (!(f.is_array ? h->EndArray(count) : h->EndObject(count)))
+                    return false;
+                m_frames.pop_back();
+            }
+            m_stopped = true;
+            return false;
+        }
+
+        bool scalar(bool forwarded) { return forwarded && value_done(); }
+
+        bool start(bool is_array)
+        {
+            if (!accept())
+            {
+                ++m_skip_depth;
+                return true;
+            }
+            Frame f = {is_array, false, 0, 0, std::string()};
+            if (is_array)
+            {
+                f.cap = cap_of_new_array();
+                f.stops_parse = m_arrays == 0 && f.cap != std::numeric_limits<std::size_t>::max();
+                ++m_arrays;
+            }
+            m_frames.push_back(std::move(f));
+            return true;
+        }
+
+        bool end_skipped()
+        {
+            --m_skip_depth;
+            return true;
+        }
+
+        void pop()
+        {
+            if (m_frames.back().is_array)
+                --m_arrays;
+            m_frames.pop_back();
+        }
+
+    public:
+        explicit SamplingHandler(IHandler* h, const SamplingOptions& options)
+            : h(h), options(options)
+        {
+        }
+
+        bool stopped() const { return m_stopped; }
+
+        bool Null() override { return !accept() || scalar(h->Null()); }
+
+        bool Bool(bool v) override { return !accept() || scalar(h->Bool(v)); }
+
+        bool Int(int v) override { return !accept() || scalar(h->Int(v)); }
+
+        bool Uint(unsigned v) override { return !accept() || scalar(h->Uint(v)); }
+
+        bool Int64(std::int64_t v) override { return !accept() || scalar(h->Int64(v)); }
+
+        bool Uint64(std::uint64_t v) override { return !accept() || scalar(h->Uint64(v)); }
+
+        bool Double(double v) override { return !accept() || scalar(h->Double(v)); }
+
+        bool RawNumber(const char* str, SizeType sz, bool copy) override
+        {
+            return !accept() || scalar(h->RawNumber(str, sz, copy));
+        }
+
+        bool String(const char* str, SizeType sz, bool copy) override
+        {
+            return !accept() || scalar(h->String(str, sz, copy));
+        }
+
+        bool Binary(const std::uint8_t* data, SizeType sz) override
+        {
+            return !accept() || scalar(h->Binary(data, sz));
+        }
+
+        bool StartObject() override
+        {
+            std::size_t skipping = m_skip_depth;
+            return start(false) && (m_skip_depth > skipping || h->StartObject());
+        }
+
+        bool StartSizedObject(SizeType sz) override
+        {
+            std::size_t skipping = m_skip_depth;
+            return start(false) && (m_skip_depth > skipping || h->StartSizedObject(sz));
+        }
+
+        bool Key(const char* str, SizeType sz, bool copy) override
+        {
+            if (m_skip_depth > 0)
+                return true;
+            m_frames.back().key.assign(str, sz);
+            ++m_frames.back().count;
+            return h->Key(str, sz, copy);
+        }
+
+        bool EndObject(SizeType sz) override
+        {
+            if (m_skip_depth > 0)
+                return end_skipped();
+            pop();
+            return h->EndObject(sz) && value_done();
+        }
+
+        bool StartArray() override
+        {
+            std::size_t skipping = m_skip_depth;
+            return start(true) && (m_skip_depth > skipping || h->StartArray());
+        }
+
+        bool StartSizedArray(SizeType sz) override
+        {
+            std::size_t skipping = m_skip_depth;
+            if (!start(true))
+                return false;
+            if (m_skip_depth > skipping)
+                return true;
+            std::size_t cap = m_frames.back().cap;
+            return h->StartSizedArray(cap < sz ? static_cast<SizeType>(cap) : sz);
+        }
+
+        bool EndArray(SizeType) override
+        {
+            if (m_skip_depth > 0)
+                return end_skipped();
+            SizeType count = static_cast<SizeType>(m_frames.back().count);
+            pop();
+            return h->EndArray(count) && value_done();
+        }
+
+        void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    // The handlers interposed in front of the target for one parse. Only built when statistics
+    // or options are requested; plain parses feed the target directly.
+    class ParseChain : private NonMobile
+    {
+    private:
+        ParseStatistics* stats;
+        std::unique_ptr<StatisticsScope> scope;
+        std::unique_ptr<StatisticsHandler> counter;
+        std::unique_ptr<SamplingHandler> sampler;
+        std::unique_ptr<GuardHandler> guard;
+        AllocationBudget budget;
+        AllocationBudget* previous_budget;
+        IHandler* front;
+
+    public:
+        explicit ParseChain(BaseHandler* h, ParseStatus* status, const ParseOptions* options)
+            : stats(status ? status->statistics() : nullptr)
+            , previous_budget(active_budget)
+            , front(h)
+        {
+            if (stats)
+            {
+                scope.reset(new StatisticsScope(stats));
+                counter.reset(new StatisticsHandler(front, stats));
+                front = counter.get();
+            }
+            if (options && options->sampling.any())
+            {
+                sampler.reset(new SamplingHandler(front, options->sampling));
+                front = sampler.get();
+            }
+            if (options)
+            {
+                guard.reset(new GuardHandler(front, options));
+                front = guard.get();
+                if (options->limits.max_allocation != std::numeric_limits<std::size_t>::max())
+                {
+                    budget.limit = options->limits.max_allocation;
+                    budget.used = 0;
+                    active_budget = &budget;
+                }
+            }
+        }
+
+        ~ParseChain() { active_budget = previous_budget; }
+
+        static bool needed(ParseStatus* status, const ParseOptions* options)
+        {
+            return options || (status && status->statistics());
+        }
+
+        IHandler* handler() const { return front; }
+
+        // Whether sampling ended the parse before the end of the input, which counts as success
+        bool stopped_early() const { return sampler && sampler->stopped(); }
+
+        // Records where parsing stopped and reports an interruption, if there was one
+        void finish(std::size_t offset, ParseStatus* status)
+        {
+            if (stats)
+                stats->bytes_consumed = offset;
+            if (!status || !guard)
+                return;
+            if (guard->reason() == GuardHandler::CANCELLED)
+                status->error_stack().push(new error::ParseCancelledError(offset));
+            else if (guard->reason() == GuardHandler::DEADLINE_EXCEEDED)
+                status->error_stack().push(new error::DeadlineExceededError(offset));
+            else if (guard->reason() == GuardHandler::LIMIT_EXCEEDED)
+                status->error_stack().push(guard->limit_error().release());
+        }
+    };
+
+    ParseSession::ParseSession(BaseHandler* handler,
+                               ParseStatus* status,
+                               const ParseOptions* options)
+        : m_handler(handler)
+        , m_status(status)
+        , m_chain(ParseChain::needed(status, options) ? new ParseChain(handler, status, options)
+                                                      : nullptr)
+    {
+        number_too_big = false;
+    }
+
+    ParseSession::~ParseSession() { delete m_chain; }
+
+    IHandler* ParseSession::handler() const { return m_chain->handler(); }
+
+    bool ParseSession::finish(rapidjson::ParseResult rc, std::size_t consumed)
+    {
+        std::size_t offset = rc.IsError() ? rc.Offset() : consumed;
+        if (m_chain && m_chain->stopped_early())
+            rc.Set(rapidjson::kParseErrorNone, offset);
+        if (rc.Code() == rapidjson::kParseErrorTermination && number_too_big)
+            rc.Set(rapidjson::kParseErrorNumberTooBig, rc.Offset());
+        if (m_status)
+        {
+            m_status->set_result(rc.Code(), rc.Offset());
+            m_handler->reap_error(m_status->error_stack());
+        }
+        if (m_chain)
+            m_chain->finish(offset, m_status);
+        return rc.Code() == 0;
+    }
+
+    bool parse_json_string(const char* str,
+                           BaseHandler* handler,
+                           ParseStatus* status,
+                           const ParseOptions* options)
+    {
+        rapidjson::StringStream is(str);
+        return read_json<rapidjson::kParseDefaultFlags>(is, handler, status, options);
+    }
+
+    bool parse_json_file(std::FILE* fp,
+                         BaseHandler* handler,
+                         ParseStatus* status,
+                         const ParseOptions* options)
+    {
+        if (!fp)
+            return false;
+        char buffer[1000];
+        rapidjson::FileReadStream is(fp, buffer, sizeof(buffer));
+        return read_json<rapidjson::kParseDefaultFlags>(is, handler, status, options);
+    }
+
+    struct StringOutputStream : private NonMobile
+    {
+        typedef char Ch;
+
+        std::string* str;
+
+        void Put(char c) { str->push_back(c); }
+
+        void Flush() {}
+    };
+
+    std::string serialize_json_string(const BaseHandler* handler)
+    {
+        std::string result;
+        StringOutputStream os;
+        os.str = &result;
+        rapidjson::Writer<StringOutputStream> writer(os);
+        IHandlerAdapter<decltype(writer)> adapter(&writer);
+        handler->write(&adapter);
+        return result;
+    }
+
+    bool serialize_json_file(std::FILE* fp, const BaseHandler* handler)
+    {
+        if (!fp)
+            return false;
+        char buffer[1000];
+        rapidjson::FileWriteStream os(fp, buffer, sizeof(buffer));
+        rapidjson::Writer<rapidjson::FileWriteStream> writer(os);
+        IHandlerAdapter<decltype(writer)> adapter(&writer);
+        return handler->write(&adapter);
+    }
+
+    std::string serialize_pretty_json_string(const BaseHandler* handler)
+    {
+        std::string result;
+        StringOutputStream os;
+        os.str = &result;
+        rapidjson::PrettyWriter<StringOutputStream> writer(os);
+        IHandlerAdapter<decltype(writer)> adapter(&writer);
+        handler->write(&adapter);
+        result.push_back('\n');
+        return result;
+    }
+
+    bool serialize_pretty_json_file(std::FILE* fp, const BaseHandler* handler)
+    {
+        if (!fp)
+            return false;
+        char buffer[1000];
+        rapidjson::FileWriteStream os(fp, buffer, sizeof(buffer));
+        rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
+        IHandlerAdapter<decltype(writer)> adapter(&writer);
+        bool res = handler->write(&adapter);
+        if (res)
+        {
+            putc('\n', fp);
+        }
+        return res;
+    }
+
+    std::string base64_encode(const std::uint8_t* data, std::size_t size)
+    {
+        static const char alphabet[]
+            = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string result;
+        result.reserve((size + 2) / 3 * 4);
+        std::size_t i = 0;
+        for (; i + 2 < size; i += 3)
+        {
+            std::uint32_t n = (std::uint32_t(data[i]) << 16) | (std::uint32_t(data[i + 1]) << 8)
+                | data[i + 2];
+            result.push_back(alphabet[(n >> 18) & 63]);
+            result.push_back(alphabet[(n >> 12) & 63]);
+            result.push_back(alphabet[(n >> 6) & 63]);
+            result.push_back(alphabet[n & 63]);
+        }
+        if (i < size)
+        {
+            std::uint32_t n = std::uint32_t(data[i]) << 16;
+            if (i + 1 < size)
+                n |= std::uint32_t(data[i + 1]) << 8;
+            result.push_back(alphabet[(n >> 18) & 63]);
+            result.push_back(alphabet[(n >> 12) & 63]);
+            result.push_back(i + 1 < size ? alphabet[(n >> 6) & 63] : '=');
+            result.push_back('=');
+        }
+        return result;
+    }
+
+    static int base64_value(char c)
+    {
+        if (c >= 'A' && c <= 'Z')
+            return c - 'A';
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 26;
+        if (c >= '0' && c <= '9')
+            return c - '0' + 52;
+        if (c == '+' || c == '-')
+            return 62;
+        if (c == '/' || c == '_')
+            return 63;
+        return -1;
+    }
+
+    bool base64_decode(const char* str, std::size_t length, std::vector<std::uint8_t>* out)
+    {
+        while (length > 0 && str[length - 1] == '=')
+            --length;
+        if (length % 4 == 1)
+            return false;
+        out->clear();
+        out->reserve(length * 3 / 4);
+        std::uint32_t accumulator = 0;
+        int bits = 0;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            int v = base64_value(str[i]);
+            if (v < 0)
+                return false;
+            accumulator = (accumulator << 6) | static_cast<std::uint32_t>(v);
+            bits += 6;
+            if (bits >= 8)
+            {
+                bits -= 8;
+                out->push_back(static_cast<std::uint8_t>(accumulator >> bits));
+            }
+        }
+        return true;
+    }
+
+    // Decodes RFC 8949 CBOR and drives the handler with the same events rapidjson::Reader emits
+    class CborReader : private NonMobile
+    {
+    private:
+        static const unsigned max_depth = 512;
+
+        const std::uint8_t* m_begin;
+        const std::uint8_t* m_cur;
+        const std::uint8_t* m_end;
+        IHandler* m_handler;
+        rapidjson::ParseErrorCode m_code;
+        bool m_too_deep;
+        std::string m_buffer;
+
+        bool fail(rapidjson::ParseErrorCode code)
+        {
+            if (m_code == rapidjson::kParseErrorNone)
+                m_code = code;
+            return false;
+        }
+
+        bool check(bool success) { return success || fail(rapidjson::kParseErrorTermination); }
+
+        bool read_bytes(std::size_t n, std::uint64_t* result)
+        {
+            if (static_cast<std::size_t>(m_end - m_cur) < n)
+                return fail(rapidjson::kParseErrorValueInvalid);
+            std::uint64_t r = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                r = (r << 8) | *m_cur++;
+            *result = r;
+            return true;
+        }
+
+        // On return, `info` equal to 31 denotes an indefinite length (or a break code)
+        bool read_head(unsigned* major, unsigned* info, std::uint64_t* argument)
+        {
+            if (m_cur == m_end)
+                return fail(rapidjson::kParseErrorValueInvalid);
+            std::uint8_t initial = *m_cur++;
+            *major = initial >> 5;
+            *info = initial & 31;
+            if (*info < 24)
+            {
+                *argument = *info;
+                return true;
+            }
+            switch (*info)
+            {
+            case 24:
+                return read_bytes(1, argument);
+            case 25:
+                return read_bytes(2, argument);
+            case 26:
+                return read_bytes(4, argument);
+            case 27:
+                return read_bytes(8, argument);
+            case 31:
+                if (*major == 0 || *major == 1 || *major == 6)
+                    return fail(rapidjson::kParseErrorValueInvalid);
+                *argument = 0;
+                return true;
+            default:
+                return fail(rapidjson::kParseErrorValueInvalid);
+            }
+        }
+
+        bool is_break()
+        {
+            if (m_cur != m_end && *m_cur == 0xff)
+            {
+                ++m_cur;
+                return true;
+            }
+            return false;
+        }
+
+        // Points `data` at the payload of a byte or text string, joining chunks if necessary
+        bool read_string(unsigned major,
+                         unsigned info,
+                         std::uint64_t argument,
+                         const char** data,
+                         std::size_t* size)
+        {
+            if (info != 31)
+            {
+                if (argument > static_cast<std::uint64_t>(m_end - m_cur))
+                    return fail(rapidjson::kParseErrorValueInvalid);
+                *data = reinterpret_cast<const char*>(m_cur);
+                *size = static_cast<std::size_t>(argument);
+                m_cur += *size;
+                return true;
+            }
+            m_buffer.clear();
+            while (!is_break())
+            {
+                unsigned chunk_major, chunk_info;
+                std::uint64_t chunk_size;
+                if (!read_head(&chunk_major, &chunk_info, &chunk_size))
+                    return false;
+                if (chunk_major != major || chunk_info == 31
+                    || chunk_size > static_cast<std::uint64_t>(m_end - m_cur))
+                    return fail(rapidjson::kParseErrorValueInvalid);
+                m_buffer.append(reinterpret_cast<const char*>(m_cur),
+                                static_cast<std::size_t>(chunk_size));
+                m_cur += chunk_size;
+            }
+            *data = m_buffer.data();
+            *size = m_buffer.size();
+            return true;
+        }
+
+        bool read_key()
+        {
+            unsigned major, info;
+            std::uint64_t argument;
+            if (!read_head(&major, &info, &argument))
+                return false;
+            while (major == 6)
+            {
+                if (!read_head(&major, &info, &argument))
+                    return false;
+            }
+            if (major == 3)
+            {
+                const char* data;
+                std::size_t size;
+                if (!read_string(major, info, argument, &data, &size))
+                    return false;
+                return check(m_handler->Key(data, static_cast<SizeType>(size), true));
+            }
+            if (major == 0 || major == 1)
+            {
+                // Integer keys are spelled as their decimal text, which is what JSON would carry
+                std::string digits;
+                if (major == 1)
+                {
+                    if (argument == std::numeric_limits<std::uint64_t>::max())
+                        return fail(rapidjson::kParseErrorObjectMissName);
+                    digits.push_back('-');
+                    ++argument;
+                }
+                digits += std::to_string(static_cast<unsigned long long>(argument));
+                return check(
+                    m_handler->Key(digits.data(), static_cast<SizeType>(digits.size()), true));
+            }
+            return fail(rapidjson::kParseErrorObjectMissName);
+        }
+
+        static double decode_half(unsigned half)
+        {
+            unsigned exponent = (half >> 10) & 0x1f, mantissa = half & 0x3ff;
+            double value;
+            if (exponent == 0)
+                value = std::ldexp(static_cast<double>(mantissa), -24);
+            else if (exponent != 31)
+                value = std::ldexp(static_cast<double>(mantissa + 1024), int(exponent) - 25);
+            else
+                value = mantissa == 0 ? std::numeric_limits<double>::infinity()
+                                      : std::numeric_limits<double>::quiet_NaN();
+            return (half & 0x8000) ? -value : value;
+        }
+
+        bool read_simple(unsigned info, std::uint64_t argument)
+        {
+            switch (info)
+            {
+            case 20:
+                return check(m_handler->Bool(false));
+            case 21:
+                return check(m_handler->Bool(true));
+            case 22:
+            case 23:
+                return check(m_handler->Null());
+            case 25:
+                return check(m_handler->Double(decode_half(static_cast<unsigned>(argument))));
+            case 26:
+            {
+                std::uint32_t bits = static_cast<std::uint32_t>(argument);
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                return check(m_handler->Double(f));
+            }
+            case 27:
+            {
+                double d;
+                std::memcpy(&d, &argument, sizeof(d));
+                return check(m_handler->Double(d));
+            }
+            default:
+                return fail(rapidjson::kParseErrorValueInvalid);
+            }
+        }
+
+        bool read_item(unsigned depth)
+        {
+            unsigned major, info;
+            std::uint64_t argument;
+            if (!read_head(&major, &info, &argument))
+                return false;
+            // Semantic tags carry no meaning for static typing and are skipped
+            while (major == 6)
+            {
+                if (!read_head(&major, &info, &argument))
+                    return false;
+            }
+            switch (major)
+            {
+            case 0:
+                if (argument <= std::numeric_limits<unsigned>::max())
+                    return check(m_handler->Uint(static_cast<unsigned>(argument)));
+                return check(m_handler->Uint64(argument));
+            case 1:
+                if (argument <= static_cast<std::uint64_t>(std::numeric_limits<int>::max()))
+                    return check(m_handler->Int(-1 - static_cast<int>(argument)));
+                if (argument
+                    <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+                    return check(m_handler->Int64(-1 - static_cast<std::int64_t>(argument)));
+                return check(m_handler->Double(-1.0 - static_cast<double>(argument)));
+            case 2:
+            case 3:
+            {
+                const char* data;
+                std::size_t size;
+                if (!read_string(major, info, argument, &data, &size))
+                    return false;
+                if (major == 2)
+                    return check(m_handler->Binary(reinterpret_cast<const std::uint8_t*>(data),
+                                                   static_cast<SizeType>(size)));
+                return check(m_handler->String(data, static_cast<SizeType>(size), true));
+            }
+            case 4:
+            {
+                if (depth >= max_depth)
+                {
+                    m_too_deep = true;
+                    return fail(rapidjson::kParseErrorTermination);
+                }
+                if (!check(info == 31 ? m_handler->StartArray()
+                                      : m_handler->StartSizedArray(clamp_size(argument, 1))))
+                    return false;
+                SizeType count = 0;
+                for (; info == 31 ? !is_break() : count < argument; ++count)
+                {
+                    if (!read_item(depth + 1))
+                        return false;
+                }
+                return check(m_handler->EndArray(count));
+            }
+            case 5:
+            {
+                if (depth >= max_depth)
+                {
+                    m_too_deep = true;
+                    return fail(rapidjson::kParseErrorTermination);
+                }
+                if (!check(info == 31 ? m_handler->StartObject()
+                                      : m_handler->StartSizedObject(clamp_size(argument, 2))))
+                    return false;
+                SizeType count = 0;
+                for (; info == 31 ? !is_break() : count < argument; ++count)
+                {
+                    if (!read_key() || !read_item(depth + 1))
+                        return false;
+                }
+                return check(m_handler->EndObject(count));
+            }
+            default:
+                return read_simple(info, argument);
+            }
+        }
+
+        // Each item takes at least `item_size` bytes, so a length the rest of the input cannot
+        // hold is not passed on to handlers that may reserve for it
+        SizeType clamp_size(std::uint64_t n, std::size_t item_size) const
+        {
+            std::uint64_t available = static_cast<std::uint64_t>(m_end - m_cur) / item_size;
+            if (n > available)
+                n = available;
+            return n > std::numeric_limits<SizeType>::max() ? std::numeric_limits<SizeType>::max()
+                                                             : static_cast<SizeType>(n);
+        }
+
+    public:
+        explicit CborReader(const std::uint8_t* data, std::size_t size, IHandler* handler)
+            : m_begin(data)
+            , m_cur(data)
+            , m_end(data + size)
+            , m_handler(handler)
+            , m_code(rapidjson::kParseErrorNone)
+            , m_too_deep(false)
+        {
+        }
+
+        bool parse()
+        {
+            if (m_cur == m_end)
+                return fail(rapidjson::kParseErrorDocumentEmpty);
+            if (!read_item(0))
+                return false;
+            if (m_cur != m_end)
+                return fail(rapidjson::kParseErrorDocumentRootNotSingular);
+            return true;
+        }
+
+        rapidjson::ParseErrorCode code() const { return m_code; }
+
+        std::size_t offset() const { return static_cast<std::size_t>(m_cur - m_begin); }
+
+        bool too_deep() const { return m_too_deep; }
+    };
+
+    bool parse_cbor(const std::uint8_t* data,
+                    std::size_t size,
+                    BaseHandler* handler,
+                    ParseStatus* status,
+                    const ParseOptions* options)
+    {
+        std::unique_ptr<ParseChain> chain(ParseChain::needed(status, options)
+                                              ? new ParseChain(handler, status, options)
+                                              : nullptr);
+        CborReader reader(data, size, chain ? chain->handler() : handler);
+        bool success = reader.parse() || (chain && chain->stopped_early());
+        if (status)
+        {
+            status->set_result(success ? 0 : reader.code(), reader.offset());
+            handler->reap_error(status->error_stack());
+            if (reader.too_deep())
+                status->error_stack().push(new error::RecursionTooDeepError());
+        }
+        if (chain)
+            chain->finish(reader.offset(), status);
+        return success;
+    }
+
+    class CborWriter : public IHandler
+    {
+    private:
+        std::string* m_out;
+
+        // Whether this writes a snapshot, which includes members flagged IgnoreWrite
+        bool m_snapshot;
+
+        // One entry per open container, true if it was started without a known length
+        std::vector<bool> m_indefinite;
+
+        void put_head(unsigned major, std::uint64_t argument)
+        {
+            char head[9];
+            std::size_t n;
+            head[0] = static_cast<char>(major << 5);
+            if (argument < 24)
+            {
+                head[0] |= static_cast<char>(argument);
+                n = 0;
+            }
+            else if (argument <= 0xff)
+            {
+                head[0] |= 24;
+                n = 1;
+            }
+            else if (argument <= 0xffff)
+            {
+                head[0] |= 25;
+                n = 2;
+            }
+            else if (argument <= 0xffffffffULL)
+            {
+                head[0] |= 26;
+                n = 4;
+            }
+            else
+            {
+                head[0] |= 27;
+                n = 8;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                head[n - i] = static_cast<char>((argument >> (8 * i)) & 0xff);
+            m_out->append(head, n + 1);
+        }
+
+        bool put_signed(std::int64_t i)
+        {
+            if (i >= 0)
+                put_head(0, static_cast<std::uint64_t>(i));
+            else
+                put_head(1, static_cast<std::uint64_t>(-(i + 1)));
+            return true;
+        }
+
+        bool put_payload(unsigned major, const void* data, SizeType size)
+        {
+            put_head(major, size);
+            m_out->append(static_cast<const char*>(data), size);
+            return true;
+        }
+
+        bool start(unsigned major, bool indefinite, SizeType size)
+        {
+            if (indefinite)
+                m_out->push_back(static_cast<char>((major << 5) | 31));
+            else
+                put_head(major, size);
+            m_indefinite.push_back(indefinite);
+            return true;
+        }
+
+        bool end()
+        {
+            if (m_indefinite.empty())
+                return false;
+            if (m_indefinite.back())
+                m_out->push_back(static_cast<char>(0xff));
+            m_indefinite.pop_back();
+            return true;
+        }
+
+    public:
+        explicit CborWriter(std::string* out, bool snapshot = false)
+            : m_out(out), m_snapshot(snapshot)
+        {
+        }
+
+        bool Null() override
+        {
+            m_out->push_back(static_cast<char>(0xf6));
+            return true;
+        }
+
+        bool Bool(bool b) override
+        {
+            m_out->push_back(static_cast<char>(b ? 0xf5 : 0xf4));
+            return true;
+        }
+
+        bool Int(int i) override { return put_signed(i); }
+
+        bool Uint(unsigned u) override
+        {
+            put_head(0, u);
+            return true;
+        }
+
+        bool Int64(std::int64_t i) override { return put_signed(i); }
+
+        bool Uint64(std::uint64_t u) override
+        {
+            put_head(0, u);
+            return true;
+        }
+
+        bool Double(double d) override
+        {
+            // Single precision is used whenever it represents the value exactly
+            float f = static_cast<float>(d);
+            if (static_cast<double>(f) == d || d != d)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(f));
+                m_out->push_back(static_cast<char>(0xfa));
+                for (int i = 3; i >= 0; --i)
+                    m_out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+            }
+            else
+            {
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(d));
+                m_out->push_back(static_cast<char>(0xfb));
+                for (int i = 7; i >= 0; --i)
+                    m_out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+            }
+            return true;
+        }
+
+        bool RawNumber(const char* str, SizeType length, bool) override
+        {
+            return Double(std::strtod(std::string(str, length).c_str(), nullptr));
+        }
+
+        bool String(const char* str, SizeType length, bool) override
+        {
+            return put_payload(3, str, length);
+        }
+
+        bool Binary(const std::uint8_t* data, SizeType length) override
+        {
+            return put_payload(2, data, length);
+        }
+
+        bool Key(const char* str, SizeType length, bool) override
+        {
+            return put_payload(3, str, length);
+        }
+
+        bool StartObject() override { return start(5, true, 0); }
+
+        bool StartSizedObject(SizeType size) override { return start(5, false, size); }
+
+        bool EndObject(SizeType) override { return end(); }
+
+        bool StartArray() override { return start(4, true, 0); }
+
+        bool StartSizedArray(SizeType size) override { return start(4, false, size); }
+
+        bool EndArray(SizeType) override { return end(); }
+
+        bool writes_ignored_members() const override { return m_snapshot; }
+
+        void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    std::string serialize_cbor(const BaseHandler* handler)
+    {
+        std::string result;
+        CborWriter writer(&result);
+        handler->write(&writer);
+        return result;
+    }
+
+    // Hashes eight bytes at a time; this only has to detect accidental changes, and quickly
+    static std::uint64_t hash_bytes(const char* data, std::size_t size)
+    {
+        const std::uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+        std::uint64_t h = 0xcbf29ce484222325ULL ^ (size * multiplier);
+        std::size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, data + i, sizeof(word));
+            h = (h ^ word) * multiplier;
+            h ^= h >> 29;
+        }
+        for (; i < size; ++i)
+        {
+            h = (h ^ static_cast<unsigned char>(data[i])) * multiplier;
+            h ^= h >> 29;
+        }
+        return h ^ (h >> 32);
+    }
+
+    bool read_source_file(const char* filename, SourceFile* source)
+    {
+        struct stat st;
+        if (::stat(filename, &st) != 0)
+            return false;
+        FileGuard fg(std::fopen(filename, "rb"));
+        if (!fg.fp)
+            return false;
+        source->content.clear();
+        char buffer[16384];
+        std::size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), fg.fp)) > 0)
+            source->content.append(buffer, n);
+        if (std::ferror(fg.fp))
+            return false;
+        source->size = source->content.size();
+        source->mtime = static_cast<std::int64_t>(st.st_mtime);
+        source->hash = hash_bytes(source->content.data(), source->content.size());
+        return true;
+    }
+
+    std::uint64_t handler_fingerprint(const BaseHandler* handler)
+    {
+        Document schema;
+        handler->generate_schema(schema, schema.GetAllocator());
+        std::string text = handler->type_name();
+        text.push_back('\n');
+        StringOutputStream os;
+        os.str = &text;
+        rapidjson::Writer<StringOutputStream> writer(os);
+        schema.Accept(writer);
+        return hash_bytes(text.data(), text.size());
+    }
+
+    static const char snapshot_magic[8] = {'S', 'J', 'S', 'N', 'A', 'P', '0', '2'};
+
+    // magic, fingerprint, source size, source mtime, source hash, payload size, payload hash
+    static const std::size_t snapshot_header_size = 8 + 6 * 8;
+
+    static std::string snapshot_filename(const char* filename)
+    {
+        return std::string(filename) + ".sjc";
+    }
+
+    static void put_u64(std::string* out, std::uint64_t v)
+    {
+        for (int i = 0; i < 8; ++i)
+            out->push_back(static_cast<char>((v >> (8 * i)) & 0xff));
+    }
+
+    static std::uint64_t get_u64(const char* p)
+    {
+        std::uint64_t v = 0;
+        for (int i = 7; i >= 0; --i)
+            v = (v << 8) | static_cast<unsigned char>(p[i]);
+        return v;
+    }
+
+    bool parse_snapshot(const char* filename,
+                        std::uint64_t fingerprint,
+                        const SourceFile& source,
+                        BaseHandler* handler,
+                        ParseStatus* status,
+                        const ParseOptions* options)
+    {
+        FileGuard fg(std::fopen(snapshot_filename(filename).c_str(), "rb"));
+        if (!fg.fp)
+            return false;
+        char header[snapshot_header_size];
+        if (std::fread(header, 1, sizeof(header), fg.fp) != sizeof(header))
+            return false;
+        if (std::memcmp(header, snapshot_magic, sizeof(snapshot_magic)) != 0
+            || get_u64(header + 8) != fingerprint || get_u64(header + 16) != source.size
+            || static_cast<std::int64_t>(get_u64(header + 24)) != source.mtime
+            || get_u64(header + 32) != source.hash)
+            return false;
+
+        std::uint64_t payload_size = get_u64(header + 40);
+        std::string payload;
+        char buffer[16384];
+        std::size_t n;
+        while ((n = std::fread(buffer, 1, sizeof(buffer), fg.fp)) > 0)
+        {
+            payload.append(buffer, n);
+            if (payload.size() > payload_size)
+                return false;
+        }
+        if (payload.size() != payload_size
+            || hash_bytes(payload.data(), payload.size()) != get_u64(header + 48))
+            return false;
+
+        ParseStatus snapshot_status;
+        if (!parse_cbor(reinterpret_cast<const std::uint8_t*>(payload.data()),
+                        payload.size(),
+                        handler,
+                        &snapshot_status,
+                        options))
+            return false;
+        if (status)
+            status->set_result(0, source.size);
+        return true;
+    }
+
+    void write_snapshot(const char* filename,
+                        std::uint64_t fingerprint,
+                        const SourceFile& source,
+                        const BaseHandler* handler)
+    {
+        // A snapshot has to restore the whole value, so members flagged IgnoreWrite go in as well
+        std::string payload;
+        CborWriter writer(&payload, true);
+        handler->write(&writer);
+        std::string header(snapshot_magic, sizeof(snapshot_magic));
+        put_u64(&header, fingerprint);
+        put_u64(&header, source.size);
+        put_u64(&header, static_cast<std::uint64_t>(source.mtime));
+        put_u64(&header, source.hash);
+        put_u64(&header, payload.size());
+        put_u64(&header, hash_bytes(payload.data(), payload.size()));
+
+        // Write to a temporary first so that concurrent readers never see a partial snapshot
+        std::string target = snapshot_filename(filename);
+        std::string temporary = target + ".tmp" + std::to_string(std::random_device()());
+        {
+            FileGuard fg(std::fopen(temporary.c_str(), "wb"));
+            if (!fg.fp)
+                return;
+            bool success = std::fwrite(header.data(), 1, header.size(), fg.fp) == header.size()
+                && std::fwrite(payload.data(), 1, payload.size(), fg.fp) == payload.size()
+                && std::fflush(fg.fp) == 0;
+            if (!success)
+            {
+                std::fclose(fg.fp);
+                fg.fp = nullptr;
+                std::remove(temporary.c_str());
+                return;
+            }
+        }
+#ifdef _WIN32
+        std::remove(target.c_str());
+#endif
+        if (std::rename(temporary.c_str(), target.c_str()) != 0)
+            std::remove(temporary.c_str());
+    }
+
+    static const char frozen_magic[8] = {'S', 'J', 'F', 'R', 'O', 'Z', '0', '1'};
+
+    // Lays out nodes bottom-up: children are complete before the container that refers to them
+    class FreezeWriter : public IHandler
+    {
+    private:
+        std::string* m_out;
+
+        // Child offsets of the open containers; for objects, keys and values alternate
+        std::vector<std::vector<std::uint64_t>> m_frames;
+        std::size_t m_depth;
+        std::uint64_t m_root;
+        std::vector<std::pair<std::uint64_t, std::uint64_t>> m_members;
+
+        void pad()
+        {
+            while (m_out->size() % 8 != 0)
+                m_out->push_back('\0');
+        }
+
+        template <class U>
+        void put(U u)
+        {
+            m_out->append(reinterpret_cast<const char*>(&u), sizeof(u));
+        }
+
+        std::uint64_t start_node(frozen::Kind kind, std::uint32_t count)
+        {
+            pad();
+            std::uint64_t offset = m_out->size();
+            put(static_cast<std::uint32_t>(kind));
+            put(count);
+            return offset;
+        }
+
+        bool finish_node(std::uint64_t offset)
+        {
+            if (m_depth == 0)
+                m_root = offset;
+            else
+                m_frames[m_depth - 1].push_back(offset);
+            return true;
+        }
+
+        std::uint64_t put_string(frozen::Kind kind, const char* str, SizeType length)
+        {
+            std::uint64_t offset = start_node(kind, length);
+            m_out->append(str, length);
+            m_out->push_back('\0');
+            return offset;
+        }
+
+        template <class U>
+        bool put_scalar(frozen::Kind kind, U u)
+        {
+            std::uint64_t offset = start_node(kind, 0);
+            put(u);
+            return finish_node(offset);
+        }
+
+        bool open_frame()
+        {
+            if (m_frames.size() <= m_depth)
+                m_frames.emplace_back();
+            m_frames[m_depth].clear();
+            ++m_depth;
+            return true;
+        }
+
+        frozen::StringRef key_at(std::uint64_t offset) const
+        {
+            std::uint32_t length;
+            std::memcpy(&length, m_out->data() + offset + 4, sizeof(length));
+            return frozen::StringRef(m_out->data() + offset + 8, length);
+        }
+
+        struct KeyLess
+        {
+            const FreezeWriter* writer;
+
+            bool operator()(const std::pair<std::uint64_t, std::uint64_t>& a,
+                            const std::pair<std::uint64_t, std::uint64_t>& b) const
+            {
+                frozen::StringRef kb = writer->key_at(b.first);
+                return writer->key_at(a.first).compare(kb.data(), kb.size()) < 0;
+            }
+        };
+
+    public:
+        explicit FreezeWriter(std::string* out) : m_out(out), m_depth(0), m_root(0)
+        {
+            m_out->assign(frozen_magic, sizeof(frozen_magic));
+            m_out->append(frozen::header_size - sizeof(frozen_magic), '\0');
+        }
+
+        std::uint64_t root() const { return m_root; }
 
-    public:
-        explicit IHandlerAdapter(T* t) : t(t) {}
+        bool Null() override { return finish_node(start_node(frozen::Kind::Null, 0)); }
 
-        virtual bool Null() override { return t->Null(); }
+        bool Bool(bool b) override { return finish_node(start_node(frozen::Kind::Bool, b)); }
 
-        virtual bool Bool(bool v) override { return t->Bool(v); }
+        bool Int(int i) override { return Int64(i); }
 
-        virtual bool Int(int v) override { return t->Int(v); }
+        bool Uint(unsigned u) override { return Uint64(u); }
 
-        virtual bool Uint(unsigned v) override { return t->Uint(v); }
+        bool Int64(std::int64_t i) override { return put_scalar(frozen::Kind::Int64, i); }
 
-        virtual bool Int64(std::int64_t v) override { return t->Int64(v); }
+        bool Uint64(std::uint64_t u) override { return put_scalar(frozen::Kind::Uint64, u); }
 
-        virtual bool Uint64(std::uint64_t v) override { return t->Uint64(v); }
+        bool Double(double d) override { return put_scalar(frozen::Kind::Double, d); }
 
-        virtual bool Double(double v) override { return t->Double(v); }
+        bool RawNumber(const char* str, SizeType length, bool) override
+        {
+            return Double(std::strtod(std::string(str, length).c_str(), nullptr));
+        }
 
-        virtual bool String(const char* str, SizeType sz, bool copy) override
+        bool String(const char* str, SizeType length, bool) override
         {
-            return t->String(str, sz, copy);
+            return finish_node(put_string(frozen::Kind::String, str, length));
         }
 
-        virtual bool StartObject() override { return t->StartObject(); }
+        bool Binary(const std::uint8_t* data, SizeType length) override
+        {
+            return finish_node(
+                put_string(frozen::Kind::Binary, reinterpret_cast<const char*>(data), length));
+        }
 
-        virtual bool Key(const char* str, SizeType sz, bool copy) override
+        bool Key(const char* str, SizeType length, bool) override
         {
-            return t->Key(str, sz, copy);
+            if (m_depth == 0)
+                return false;
+            return finish_node(put_string(frozen::Kind::String, str, length));
         }
 
-        virtual bool EndObject(SizeType sz) override { return t->EndObject(sz); }
+        bool StartObject() override { return open_frame(); }
 
-        virtual bool StartArray() override { return t->StartArray(); }
+        bool EndObject(SizeType) override
+        {
+            if (m_depth == 0)
+                return false;
+            const std::vector<std::uint64_t>& entries = m_frames[m_depth - 1];
+            if (entries.size() % 2 != 0)
+                return false;
+            m_members.clear();
+            for (std::size_t i = 0; i < entries.size(); i += 2)
+                m_members.emplace_back(entries[i], entries[i + 1]);
 
-        virtual bool EndArray(SizeType sz) override { return t->EndArray(sz); }
+            // Registered objects and std::map already produce sorted keys
+            KeyLess less{this};
+            if (!std::is_sorted(m_members.begin(), m_members.end(), less))
+                std::stable_sort(m_members.begin(), m_members.end(), less);
 
-        virtual void prepare_for_reuse() override { std::terminate(); }
-    };
+            std::uint64_t offset
+                = start_node(frozen::Kind::Object, static_cast<std::uint32_t>(m_members.size()));
+            for (auto&& member : m_members)
+            {
+                put(member.first);
+                put(member.second);
+            }
+            --m_depth;
+            return finish_node(offset);
+        }
 
-    template <class InputStream>
-    static bool read_json(InputStream& is, BaseHandler* h, ParseStatus* status)
-    {
-        rapidjson::Reader r;
-        rapidjson::ParseResult rc = r.Parse(is, *h);
-        if (status)
+        bool StartArray() override { return open_frame(); }
+
+        bool EndArray(SizeType) override
         {
-            status->set_result(rc.Code(), rc.Offset());
-            h->reap_error(status->error_stack());
+            if (m_depth == 0)
+                return false;
+            std::vector<std::uint64_t>& entries = m_frames[m_depth - 1];
+            std::uint64_t offset
+                = start_node(frozen::Kind::Array, static_cast<std::uint32_t>(entries.size()));
+            for (std::uint64_t e : entries)
+                put(e);
+            --m_depth;
+            return finish_node(offset);
         }
-        return rc.Code() == 0;
-    }
 
-    bool parse_json_string(const char* str, BaseHandler* handler, ParseStatus* status)
+        void prepare_for_reuse() override { std::terminate(); }
+    };
+
+    std::string freeze(const BaseHandler* handler)
     {
-        rapidjson::StringStream is(str);
-        return read_json(is, handler, status);
+        std::string result;
+        FreezeWriter writer(&result);
+        if (!handler->write(&writer))
+            return std::string();
+        std::uint64_t root = writer.root(), size = result.size();
+        std::memcpy(&result[8], &root, sizeof(root));
+        std::memcpy(&result[16], &size, sizeof(size));
+        return result;
     }
 
-    bool parse_json_file(std::FILE* fp, BaseHandler* handler, ParseStatus* status)
+    bool freeze_to_file(std::FILE* fp, const BaseHandler* handler)
     {
         if (!fp)
             return false;
-        char buffer[1000];
-        rapidjson::FileReadStream is(fp, buffer, sizeof(buffer));
-        return read_json(is, handler, status);
+        std::string image = freeze(handler);
+        return !image.empty() && std::fwrite(image.data(), 1, image.size(), fp) == image.size();
     }
 
-    struct StringOutputStream : private NonMobile
+    template <class OutputStream>
+    class CountingStream : private NonMobile
     {
+    private:
+        OutputStream* m_inner;
+        std::size_t m_count;
+
+    public:
         typedef char Ch;
 
-        std::string* str;
+        explicit CountingStream(OutputStream* inner) : m_inner(inner), m_count(0) {}
 
-        void Put(char c) { str->push_back(c); }
+        void Put(char c)
+        {
+            ++m_count;
+            m_inner->Put(c);
+        }
 
-        void Flush() {}
+        void Flush() { m_inner->Flush(); }
+
+        std::size_t count() const { return m_count; }
     };
 
-    std::string serialize_json_string(const BaseHandler* handler)
+    // Walks a schema exported by a handler tree and writes a random document conforming to it
+    template <class Writer, class OutputStream>
+    class JsonGenerator : private NonMobile
     {
-        std::string result;
-        StringOutputStream os;
-        os.str = &result;
-        rapidjson::Writer<StringOutputStream> writer(os);
-        IHandlerAdapter<decltype(writer)> adapter(&writer);
-        handler->write(&adapter);
-        return result;
-    }
+    private:
+        const GeneratorOptions& m_options;
+        Writer* m_writer;
+        const OutputStream* m_stream;
+        std::mt19937_64 m_rng;
+        std::string m_text;
+        std::size_t m_key_counter;
 
-    bool serialize_json_file(std::FILE* fp, const BaseHandler* handler)
+        static const Value* member(const Value& v, const char* name)
+        {
+            if (!v.IsObject())
+                return nullptr;
+            auto it = v.FindMember(name);
+            return it == v.MemberEnd() ? nullptr : &it->value;
+        }
+
+        static bool is_type(const Value& schema, const char* type)
+        {
+            const Value* t = member(schema, "type");
+            return t && t->IsString() && std::strcmp(t->GetString(), type) == 0;
+        }
+
+        bool chance(double p) { return std::uniform_real_distribution<double>(0, 1)(m_rng) < p; }
+
+        std::size_t between(std::size_t low, std::size_t high)
+        {
+            if (high <= low)
+                return low;
+            return low + static_cast<std::size_t>(m_rng() % (high - low + 1));
+        }
+
+        void random_text(std::size_t length, std::string* out)
+        {
+            static const char common[]
+                = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 _-.";
+            out->clear();
+            for (std::size_t i = 0; i < length; ++i)
+            {
+                unsigned r = static_cast<unsigned>(m_rng() % 64);
+                if (r == 0)
+                {
+                    // Occasional characters that need escaping or are not ASCII
+                    static const char* const specials[] = {"\"", "\\", "\n", "\t", "\xc3\xa9"};
+                    out->append(specials[m_rng() % 5]);
+                }
+                else
+                {
+                    out->push_back(common[m_rng() % (sizeof(common) - 1)]);
+                }
+            }
+        }
+
+        // Uniform in [0, high], including the full 64-bit range
+        std::uint64_t up_to(std::uint64_t high)
+        {
+            if (high == std::numeric_limits<std::uint64_t>::max())
+                return m_rng();
+            return m_rng() % (high + 1);
+        }
+
+        bool write_text()
+        {
+            random_text(between(m_options.min_string_length, m_options.max_string_length),
+                        &m_text);
+            return m_writer->String(m_text.data(), static_cast<SizeType>(m_text.size()), true);
+        }
+
+        bool write_key()
+        {
+            random_text(between(m_options.min_string_length, m_options.max_string_length),
+                        &m_text);
+            // Keys are made unique so that maps keep every generated entry
+            m_text += '#';
+            m_text += std::to_string(m_key_counter++);
+            return m_writer->Key(m_text.data(), static_cast<SizeType>(m_text.size()), true);
+        }
+
+        bool write_integer(const Value& schema)
+        {
+            const Value* minimum = member(schema, "minimum");
+            const Value* maximum = member(schema, "maximum");
+            if (minimum && maximum && minimum->IsInt64() && maximum->IsInt64())
+            {
+                std::int64_t low = minimum->GetInt64(), high = maximum->GetInt64();
+                if (chance(0.5) && low <= 1000 && high >= -1000)
+                {
+                    low = std::max<std::int64_t>(low, -1000);
+                    high = std::min<std::int64_t>(high, 1000);
+                }
+                std::uint64_t offset = up_to(static_cast<std::uint64_t>(high)
+                                             - static_cast<std::uint64_t>(low));
+                return m_writer->Int64(
+                    static_cast<std::int64_t>(static_cast<std::uint64_t>(low) + offset));
+            }
+            if (minimum && maximum && minimum->IsUint64() && maximum->IsUint64())
+            {
+                std::uint64_t low = minimum->GetUint64(), high = maximum->GetUint64();
+                if (chance(0.5) && low <= 1000)
+                    high = std::min<std::uint64_t>(high, 1000);
+                return m_writer->Uint64(low + up_to(high - low));
+            }
+            return m_writer->Int64(static_cast<std::int64_t>(m_rng() % 2000001) - 1000000);
+        }
+
+        bool write_number()
+        {
+            if (chance(0.25))
+                return m_writer->Int(static_cast<int>(m_rng() % 2001) - 1000);
+            return m_writer->Double(std::uniform_real_distribution<double>(-1e6, 1e6)(m_rng));
+        }
+
+        bool write_bytes()
+        {
+            std::size_t length = between(m_options.min_string_length, m_options.max_string_length);
+            std::vector<std::uint8_t> bytes(length);
+            for (auto&& b : bytes)
+                b = static_cast<std::uint8_t>(m_rng());
+            std::string encoded = base64_encode(bytes.data(), bytes.size());
+            return m_writer->String(encoded.data(), static_cast<SizeType>(encoded.size()), true);
+        }
+
+        // Any JSON at all, used where the schema does not constrain the value
+        bool write_any(unsigned depth)
+        {
+            unsigned kinds = depth < m_options.max_depth ? 7 : 5;
+            unsigned choice = static_cast<unsigned>(m_rng() % kinds);
+            switch (choice)
+            {
+            case 0:
+                return m_writer->Null();
+            case 1:
+                return m_writer->Bool((m_rng() & 1) != 0);
+            case 2:
+            case 3:
+                return write_number();
+            case 4:
+                return write_text();
+            case 5:
+            {
+                std::size_t n = between(m_options.min_array_size, m_options.max_array_size);
+                if (!m_writer->StartArray())
+                    return false;
+                for (std::size_t i = 0; i < n; ++i)
+                    if (!write_any(depth + 1))
+                        return false;
+                return m_writer->EndArray(static_cast<SizeType>(n));
+            }
+            default:
+            {
+                std::size_t n = between(m_options.min_map_size, m_options.max_map_size);
+                if (!m_writer->StartObject())
+                    return false;
+                for (std::size_t i = 0; i < n; ++i)
+                    if (!write_key() || !write_any(depth + 1))
+                        return false;
+                return m_writer->EndObject(static_cast<SizeType>(n));
+            }
+            }
+        }
+
+        bool write_array(const Value& schema, unsigned depth)
+        {
+            const Value* items = member(schema, "items");
+            if (!items)
+                return write_any(depth);
+            if (!m_writer->StartArray())
+                return false;
+            if (items->IsArray())
+            {
+                for (auto it = items->Begin(); it != items->End(); ++it)
+                    if (!write_value(*it, depth + 1))
+                        return false;
+                return m_writer->EndArray(items->Size());
+            }
+            const Value* min_items = member(schema, "minItems");
+            const Value* max_items = member(schema, "maxItems");
+            std::size_t low = min_items ? static_cast<std::size_t>(min_items->GetUint64()) : 0;
+            std::size_t high = max_items ? static_cast<std::size_t>(max_items->GetUint64())
+                                         : std::numeric_limits<std::size_t>::max();
+            std::size_t n = low;
+            if (depth < m_options.max_depth)
+                n = std::min(high,
+                             std::max(low,
+                                      between(m_options.min_array_size, m_options.max_array_size)));
+            for (std::size_t i = 0; i < n; ++i)
+                if (!write_value(*items, depth + 1))
+                    return false;
+            return m_writer->EndArray(static_cast<SizeType>(n));
+        }
+
+        bool write_object(const Value& schema, unsigned depth)
+        {
+            const Value* properties = member(schema, "properties");
+            const Value* required = member(schema, "required");
+            const Value* additional = member(schema, "additionalProperties");
+            if (!m_writer->StartObject())
+                return false;
+            SizeType count = 0;
+            if (properties && properties->IsObject())
+            {
+                for (auto it = properties->MemberBegin(); it != properties->MemberEnd(); ++it)
+                {
+                    bool is_required = false;
+                    if (required && required->IsArray())
+                        for (auto r = required->Begin(); r != required->End() && !is_required; ++r)
+                            is_required = *r == it->name;
+                    if (!is_required
+                        && (depth >= m_options.max_depth || !chance(m_options.optional_field_rate)))
+                        continue;
+                    if (!m_writer->Key(it->name.GetString(), it->name.GetStringLength(), true)
+                        || !write_value(it->value, depth + 1))
+                        return false;
+                    ++count;
+                }
+            }
+            if (additional && additional->IsObject())
+            {
+                // A map: the schema of additional properties describes every value
+                std::size_t n = depth < m_options.max_depth
+                    ? between(m_options.min_map_size, m_options.max_map_size)
+                    : 0;
+                for (std::size_t i = 0; i < n; ++i, ++count)
+                    if (!write_key() || !write_value(*additional, depth + 1))
+                        return false;
+            }
+            else if ((!additional || !additional->IsBool() || additional->GetBool())
+                     && chance(m_options.unknown_field_rate))
+            {
+                m_text = "unknown#" + std::to_string(m_key_counter++);
+                if (!m_writer->Key(m_text.data(), static_cast<SizeType>(m_text.size()), true)
+                    || !write_any(depth + 1))
+                    return false;
+                ++count;
+            }
+            return m_writer->EndObject(count);
+        }
+
+        bool write_value(const Value& schema, unsigned depth)
+        {
+            if (const Value* alternatives = member(schema, "anyOf"))
+            {
+                if (!alternatives->IsArray() || alternatives->Empty())
+                    return write_any(depth);
+                // Nullable values are present at the same rate as optional fields
+                const Value& first = (*alternatives)[0];
+                if (alternatives->Size() == 2 && is_type(first, "null"))
+                {
+                    if (depth >= m_options.max_depth || !chance(m_options.optional_field_rate))
+                        return m_writer->Null();
+                    return write_value((*alternatives)[1], depth);
+                }
+                return write_value((*alternatives)[static_cast<SizeType>(
+                                       m_rng() % alternatives->Size())],
+                                   depth);
+            }
+            if (const Value* choices = member(schema, "enum"))
+            {
+                if (choices->IsArray() && !choices->Empty())
+                {
+                    const Value& c = (*choices)[static_cast<SizeType>(m_rng() % choices->Size())];
+                    return c.Accept(*m_writer);
+                }
+            }
+            if (is_type(schema, "null"))
+                return m_writer->Null();
+            if (is_type(schema, "boolean"))
+                return m_writer->Bool((m_rng() & 1) != 0);
+            if (is_type(schema, "integer"))
+                return write_integer(schema);
+            if (is_type(schema, "number"))
+                return write_number();
+            if (is_type(schema, "string"))
+            {
+                if (member(schema, "contentEncoding"))
+                    return write_bytes();
+                return write_text();
+            }
+            if (is_type(schema, "array"))
+                return write_array(schema, depth);
+            if (is_type(schema, "object"))
+                return write_object(schema, depth);
+            return write_any(depth);
+        }
+
+    public:
+        explicit JsonGenerator(const GeneratorOptions& options,
+                               Writer* writer,
+                               const OutputStream* stream)
+            : m_options(options)
+            , m_writer(writer)
+            , m_stream(stream)
+            , m_rng(options.seed)
+            , m_key_counter(0)
+        {
+        }
+
+        bool generate(const Value& schema)
+        {
+            if (m_options.target_size == 0)
+                return write_value(schema, 0);
+
+            // Roots that are homogeneous arrays or maps grow until the requested size
+            const Value* items = member(schema, "items");
+            const Value* additional = member(schema, "additionalProperties");
+            if (is_type(schema, "array") && items && items->IsObject()
+                && !member(schema, "maxItems"))
+            {
+                if (!m_writer->StartArray())
+                    return false;
+                SizeType n = 0;
+                for (; m_stream->count() < m_options.target_size; ++n)
+                    if (!write_value(*items, 1))
+                        return false;
+                return m_writer->EndArray(n);
+            }
+            if (is_type(schema, "object") && additional && additional->IsObject())
+            {
+                if (!m_writer->StartObject())
+                    return false;
+                SizeType n = 0;
+                for (; m_stream->count() < m_options.target_size; ++n)
+                    if (!write_key() || !write_value(*additional, 1))
+                        return false;
+                return m_writer->EndObject(n);
+            }
+            return write_value(schema, 0);
+        }
+    };
+
+    template <class OutputStream>
+    static bool generate_json_to(OutputStream& os,
+                                 const BaseHandler* handler,
+                                 const GeneratorOptions& options)
     {
-        if (!fp)
-            return false;
-        char buffer[1000];
-        rapidjson::FileWriteStream os(fp, buffer, sizeof(buffer));
-        rapidjson::Writer<rapidjson::FileWriteStream> writer(os);
-        IHandlerAdapter<decltype(writer)> adapter(&writer);
-        return handler->write(&adapter);
+        Document schema;
+        handler->generate_schema(schema, schema.GetAllocator());
+        CountingStream<OutputStream> counter(&os);
+        rapidjson::Writer<CountingStream<OutputStream>> writer(counter);
+        JsonGenerator<decltype(writer), CountingStream<OutputStream>> generator(
+            options, &writer, &counter);
+        return generator.generate(schema);
     }
 
-    std::string serialize_pretty_json_string(const BaseHandler* handler)
+    std::string generate_json(const BaseHandler* handler, const GeneratorOptions& options)
     {
         std::string result;
         StringOutputStream os;
         os.str = &result;
-        rapidjson::PrettyWriter<StringOutputStream> writer(os);
-        IHandlerAdapter<decltype(writer)> adapter(&writer);
-        handler->write(&adapter);
-        result.push_back('\n');
+        generate_json_to(os, handler, options);
         return result;
     }
 
-    bool serialize_pretty_json_file(std::FILE* fp, const BaseHandler* handler)
+    bool
+    generate_json_file(std::FILE* fp, const BaseHandler* handler, const GeneratorOptions& options)
     {
         if (!fp)
             return false;
-        char buffer[1000];
+        char buffer[65536];
         rapidjson::FileWriteStream os(fp, buffer, sizeof(buffer));
-        rapidjson::PrettyWriter<rapidjson::FileWriteStream> writer(os);
-        IHandlerAdapter<decltype(writer)> adapter(&writer);
-        bool res = handler->write(&adapter);
-        if (res)
-        {
-            putc('\n', fp);
-        }
-        return res;
+        bool success = generate_json_to(os, handler, options);
+        os.Flush();
+        return success;
+    }
+
+    // Plain data, so that touching it from operator new never triggers dynamic initialization
+    static thread_local AllocationCounter thread_allocations;
+    static std::atomic<bool> hooks_installed(false);
+
+    void record_allocation(std::size_t size)
+    {
+        ++thread_allocations.count;
+        thread_allocations.bytes += size;
     }
 
-    bool write_value(const Value& v, BaseHandler* out, ParseStatus* status)
+    void mark_allocation_hooks_installed() { hooks_installed = true; }
+
+    bool allocation_hooks_installed() { return hooks_installed; }
+
+    AllocationCounter allocations_so_far() { return thread_allocations; }
+
+    bool
+    write_value(const Value& v, BaseHandler* out, ParseStatus* status, const ParseOptions* options)
     {
-        if (!v.Accept(*static_cast<IHandler*>(out)))
+        std::unique_ptr<ParseChain> chain(
+            ParseChain::needed(status, options) ? new ParseChain(out, status, options) : nullptr);
+        if (!v.Accept(chain ? *chain->handler() : *static_cast<IHandler*>(out))
+            && !(chain && chain->stopped_early()))
         {
             if (status)
             {
                 status->set_result(rapidjson::kParseErrorTermination, 0);
                 out->reap_error(status->error_stack());
             }
+            if (chain)
+                chain->finish(0, status);
             return false;
         }
+        if (chain)
+            chain->finish(0, status);
         return true;
     }
 
@@ -727,6 +4700,99 @@ namespace nonpublic
     }
 }
 
+namespace frozen
+{
+    Image::Image() : m_mapping(nullptr), m_size(0), m_data(nullptr) {}
+
+    Image::~Image() { close(); }
+
+    void Image::close()
+    {
+#ifndef _WIN32
+        if (m_mapping)
+            ::munmap(m_mapping, m_size);
+#endif
+        m_mapping = nullptr;
+        m_owned.clear();
+        m_size = 0;
+        m_data = nullptr;
+    }
+
+    bool Image::validate()
+    {
+        std::uint64_t root, size;
+        if (m_size < header_size
+            || std::memcmp(m_data, nonpublic::frozen_magic, sizeof(nonpublic::frozen_magic)) != 0)
+            return false;
+        std::memcpy(&root, m_data + 8, sizeof(root));
+        std::memcpy(&size, m_data + 16, sizeof(size));
+        return size == m_size && Node(m_data, m_size, root).exists();
+    }
+
+    bool Image::open(const char* filename)
+    {
+        close();
+#ifdef _WIN32
+        std::string buffer;
+        nonpublic::FileGuard fg(std::fopen(filename, "rb"));
+        if (!fg.fp)
+            return false;
+        char chunk[16384];
+        std::size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), fg.fp)) > 0)
+            buffer.append(chunk, n);
+        return assign(std::move(buffer));
+#else
+        int fd = ::open(filename, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void* mapping
+            = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED)
+            return false;
+        m_mapping = mapping;
+        m_size = static_cast<std::size_t>(st.st_size);
+        m_data = static_cast<const char*>(mapping);
+        if (!validate())
+        {
+            close();
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    bool Image::assign(std::string buffer)
+    {
+        close();
+        m_owned.swap(buffer);
+        m_size = m_owned.size();
+        m_data = m_owned.data();
+        if (!validate())
+        {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    Node Image::root() const
+    {
+        if (!m_data)
+            return Node();
+        std::uint64_t root;
+        std::memcpy(&root, m_data + 8, sizeof(root));
+        return Node(m_data, m_size, root);
+    }
+}
+
 JSONHandler::JSONHandler(Value* v, MemoryPoolAllocator* a) : m_stack(), m_value(v), m_alloc(a)
 {
     m_stack.reserve(25);
@@ -888,4 +4954,103 @@ void JSONHandler::reset()
 }
 
 bool JSONHandler::write(IHandler* output) const { return m_value->Accept(*output); }
+
+MessageRouter::RecordHandler::RecordHandler(MessageRouter* router, std::string key)
+    : DiscriminatedHandler(std::move(key)), m_router(router)
+{
+}
+
+BaseHandler* MessageRouter::RecordHandler::select(const char* name, SizeType length)
+{
+    lookup.assign(name, length);
+    auto it = m_router->routes.find(lookup);
+    if (it == m_router->routes.end())
+        return nullptr;
+    m_router->current = &*it;
+    return it->second->begin();
+}
+
+bool MessageRouter::RecordHandler::write(IHandler* output) const
+{
+    if (!m_router->current)
+        return output->Null();
+    nonpublic::TaggedObjectWriter tagged_output(
+        output, key().c_str(), m_router->current->first.c_str());
+    return m_router->current->second->handler()->write(&tagged_output);
+}
+
+void MessageRouter::RecordHandler::generate_schema(Value& output, MemoryPoolAllocator& alloc) const
+{
+    output.SetObject();
+    Value any_of(rapidjson::kArrayType);
+    for (auto&& route : m_router->routes)
+    {
+        Value schema;
+        route.second->handler()->generate_schema(schema, alloc);
+        nonpublic::add_discriminator_schema(schema, key().c_str(), route.first.c_str(), alloc);
+        any_of.PushBack(schema, alloc);
+    }
+    output.AddMember(rapidjson::StringRef("anyOf"), any_of, alloc);
+}
+
+std::string MessageRouter::RecordHandler::type_name() const
+{
+    return "record with \"" + key() + "\"";
+}
+
+MessageRouter::MessageRouter(std::string envelope_key) : record(this, std::move(envelope_key)) {}
+
+MessageRouter::~MessageRouter() {}
+
+template <class InputStream>
+bool MessageRouter::route_stream(InputStream& is, ParseStatus* status, const ParseOptions* options)
+{
+    m_routed = 0;
+    while (true)
+    {
+        char c;
+        while ((c = is.Peek()) == ' ' || c == '\n' || c == '\r' || c == '\t')
+            is.Take();
+        if (c == '\0')
+            return true;
+        record.prepare_for_reuse();
+        current = nullptr;
+        if (!nonpublic::read_json<rapidjson::kParseStopWhenDoneFlag>(is, &record, status, options))
+            return false;
+        current->second->deliver();
+        ++m_routed;
+    }
+}
+
+bool MessageRouter::route(const char* str, ParseStatus* status, const ParseOptions* options)
+{
+    m_routed = 0;
+    record.prepare_for_reuse();
+    current = nullptr;
+    if (!nonpublic::parse_json_string(str, &record, status, options))
+        return false;
+    current->second->deliver();
+    m_routed = 1;
+    return true;
+}
+
+bool MessageRouter::route_ndjson(const char* str, ParseStatus* status, const ParseOptions* options)
+{
+    rapidjson::StringStream is(str);
+    return route_stream(is, status, options);
+}
+
+bool MessageRouter::route_ndjson(std::FILE* fp, ParseStatus* status, const ParseOptions* options)
+{
+    if (!fp)
+        return false;
+    char buffer[1000];
+    rapidjson::FileReadStream is(fp, buffer, sizeof(buffer));
+    return route_stream(is, status, options);
+}
+
+// The definitions behind STATICJSON_USE_EXTERN_TEMPLATES
+#define STATICJSON_INSTANTIATE_HANDLER(...) template class __VA_ARGS__;
+STATICJSON_COMMON_HANDLERS(STATICJSON_INSTANTIATE_HANDLER)
+#undef STATICJSON_INSTANTIATE_HANDLER
 }
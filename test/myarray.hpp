@@ -1,6 +1,7 @@
-#include <deque>
 #include <staticjson/staticjson.hpp>
 
+#include <utility>
+
 // This class is used to test custom conversion functions in StaticJSON.
 
 template <class T>
@@ -9,23 +10,28 @@ class Array
 private:
     T* m_data;
     size_t m_size;
+    size_t m_capacity;
 
 public:
-    explicit Array() : m_data(nullptr), m_size(0) {}
-    explicit Array(size_t size) : m_size(size) { m_data = new T[size]; }
+    explicit Array() : m_data(nullptr), m_size(0), m_capacity(0) {}
+    explicit Array(size_t size) : m_size(size), m_capacity(size) { m_data = new T[size]; }
     Array(Array&& that) noexcept
     {
         m_data = that.m_data;
         m_size = that.m_size;
+        m_capacity = that.m_capacity;
         that.m_data = nullptr;
         that.m_size = 0;
+        that.m_capacity = 0;
     }
     Array& operator=(Array&& that) noexcept
     {
         std::swap(m_data, that.m_data);
         std::swap(m_size, that.m_size);
+        std::swap(m_capacity, that.m_capacity);
         return *this;
     }
+    ~Array() { delete[] m_data; }
     const T& operator[](size_t i) const { return m_data[i]; }
     T& operator[](size_t i) { return m_data[i]; }
     size_t size() const { return m_size; }
@@ -34,6 +40,24 @@ public:
     const T& front() const { return m_data[0]; }
     T& front() { return m_data[0]; }
     bool empty() const { return m_size == 0; }
+    void clear() { m_size = 0; }
+    void reserve(size_t capacity)
+    {
+        if (capacity <= m_capacity)
+            return;
+        T* data = new T[capacity];
+        for (size_t i = 0; i < m_size; ++i)
+            data[i] = std::move(m_data[i]);
+        delete[] m_data;
+        m_data = data;
+        m_capacity = capacity;
+    }
+    void push_back(T&& value)
+    {
+        if (m_size == m_capacity)
+            reserve(m_capacity ? 2 * m_capacity : 4);
+        m_data[m_size++] = std::move(value);
+    }
 };
 
 namespace staticjson
@@ -41,25 +65,33 @@ namespace staticjson
 template <class T>
 struct Converter<Array<T>>
 {
-    typedef std::deque<T> shadow_type;
+    typedef T element_type;
 
-    static std::unique_ptr<ErrorBase> from_shadow(const shadow_type& shadow, Array<T>& value)
+    static void begin(Array<T>& value, std::size_t size_hint)
     {
-        value = Array<T>(shadow.size());
-        for (size_t i = 0; i < shadow.size(); ++i)
-        {
-            value[i] = shadow[i];
-        }
+        value.clear();
+        value.reserve(size_hint);
+    }
+
+    static std::unique_ptr<ErrorBase> append(Array<T>& value, T&& element)
+    {
+        value.push_back(std::move(element));
         return nullptr;
     }
 
-    static void to_shadow(const Array<T>& value, shadow_type& shadow)
+    static std::unique_ptr<ErrorBase> end(Array<T>&) { return nullptr; }
+
+    static std::size_t size(const Array<T>& value) { return value.size(); }
+
+    template <class Visitor>
+    static bool for_each(const Array<T>& value, Visitor visit)
     {
-        shadow.resize(value.size());
-        for (size_t i = 0; i < shadow.size(); ++i)
+        for (size_t i = 0; i < value.size(); ++i)
         {
-            shadow[i] = value[i];
+            if (!visit(value[i]))
+                return false;
         }
+        return true;
     }
 };
 }
@@ -462,3 +462,42 @@ TEST_CASE("Test for parsing tuple type (old)", "[parsing], [tuple]")
         REQUIRE(static_cast<const error::TypeMismatchError&>(*err.begin()).actual_type() == "null");
     }
 }
+
+TEST_CASE("Test for parsing pair type", "[parsing], [tuple]")
+{
+    typedef std::pair<std::string, std::vector<int>> pair_type;
+    pair_type pair;
+    staticjson::ParseStatus status;
+
+    SECTION("Test for valid pair", "[parsing], [tuple]")
+    {
+        REQUIRE(staticjson::from_json_string("[\"primes\", [2, 3, 5]]", &pair, &status));
+        REQUIRE(pair.first == "primes");
+        REQUIRE(pair.second == (std::vector<int>{2, 3, 5}));
+        REQUIRE(staticjson::to_json_string(pair) == "[\"primes\",[2,3,5]]");
+
+        std::map<std::string, std::pair<int, bool>> nested;
+        REQUIRE(staticjson::from_json_string("{\"a\": [1, true]}", &nested, &status));
+        REQUIRE(nested["a"] == std::make_pair(1, true));
+        REQUIRE(staticjson::to_json_string(nested) == "{\"a\":[1,true]}");
+    }
+
+    SECTION("Test for invalid pair", "[parsing], [tuple], [error]")
+    {
+        REQUIRE(!staticjson::from_json_string("[\"primes\"]", &pair, &status));
+        REQUIRE(status.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
+
+        REQUIRE(!staticjson::from_json_string("[\"a\", [], 3]", &pair, &status));
+        REQUIRE(status.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
+
+        REQUIRE(!staticjson::from_json_string("\"primes\"", &pair, &status));
+        REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+        REQUIRE(!staticjson::from_json_string("[\"a\", [1, \"b\"]]", &pair, &status));
+        auto it = status.begin();
+        REQUIRE(it->type() == error::TYPE_MISMATCH);
+        REQUIRE((++it)->type() == error::ARRAY_ELEMENT);
+        REQUIRE((++it)->type() == error::ARRAY_ELEMENT);
+        REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 1);
+    }
+}
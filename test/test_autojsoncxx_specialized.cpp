@@ -0,0 +1,150 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include "userdef.hpp"
+#include "userdef_specialized.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+const std::string& get_base_dir(void);
+
+// `userdef_specialized.hpp` is generated with `autojsoncxx.py --specialize` from a copy of the
+// definitions of `userdef.hpp` in another namespace, so both can be compared side by side
+namespace
+{
+std::string example(const char* name) { return get_base_dir() + "/autojsoncxx/examples/" + name; }
+
+// Parses `json` through the `ObjectHandler` `staticjson_init` sets up, bypassing the generated
+// handler of the same type
+template <class T>
+bool parse_with_object_handler(const char* json, T* value, ParseStatus* status)
+{
+    ObjectHandler h;
+    value->staticjson_init(&h);
+    return nonpublic::parse_json_string(json, &h, status);
+}
+}
+
+TEST_CASE("Specialized handlers parse and write like generic ones", "[code generator]")
+{
+    const char* const files[] = {"success/user_array.json", "success/user_array_compact.json"};
+    for (const char* file : files)
+    {
+        CAPTURE(file);
+        ParseStatus status;
+        std::vector<config::User> generic;
+        std::vector<specialized::User> users;
+        REQUIRE(from_json_file(example(file), &generic, &status));
+        REQUIRE(from_json_file(example(file), &users, &status));
+        REQUIRE(users.size() == generic.size());
+        REQUIRE(users.front().nickname == generic.front().nickname);
+        REQUIRE(users.front().block_event->date.year == generic.front().block_event->date.year);
+
+        std::string json = to_json_string(users);
+        REQUIRE(json == to_json_string(generic));
+        REQUIRE(to_pretty_json_string(users) == to_pretty_json_string(generic));
+
+        std::vector<specialized::User> again;
+        REQUIRE(from_json_string(json.c_str(), &again, &status));
+        REQUIRE(to_json_string(again) == json);
+    }
+
+    ParseStatus status;
+    std::map<std::string, specialized::User> users;
+    std::map<std::string, config::User> generic;
+    REQUIRE(from_json_file(example("success/user_map.json"), &users, &status));
+    REQUIRE(from_json_file(example("success/user_map.json"), &generic, &status));
+    REQUIRE(to_json_string(users) == to_json_string(generic));
+
+    specialized::User user;
+    config::User reference;
+    REQUIRE(to_json_string(export_json_schema(&user))
+            == to_json_string(export_json_schema(&reference)));
+}
+
+TEST_CASE("Specialized handlers validate like generic ones", "[code generator]")
+{
+    const char* const files[] = {
+        "failure/duplicate_key.json",
+        "failure/duplicate_key_user.json",
+        "failure/integer_string.json",
+        "failure/map_element_mismatch.json",
+        "failure/missing_required.json",
+        "failure/null_in_key.json",
+        "failure/out_of_range.json",
+        "failure/single_object.json",
+        "failure/unknown_field.json",
+    };
+    for (const char* file : files)
+    {
+        CAPTURE(file);
+        ParseStatus status, generic_status;
+        std::vector<specialized::User> users;
+        std::vector<config::User> generic;
+        bool success = from_json_file(example(file), &users, &status);
+        REQUIRE(success == from_json_file(example(file), &generic, &generic_status));
+        REQUIRE(status.description() == generic_status.description());
+        if (success)
+            REQUIRE(to_json_string(users) == to_json_string(generic));
+    }
+}
+
+TEST_CASE("Specialized handlers assign scalars directly", "[code generator]")
+{
+    const char* const documents[] = {
+        "{\"ratio\": 1, \"label\": \"a\"}",
+        "{\"ratio\": 0.5, \"label\": \"a\", \"enabled\": true, \"offset (ms)\": -9000000000, "
+        "\"count\": 4, \"codes\": [1, 2], \"level\": -3, \"extra\": [1, {\"x\": 2}]}",
+        "{\"ratio\": 18446744073709551615, \"label\": \"a\", \"offset (ms)\": 4294967295}",
+        "{\"ratio\": 1, \"label\": \"a\", \"label\": \"b\", \"level\": 1, \"level\": 2}",
+        "{\"ratio\": 1}",
+        "{\"label\": 1, \"ratio\": 1}",
+        "{\"ratio\": 1, \"label\": \"a\", \"count\": -1}",
+        "{\"ratio\": 1, \"label\": \"a\", \"level\": 2147483648}",
+        "{\"ratio\": 1, \"label\": \"a\", \"offset (ms)\": 1.5}",
+        "{\"ratio\": 1, \"label\": \"a\", \"enabled\": 1}",
+        "{\"ratio\": 1, \"label\": \"a\", \"codes\": [1, \"x\"]}",
+        "{\"ratio\": 1, \"label\": \"a\", \"count\": {\"x\": 1}}",
+        "[]",
+    };
+    for (const char* document : documents)
+    {
+        CAPTURE(document);
+        ParseStatus status, generic_status;
+        specialized::Sample sample, generic;
+        bool success = from_json_string(document, &sample, &status);
+        REQUIRE(success == parse_with_object_handler(document, &generic, &generic_status));
+        REQUIRE(status.description() == generic_status.description());
+        if (success)
+        {
+            REQUIRE(sample.ratio == generic.ratio);
+            REQUIRE(sample.label == generic.label);
+            REQUIRE(sample.enabled == generic.enabled);
+            REQUIRE(sample.offset == generic.offset);
+            REQUIRE(sample.count == generic.count);
+            REQUIRE(sample.codes == generic.codes);
+            REQUIRE(sample.level == generic.level);
+        }
+    }
+
+    specialized::Sample sample;
+    sample.label = "x";
+    sample.offset = -1;
+    sample.codes = {3};
+    REQUIRE(to_json_string(sample)
+            == "{\"codes\":[3],\"count\":0,\"enabled\":false,\"label\":\"x\",\"level\":0,"
+               "\"offset (ms)\":-1,\"ratio\":0.0}");
+
+    // Handlers are reusable after an error
+    std::vector<specialized::Sample> samples;
+    ParseStatus status;
+    REQUIRE(!from_json_string("[{\"ratio\": 1}]", &samples, &status));
+    REQUIRE(from_json_string("[{\"ratio\": 1, \"label\": \"m\"}]", &samples, &status));
+    REQUIRE(samples.size() == 1);
+    REQUIRE(samples[0].label == "m");
+}
@@ -0,0 +1,167 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Endpoint
+{
+    std::string host;
+    int port;
+    std::vector<std::string> tags;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("host", &host);
+        h->add_property("port", &port);
+        h->add_property("tags", &tags, Flags::Optional);
+    }
+};
+
+struct Secretive
+{
+    int a = 0;
+    int hidden = 0;
+    std::vector<int> v;
+    unsigned hidden_flags;
+
+    explicit Secretive(unsigned hidden_flags = Flags::IgnoreWrite) : hidden_flags(hidden_flags) {}
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("a", &a);
+        h->add_property("hidden", &hidden, hidden_flags);
+        h->add_property("v", &v);
+    }
+};
+
+struct OptionalSecretive : Secretive
+{
+    OptionalSecretive() : Secretive(Flags::IgnoreWrite | Flags::Optional) {}
+};
+
+void write_file(const char* filename, const std::string& content)
+{
+    nonpublic::FileGuard fg(std::fopen(filename, "wb"));
+    REQUIRE(fg.fp);
+    REQUIRE(std::fwrite(content.data(), 1, content.size(), fg.fp) == content.size());
+}
+
+bool file_exists(const std::string& filename)
+{
+    nonpublic::FileGuard fg(std::fopen(filename.c_str(), "rb"));
+    return fg.fp != nullptr;
+}
+}
+
+TEST_CASE("Snapshot cache")
+{
+    const char* filename = "snapshot_cache_test.json";
+    const std::string snapshot = std::string(filename) + ".sjc";
+    std::remove(snapshot.c_str());
+    write_file(filename,
+               "[{\"host\": \"alpha\", \"port\": 80, \"tags\": [\"a\", \"b\"]},"
+               " {\"host\": \"beta\", \"port\": 443}]");
+
+    std::vector<Endpoint> first;
+    ParseStatus status;
+    REQUIRE(from_json_file_with_cache(filename, &first, &status));
+    REQUIRE(file_exists(snapshot));
+
+    std::vector<Endpoint> second;
+    REQUIRE(from_json_file_with_cache(filename, &second, &status));
+    REQUIRE(second.size() == 2);
+    REQUIRE(second[0].host == "alpha");
+    REQUIRE(second[0].tags == (std::vector<std::string>{"a", "b"}));
+    REQUIRE(second[1].port == 443);
+
+    SECTION("A changed source invalidates the snapshot")
+    {
+        // Same length, and likely the same mtime, so only the hash tells them apart
+        write_file(filename,
+                   "[{\"host\": \"gamma\", \"port\": 80, \"tags\": [\"a\", \"b\"]},"
+                   " {\"host\": \"delta\", \"port\": 443}]");
+        std::vector<Endpoint> third;
+        REQUIRE(from_json_file_with_cache(filename, &third, &status));
+        REQUIRE(third[0].host == "gamma");
+        REQUIRE(third[1].host == "delta");
+    }
+
+    SECTION("A different type ignores the snapshot")
+    {
+        std::vector<std::map<std::string, Document>> generic;
+        REQUIRE(from_json_file_with_cache(filename, &generic, &status));
+        REQUIRE(generic.size() == 2);
+        REQUIRE(generic[1]["host"].GetString() == std::string("beta"));
+    }
+
+    SECTION("Options apply to the snapshot")
+    {
+        ParseOptions options;
+        options.limits.max_string_length = 4;
+        std::vector<Endpoint> limited;
+        REQUIRE(!from_json_file_with_cache(filename, &limited, &status, options));
+        REQUIRE(status.begin()->type() == error::LIMIT_EXCEEDED);
+
+        // A sampled parse neither uses nor replaces the snapshot
+        ParseOptions sampled;
+        sampled.sampling.max_array_elements = 1;
+        std::vector<Endpoint> sample;
+        REQUIRE(from_json_file_with_cache(filename, &sample, &status, sampled));
+        REQUIRE(sample.size() == 1);
+        std::vector<Endpoint> full;
+        REQUIRE(from_json_file_with_cache(filename, &full, &status, ParseOptions()));
+        REQUIRE(full.size() == 2);
+    }
+
+    SECTION("Errors are still reported from the JSON")
+    {
+        write_file(filename, "[{\"host\": \"alpha\", \"port\": \"eighty\"}]");
+        std::vector<Endpoint> broken;
+        REQUIRE(!from_json_file_with_cache(filename, &broken, &status));
+        REQUIRE(status.has_error());
+    }
+
+    std::remove(snapshot.c_str());
+    std::remove(filename);
+}
+
+template <class T>
+static void check_ignored_member_is_cached()
+{
+    const char* filename = "snapshot_cache_ignored.json";
+    const std::string snapshot = std::string(filename) + ".sjc";
+    std::remove(snapshot.c_str());
+    write_file(filename, "{\"a\": 1, \"hidden\": 42, \"v\": [1, 2, 3]}");
+
+    for (int i = 0; i < 2; ++i)
+    {
+        T value;
+        ParseStatus status;
+        bool success = from_json_file_with_cache(filename, &value, &status);
+        CAPTURE(i);
+        CAPTURE(status.description());
+        REQUIRE(success);
+        REQUIRE(value.a == 1);
+        REQUIRE(value.hidden == 42);
+        REQUIRE(value.v == (std::vector<int>{1, 2, 3}));
+        REQUIRE(file_exists(snapshot));
+    }
+    REQUIRE(to_json_string(T()) == "{\"a\":0,\"v\":[]}");
+
+    std::remove(snapshot.c_str());
+    std::remove(filename);
+}
+
+TEST_CASE("Snapshot cache keeps members that are not written")
+{
+    SECTION("Required") { check_ignored_member_is_cached<Secretive>(); }
+    SECTION("Optional") { check_ignored_member_is_cached<OptionalSecretive>(); }
+}
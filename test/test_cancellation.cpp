@@ -0,0 +1,84 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+std::atomic<bool> cancel_flag(false);
+
+// Raises the cancellation flag when the value 3 is parsed, as another thread would
+struct Tripwire
+{
+    int value;
+};
+}
+
+namespace staticjson
+{
+template <>
+struct Converter<Tripwire>
+{
+    typedef int shadow_type;
+
+    static std::unique_ptr<ErrorBase> from_shadow(const shadow_type& shadow, Tripwire& value)
+    {
+        value.value = shadow;
+        if (shadow == 3)
+            cancel_flag = true;
+        return nullptr;
+    }
+
+    static void to_shadow(const Tripwire& value, shadow_type& shadow) { shadow = value.value; }
+};
+}
+
+TEST_CASE("Cancellation")
+{
+    cancel_flag = false;
+    ParseOptions options;
+    options.cancel = &cancel_flag;
+    options.check_interval = 1;
+
+    std::vector<Tripwire> values;
+    ParseStatus status;
+    const char* input = "[1, 2, 3, 4, 5, 6]";
+    REQUIRE(!from_json_string(input, &values, &status, options));
+    REQUIRE(values.size() == 3);
+    REQUIRE(status.offset() == std::string(input).find('4') + 1);
+    REQUIRE(status.error_stack().size() >= 1);
+    REQUIRE(status.begin()->type() == error::PARSE_CANCELLED);
+    REQUIRE(static_cast<const error::ParseCancelledError&>(*status.begin()).offset()
+            == status.offset());
+
+    cancel_flag = false;
+    std::vector<int> plain;
+    REQUIRE(from_json_string(input, &plain, &status, options));
+    REQUIRE(plain.size() == 6);
+}
+
+TEST_CASE("Deadline")
+{
+    ParseOptions options;
+    std::vector<int> values;
+    ParseStatus status;
+
+    options.deadline = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    REQUIRE(from_json_string("[1, 2, 3]", &values, &status, options));
+
+    options.deadline = std::chrono::steady_clock::now() - std::chrono::seconds(1);
+    REQUIRE(!from_json_string("[1, 2, 3]", &values, &status, options));
+    REQUIRE(status.begin()->type() == error::DEADLINE_EXCEEDED);
+    REQUIRE(status.description().find("deadline") != std::string::npos);
+
+    status.enable_statistics();
+    options.deadline = std::chrono::steady_clock::time_point::max();
+    REQUIRE(from_json_string("[1, 2, 3]", &values, &status, options));
+    REQUIRE(status.statistics()->integers == 3);
+}
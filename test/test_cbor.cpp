@@ -0,0 +1,134 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Attachment
+{
+    std::string name;
+    Bytes content;
+    std::map<std::string, double> metrics;
+    std::vector<std::int64_t> counters;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("content", &content);
+        h->add_property("metrics", &metrics, Flags::Optional);
+        h->add_property("counters", &counters, Flags::Optional);
+    }
+};
+
+std::string hex(const std::string& bytes)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string result;
+    for (unsigned char c : bytes)
+    {
+        result.push_back(digits[c >> 4]);
+        result.push_back(digits[c & 15]);
+    }
+    return result;
+}
+}
+
+TEST_CASE("CBOR encoding of builtin types")
+{
+    REQUIRE(hex(to_cbor(0)) == "00");
+    REQUIRE(hex(to_cbor(23)) == "17");
+    REQUIRE(hex(to_cbor(1000)) == "1903e8");
+    REQUIRE(hex(to_cbor(-1000)) == "3903e7");
+    REQUIRE(hex(to_cbor(1.5)) == "fa3fc00000");
+    REQUIRE(hex(to_cbor(1.1)) == "fb3ff199999999999a");
+    REQUIRE(hex(to_cbor(std::string("IETF"))) == "6449455446");
+    REQUIRE(hex(to_cbor(std::vector<int>{1, 2, 3})) == "83010203");
+    REQUIRE(hex(to_cbor(std::map<std::string, bool>{{"a", true}})) == "a16161f5");
+    REQUIRE(hex(to_cbor(Bytes{1, 2, 3, 4})) == "4401020304");
+}
+
+TEST_CASE("CBOR round trip")
+{
+    Attachment a;
+    a.name = "blob";
+    a.content = Bytes{0, 255, 16, 32};
+    a.metrics["ratio"] = 0.25;
+    a.metrics["pi"] = 3.141592653589793;
+    a.counters = {-5000000000LL, 0, 42, 5000000000LL};
+
+    std::string encoded = to_cbor(a);
+    // Objects registered through ObjectHandler know their field count
+    REQUIRE(static_cast<unsigned char>(encoded[0]) == 0xa4);
+
+    Attachment b;
+    ParseStatus status;
+    bool success = from_cbor(encoded, &b, &status);
+    CAPTURE(status.description());
+    REQUIRE(success);
+    REQUIRE(b.name == a.name);
+    REQUIRE(b.content == a.content);
+    REQUIRE(b.metrics == a.metrics);
+    REQUIRE(b.counters == a.counters);
+}
+
+TEST_CASE("CBOR indefinite lengths and tags")
+{
+    // {_ "name": "x", "content": (_ h'01', h'0203'), "counters": [_ 1, -2]} wrapped in tag 55799
+    const unsigned char input[]
+        = {0xd9, 0xd9, 0xf7, 0xbf, 0x64, 'n',  'a',  'm',  'e',  0x61, 'x',  0x67, 'c',
+           'o',  'n',  't',  'e',  'n',  't',  0x5f, 0x41, 0x01, 0x42, 0x02, 0x03, 0xff,
+           0x68, 'c',  'o',  'u',  'n',  't',  'e',  'r',  's',  0x9f, 0x01, 0x21, 0xff, 0xff};
+    Attachment a;
+    ParseStatus status;
+    bool success = from_cbor(input, sizeof(input), &a, &status);
+    CAPTURE(status.description());
+    REQUIRE(success);
+    REQUIRE(a.name == "x");
+    REQUIRE(a.content == (Bytes{1, 2, 3}));
+    REQUIRE(a.counters == (std::vector<std::int64_t>{1, -2}));
+}
+
+TEST_CASE("CBOR errors")
+{
+    std::string encoded = to_cbor(std::vector<std::string>{"hello", "world"});
+    std::vector<std::string> strings;
+    ParseStatus status;
+    REQUIRE(!from_cbor(encoded.data(), encoded.size() - 1, &strings, &status));
+    REQUIRE(status.has_error());
+
+    std::vector<int> integers;
+    REQUIRE(!from_cbor(encoded, &integers, &status));
+    REQUIRE(status.error_code() == rapidjson::kParseErrorTermination);
+    REQUIRE(!status.error_stack().empty());
+
+    std::string nested(1000, '\x81');
+    nested.push_back('\x00');
+    Document d;
+    REQUIRE(!from_cbor(nested, &d, &status));
+    REQUIRE(status.error_stack().begin()->type() == error::TOO_DEEP_RECURSION);
+
+    // Tags are skipped without recursing, however many of them precede a value
+    std::string tagged(2000000, '\xc0');
+    tagged.push_back('\x01');
+    int i = 0;
+    bool success = from_cbor(tagged, &i, &status);
+    CAPTURE(status.description());
+    REQUIRE(success);
+    REQUIRE(i == 1);
+}
+
+TEST_CASE("Bytes in JSON")
+{
+    Bytes b{'a', 'b', 'c', 'd'};
+    REQUIRE(to_json_string(b) == "\"YWJjZA==\"");
+    Bytes c;
+    REQUIRE(from_json_string("\"YWJjZA==\"", &c, nullptr));
+    REQUIRE(b == c);
+    REQUIRE(!from_json_string("\"not base64!\"", &c, nullptr));
+}
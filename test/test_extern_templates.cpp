@@ -0,0 +1,63 @@
+#define STATICJSON_USE_EXTERN_TEMPLATES
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace staticjson;
+
+// Every handler used here comes from the instantiations in the library
+namespace
+{
+struct Inventory
+{
+    std::vector<std::string> names;
+    std::vector<int> counts;
+    std::vector<double> weights;
+    std::vector<std::uint64_t> ids;
+    std::map<std::string, std::string> labels;
+    std::unordered_map<std::string, int> stock;
+    long long total = 0;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("names", &names);
+        h->add_property("counts", &counts);
+        h->add_property("weights", &weights);
+        h->add_property("ids", &ids);
+        h->add_property("labels", &labels);
+        h->add_property("stock", &stock);
+        h->add_property("total", &total);
+    }
+};
+}
+
+TEST_CASE("Handlers of common types declared extern")
+{
+    const char* json = "{\"counts\":[1,2],\"ids\":[18446744073709551615],"
+                       "\"labels\":{\"a\":\"b\"},\"names\":[\"x\",\"y\"],\"stock\":{\"k\":3},"
+                       "\"total\":-7,\"weights\":[0.5]}";
+    ParseStatus status;
+    Inventory inventory;
+    REQUIRE(from_json_string(json, &inventory, &status));
+    REQUIRE(inventory.names == (std::vector<std::string>{"x", "y"}));
+    REQUIRE(inventory.ids[0] == 18446744073709551615ULL);
+    REQUIRE(inventory.labels.at("a") == "b");
+    REQUIRE(inventory.stock.at("k") == 3);
+    REQUIRE(inventory.total == -7);
+    REQUIRE(to_json_string(inventory) == json);
+
+    REQUIRE(!from_json_string("{\"counts\": [1, \"2\"]}", &inventory, &status));
+    auto it = status.begin();
+    REQUIRE(it->type() == error::TYPE_MISMATCH);
+    REQUIRE((++it)->type() == error::ARRAY_ELEMENT);
+
+    std::vector<std::string> names;
+    Handler<std::vector<std::string>> h(&names);
+    REQUIRE(h.type_name() == "std::vector<string>");
+}
@@ -0,0 +1,206 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+// The same types twice, once through `ObjectHandler` and once through compile-time field lists.
+// Fields are listed in key order, the order `ObjectHandler` writes members in, so the output can
+// be compared.
+namespace
+{
+struct TemplateSample
+{
+    std::vector<int> codes;
+    std::string unit;
+    double value = 0;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("codes", &codes, Flags::Optional);
+        h->add_property("unit", &unit);
+        h->add_property("value", &value);
+    }
+};
+
+struct TemplateSensor
+{
+    bool active = false;
+    std::map<std::string, int> counters;
+    std::vector<std::vector<unsigned>> grid;
+    std::int64_t id = 0;
+    TemplateSample latest;
+    std::string name;
+    float ratio = 0;
+    std::vector<TemplateSample> samples;
+    std::uint64_t serial = 0;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("active", &active, Flags::Optional);
+        h->add_property("counters", &counters, Flags::Optional);
+        h->add_property("grid", &grid, Flags::Optional);
+        h->add_property("id", &id);
+        h->add_property("latest", &latest, Flags::Optional);
+        h->add_property("name", &name);
+        h->add_property("ratio", &ratio, Flags::Optional);
+        h->add_property("samples", &samples, Flags::Optional);
+        h->add_property("serial", &serial, Flags::Optional);
+    }
+};
+
+struct FieldsSample
+{
+    std::vector<int> codes;
+    std::string unit;
+    double value = 0;
+};
+
+struct FieldsSensor
+{
+    bool active = false;
+    std::map<std::string, int> counters;
+    std::vector<std::vector<unsigned>> grid;
+    std::int64_t id = 0;
+    FieldsSample latest;
+    std::string name;
+    float ratio = 0;
+    std::vector<FieldsSample> samples;
+    std::uint64_t serial = 0;
+};
+
+struct StrictFields
+{
+    int a = 0;
+    std::string hidden = "kept";
+    std::string secret = "unwritten";
+};
+
+struct Repeated
+{
+    int a = 0;
+};
+
+const char* const sensor_json
+    = "{\"id\": -5, \"name\": \"north\", \"active\": true, \"ratio\": 0.5, "
+      "\"serial\": 18446744073709551615, \"grid\": [[1, 2], [3]], \"counters\": {\"a\": 1}, "
+      "\"latest\": {\"value\": 1.5, \"codes\": [1, 2], \"unit\": \"C\"}, "
+      "\"samples\": [{\"value\": 2.5, \"codes\": [], \"unit\": \"F\"}, "
+      "{\"unit\": \"K\", \"value\": 3, \"codes\": [7]}], "
+      "\"extra\": {\"ignored\": [1, {\"x\": null}]}}";
+}
+
+STATICJSON_FIELDS(FieldsSample,
+                  (codes, "codes", Flags::Optional),
+                  (unit, "unit"),
+                  (value, "value"))
+
+STATICJSON_FIELDS(FieldsSensor,
+                  (active, "active", Flags::Optional),
+                  (counters, "counters", Flags::Optional),
+                  (grid, "grid", Flags::Optional),
+                  (id, "id"),
+                  (latest, "latest", Flags::Optional),
+                  (name, "name"),
+                  (ratio, "ratio", Flags::Optional),
+                  (samples, "samples", Flags::Optional),
+                  (serial, "serial", Flags::Optional))
+
+STATICJSON_FIELDS_FLAGS(StrictFields,
+                        Flags::DisallowUnknownKey,
+                        (a, "a"),
+                        (hidden, "hidden", Flags::IgnoreRead | Flags::Optional),
+                        (secret, "secret", Flags::IgnoreWrite | Flags::Optional))
+
+STATICJSON_FIELDS_FLAGS(Repeated, Flags::AllowDuplicateKey, (a, "a"))
+
+TEST_CASE("Field lists parse and write like template types")
+{
+    REQUIRE(FieldList<FieldsSensor>::size == 9);
+    REQUIRE(std::string(FieldList<FieldsSensor>::field<7>::name()) == "samples");
+    REQUIRE(FieldList<FieldsSensor>::field<7>::length() == 7);
+
+    ParseStatus status;
+    FieldsSensor sensor;
+    REQUIRE(from_json_string(sensor_json, &sensor, &status));
+    REQUIRE(sensor.id == -5);
+    REQUIRE(sensor.name == "north");
+    REQUIRE(sensor.active);
+    REQUIRE(sensor.ratio == 0.5f);
+    REQUIRE(sensor.serial == 18446744073709551615ULL);
+    REQUIRE(sensor.grid == (std::vector<std::vector<unsigned>>{{1, 2}, {3}}));
+    REQUIRE(sensor.counters.at("a") == 1);
+    REQUIRE(sensor.latest.unit == "C");
+    REQUIRE(sensor.samples.size() == 2);
+    REQUIRE(sensor.samples[1].codes == std::vector<int>{7});
+
+    TemplateSensor reference;
+    REQUIRE(from_json_string(sensor_json, &reference, &status));
+    std::string json = to_json_string(sensor);
+    REQUIRE(json == to_json_string(reference));
+
+    FieldsSensor again;
+    REQUIRE(from_json_string(json.c_str(), &again, &status));
+    REQUIRE(to_json_string(again) == json);
+
+    REQUIRE(to_json_string(export_json_schema(&sensor))
+            == to_json_string(export_json_schema(&reference)));
+}
+
+TEST_CASE("Field lists report errors like template types")
+{
+    const char* const documents[] = {
+        "{\"name\": \"x\"}",
+        "{}",
+        "{\"id\": \"x\", \"name\": \"x\"}",
+        "{\"id\": 1, \"name\": \"x\", \"id\": 2}",
+        "{\"id\": 1, \"name\": \"x\", \"grid\": [[1, -2]]}",
+        "{\"id\": 1, \"name\": \"x\", \"latest\": 5}",
+        "{\"id\": 1, \"name\": \"x\", \"latest\": {\"value\": true}}",
+        "{\"id\": 1, \"name\": \"x\", \"samples\": [{\"value\": 1, \"unit\": \"K\"}, {}]}",
+        "{\"id\": 1, \"name\": \"x\", \"samples\": [{\"value\": 1, \"unit\": [1]}]}",
+        "{\"id\": 1, \"name\": \"x\", \"counters\": {\"a\": \"b\"}}",
+        "{\"id\": 1.5, \"name\": \"x\"}",
+        "[1]",
+    };
+    for (const char* document : documents)
+    {
+        CAPTURE(document);
+        ParseStatus fields_status, template_status;
+        FieldsSensor sensor;
+        TemplateSensor reference;
+        REQUIRE(!from_json_string(document, &sensor, &fields_status));
+        REQUIRE(!from_json_string(document, &reference, &template_status));
+        REQUIRE(fields_status.description() == template_status.description());
+    }
+}
+
+TEST_CASE("Field list flags")
+{
+    ParseStatus status;
+    StrictFields value;
+    REQUIRE(from_json_string("{\"a\": 1, \"hidden\": \"x\", \"secret\": \"y\"}", &value, &status));
+    REQUIRE(value.a == 1);
+    REQUIRE(value.hidden == "kept");
+    REQUIRE(value.secret == "y");
+    REQUIRE(to_json_string(value) == "{\"a\":1,\"hidden\":\"kept\"}");
+
+    REQUIRE(!from_json_string("{\"a\": 1, \"b\": 2}", &value, &status));
+    REQUIRE(status.begin()->type() == error::UNKNOWN_FIELD);
+
+    Repeated repeated;
+    REQUIRE(from_json_string("{\"a\": 1, \"a\": 2}", &repeated, &status));
+    REQUIRE(repeated.a == 2);
+
+    // Handlers are reusable after an error
+    std::vector<FieldsSample> samples;
+    REQUIRE(!from_json_string("[{\"value\": 1}]", &samples, &status));
+    REQUIRE(from_json_string("[{\"value\": 1, \"unit\": \"m\"}]", &samples, &status));
+    REQUIRE(samples.size() == 1);
+    REQUIRE(samples[0].unit == "m");
+}
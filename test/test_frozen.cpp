@@ -0,0 +1,214 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Station
+{
+    std::string name;
+    double latitude, longitude;
+    std::int64_t elevation;
+    bool active;
+    std::vector<unsigned> lines;
+    std::map<std::string, std::string> aliases;
+    std::unique_ptr<Station> parent;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("latitude", &latitude);
+        h->add_property("longitude", &longitude);
+        h->add_property("elevation", &elevation);
+        h->add_property("active", &active);
+        h->add_property("lines", &lines);
+        h->add_property("aliases", &aliases);
+        h->add_property("parent", &parent);
+    }
+};
+
+struct Platform
+{
+    std::string name;
+    std::vector<int> tracks;
+};
+
+std::vector<Station> make_stations()
+{
+    std::vector<Station> stations(2);
+    stations[0].name = "Central";
+    stations[0].latitude = 51.5;
+    stations[0].longitude = -0.125;
+    stations[0].elevation = -12;
+    stations[0].active = true;
+    stations[0].lines = {1, 4, 9};
+    stations[0].aliases["fr"] = "Centrale";
+    stations[0].aliases["de"] = "Zentral";
+    stations[1].name = "North";
+    stations[1].active = false;
+    stations[1].elevation = 3000000000LL;
+    stations[1].parent.reset(new Station());
+    stations[1].parent->name = "Central";
+    return stations;
+}
+
+void check_stations(const frozen::View<std::vector<Station>>& stations)
+{
+    REQUIRE(stations.size() == 2);
+    frozen::View<Station> central = stations[0];
+    REQUIRE(central.get<std::string>("name") == "Central");
+    REQUIRE(central.get<double>("latitude").get() == 51.5);
+    REQUIRE(central.get<float>("longitude").get() == -0.125f);
+    REQUIRE(central.get<int>("elevation").get() == -12);
+    REQUIRE(central.get<bool>("active").get());
+    REQUIRE(!central.has("missing"));
+
+    auto lines = central.get<std::vector<unsigned>>("lines");
+    std::vector<unsigned> copied;
+    for (auto line : lines)
+        copied.push_back(line);
+    REQUIRE(copied == (std::vector<unsigned>{1, 4, 9}));
+
+    auto aliases = central.get<std::map<std::string, std::string>>("aliases");
+    REQUIRE(aliases.size() == 2);
+    REQUIRE(aliases.find("de") == "Zentral");
+    REQUIRE(aliases.key_at(1) == "fr");
+    REQUIRE(!aliases.contains("es"));
+    REQUIRE(!central.get<std::unique_ptr<Station>>("parent"));
+
+    frozen::View<Station> north = stations[1];
+    REQUIRE(north.get<std::int64_t>("elevation").get() == 3000000000LL);
+    REQUIRE(!north.get<bool>("active").get());
+    auto parent = north.get<std::unique_ptr<Station>>("parent");
+    REQUIRE(bool(parent));
+    REQUIRE((*parent).get<std::string>("name") == "Central");
+
+    // Views of the wrong type are empty
+    REQUIRE(!central.get<double>("name").node().exists());
+    REQUIRE(central.get<double>("name").get() == 0);
+    REQUIRE(central.get<std::string>("latitude").empty());
+    REQUIRE(central.get<bool>("elevation").node().kind() == frozen::Kind::Null);
+    REQUIRE(central.get<std::vector<unsigned>>("aliases").empty());
+    REQUIRE(!central.get<Station>("lines").has("name"));
+}
+}
+
+STATICJSON_FIELDS(Platform, (name, "name"), (tracks, "tracks"))
+
+TEST_CASE("Frozen image in memory")
+{
+    std::string image_bytes = freeze(make_stations());
+    REQUIRE(image_bytes.size() % 8 == 0);
+
+    frozen::Image image;
+    REQUIRE(image.assign(image_bytes));
+    check_stations(image.root_as<std::vector<Station>>());
+
+    // Offsets are relative, so a copy at any other address works as well
+    frozen::Image relocated;
+    REQUIRE(relocated.assign(std::string(image.data(), image.size())));
+    check_stations(relocated.root_as<std::vector<Station>>());
+
+    frozen::Image corrupted;
+    REQUIRE(!corrupted.assign(image_bytes.substr(0, image_bytes.size() - 8)));
+    REQUIRE(!corrupted.valid());
+}
+
+TEST_CASE("Frozen image mapped from file")
+{
+    const char* filename = "frozen_test.bin";
+    REQUIRE(freeze_to_file(filename, make_stations()));
+    {
+        frozen::Image image;
+        REQUIRE(image.open(filename));
+        check_stations(image.root_as<std::vector<Station>>());
+
+        // Untyped access works on any image
+        frozen::Node root = image.root();
+        REQUIRE(root.kind() == frozen::Kind::Array);
+        REQUIRE(root[0].find("lines")[2].as_uint64() == 9);
+    }
+    std::remove(filename);
+}
+
+TEST_CASE("Frozen image of unsorted keys")
+{
+    Document d;
+    d.Parse("{\"zeta\": 1, \"alpha\": [true, null, \"x\"], \"mu\": {\"b\": 2.5, \"a\": -3}}");
+    frozen::Image image;
+    REQUIRE(image.assign(freeze(d)));
+    frozen::View<Document> root = image.root_as<Document>();
+    REQUIRE(root.size() == 3);
+    REQUIRE(root.key_at(0) == "alpha");
+    REQUIRE(root.find("zeta").as_int64() == 1);
+    REQUIRE(root.find("alpha")[1].is_null());
+    REQUIRE(root.find("alpha")[2].as_string() == "x");
+    REQUIRE(root.find("mu").find("a").as_int64() == -3);
+    REQUIRE(root.find("mu").find("b").as_double() == 2.5);
+}
+
+TEST_CASE("Frozen view typed by fields")
+{
+    Platform platform;
+    platform.name = "East";
+    platform.tracks = {3, 4};
+    frozen::Image image;
+    REQUIRE(image.assign(freeze(platform)));
+    frozen::View<Platform> root = image.root_as<Platform>();
+    auto tracks = root.field<1>();
+    static_assert(std::is_same<decltype(tracks), frozen::View<std::vector<int>>>::value,
+                  "member view typed by its declaration");
+    REQUIRE(root.field<0>() == "East");
+    REQUIRE(tracks.size() == 2);
+    REQUIRE(tracks[1].get() == 4);
+}
+
+TEST_CASE("Frozen image with corrupted offsets")
+{
+    Document d;
+    d.Parse("{\"a\": [1, 2], \"b\": \"text\"}");
+    std::string bytes = freeze(d);
+    std::uint64_t root, far = bytes.size() + 64;
+    std::memcpy(&root, bytes.data() + 8, sizeof(root));
+    frozen::Image image;
+
+    // The value of "a" points past the end of the image
+    std::string broken = bytes;
+    std::memcpy(&broken[root + 16], &far, sizeof(far));
+    REQUIRE(image.assign(broken));
+    REQUIRE(!image.root().find("a").exists());
+    REQUIRE(image.root().find("b").as_string() == "text");
+
+    // The length of "b" runs past the end of the image
+    broken = bytes;
+    std::uint64_t text;
+    std::uint32_t length = 1u << 30;
+    std::memcpy(&text, broken.data() + root + 32, sizeof(text));
+    std::memcpy(&broken[text + 4], &length, sizeof(length));
+    REQUIRE(image.assign(broken));
+    REQUIRE(!image.root().find("b").exists());
+    REQUIRE(image.root().find("a")[1].as_int64() == 2);
+    REQUIRE(!image.root().find("a")[2].exists());
+
+    // An unknown kind
+    broken = bytes;
+    std::uint32_t kind = 99;
+    std::memcpy(&broken[text], &kind, sizeof(kind));
+    REQUIRE(image.assign(broken));
+    REQUIRE(!image.root().find("b").exists());
+
+    broken = bytes;
+    std::memcpy(&broken[8], &far, sizeof(far));
+    REQUIRE(!image.assign(broken));
+}
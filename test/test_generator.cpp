@@ -0,0 +1,131 @@
+#include <staticjson/document.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+enum class Color
+{
+    Red,
+    Green,
+    Blue
+};
+}
+
+STATICJSON_DECLARE_ENUM(Color, {"red", Color::Red}, {"green", Color::Green}, {"blue", Color::Blue})
+
+namespace
+{
+struct Point
+{
+    int x, y;
+    Color color;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("x", &x);
+        h->add_property("y", &y);
+        h->add_property("color", &color, Flags::Optional);
+        h->set_flags(Flags::DisallowUnknownKey);
+    }
+};
+
+struct Shape
+{
+    std::string name;
+    std::vector<Point> points;
+    std::array<double, 3> transform;
+    std::map<std::string, std::uint64_t> counters;
+    std::tuple<bool, std::string, float> extra;
+    std::unique_ptr<Point> anchor;
+    std::vector<unsigned> small_numbers;
+    Bytes thumbnail;
+    Document metadata;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("points", &points);
+        h->add_property("transform", &transform);
+        h->add_property("counters", &counters, Flags::Optional);
+        h->add_property("extra", &extra, Flags::Optional);
+        h->add_property("anchor", &anchor, Flags::Optional);
+        h->add_property("small_numbers", &small_numbers, Flags::Optional);
+        h->add_property("thumbnail", &thumbnail, Flags::Optional);
+        h->add_property("metadata", &metadata, Flags::Optional);
+    }
+};
+}
+
+TEST_CASE("Generated JSON is accepted by the handler")
+{
+    GeneratorOptions options;
+    options.unknown_field_rate = 0.5;
+    options.max_string_length = 32;
+    for (std::uint64_t seed = 0; seed < 50; ++seed)
+    {
+        options.seed = seed;
+        options.optional_field_rate = (seed % 5) / 4.0;
+        std::string json = generate_json<std::vector<Shape>>(options);
+        std::vector<Shape> shapes;
+        ParseStatus status;
+        bool success = from_json_string(json.c_str(), &shapes, &status);
+        CAPTURE(json);
+        CAPTURE(status.description());
+        REQUIRE(success);
+    }
+}
+
+TEST_CASE("Generator knobs")
+{
+    GeneratorOptions options;
+    options.seed = 3;
+    REQUIRE(generate_json<Shape>(options) == generate_json<Shape>(options));
+
+    options.optional_field_rate = 0;
+    options.min_array_size = options.max_array_size = 2;
+    Shape shape;
+    REQUIRE(from_json_string(generate_json<Shape>(options).c_str(), &shape, nullptr));
+    REQUIRE(shape.points.size() == 2);
+    REQUIRE(!shape.anchor);
+    REQUIRE(shape.counters.empty());
+
+    options.min_string_length = options.max_string_length = 5;
+    std::vector<std::string> strings;
+    REQUIRE(from_json_string(
+        generate_json<std::vector<std::string>>(options).c_str(), &strings, nullptr));
+    REQUIRE(strings.size() == 2);
+
+    options.target_size = 100000;
+    std::string big = generate_json<std::map<std::string, Point>>(options);
+    REQUIRE(big.size() >= options.target_size);
+    std::map<std::string, Point> points;
+    REQUIRE(from_json_string(big.c_str(), &points, nullptr));
+    REQUIRE(points.size() > 100);
+}
+
+TEST_CASE("Generator streams to a file")
+{
+    const char* filename = "generator_test.json";
+    GeneratorOptions options;
+    options.target_size = 1 << 20;
+    REQUIRE(generate_json_file<std::vector<Point>>(filename, options));
+    std::vector<Point> points;
+    ParseStatus status;
+    bool success = from_json_file(filename, &points, &status);
+    CAPTURE(status.description());
+    REQUIRE(success);
+    REQUIRE(points.size() > 10000);
+    std::remove(filename);
+}
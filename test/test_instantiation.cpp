@@ -16,6 +16,7 @@ void instantiate_all_types()
     INSTANTIATE(std::int64_t)
     INSTANTIATE(std::uint64_t)
     INSTANTIATE(std::string)
+    INSTANTIATE(staticjson::Bytes)
     typedef std::array<long long, 10> my_array;
     INSTANTIATE(my_array)
     INSTANTIATE(std::vector<float>)
@@ -0,0 +1,269 @@
+#include <staticjson/allocation_hooks.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Record
+{
+    int id;
+    std::string name;
+    std::vector<std::string> tags;
+    std::map<std::string, int> scores;
+    std::unique_ptr<Record> next;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("id", &id);
+        h->add_property("a rather long key that does not fit inline", &name);
+        h->add_property("tags", &tags, Flags::Optional);
+        h->add_property("scores", &scores, Flags::Optional);
+        h->add_property("next", &next, Flags::Optional);
+    }
+};
+}
+
+TEST_CASE("Allocation accounting")
+{
+    const char* input = "{\"id\": 1, \"a rather long key that does not fit inline\": \"x\","
+                        " \"tags\": [\"a string long enough to need the heap\", \"b\"],"
+                        " \"next\": {\"id\": 2, \"a rather long key that does not fit inline\": "
+                        "\"y\"}}";
+    Record r;
+    AllocationStats stats;
+    ParseStatus status;
+    REQUIRE(from_json_string(input, &r, &status, &stats));
+    REQUIRE(stats.instrumented);
+    REQUIRE(stats.handler_construction.count > 0);
+    REQUIRE(stats.handler_construction.bytes > 0);
+    REQUIRE(stats.parse.count > 0);
+    REQUIRE(r.next->id == 2);
+
+    AllocationStats empty_stats;
+    Record empty;
+    REQUIRE(from_json_string("{\"id\": 1, \"a rather long key that does not fit inline\": \"\"}",
+                             &empty,
+                             &status,
+                             &empty_stats));
+    // Same handler tree; the second input needs less storage in the result
+    REQUIRE(empty_stats.handler_construction.count == stats.handler_construction.count);
+    REQUIRE(empty_stats.parse.bytes < stats.parse.bytes);
+
+    AllocationStats write_stats;
+    std::string output = to_json_string(r, &write_stats);
+    REQUIRE(output == to_json_string(r));
+    REQUIRE(write_stats.serialize.count > 0);
+}
+
+TEST_CASE("Handler footprint")
+{
+    Record r;
+    HandlerFootprint footprint = handler_footprint(&r);
+    // The object, its five fields, the vector and map elements; the pointee is created lazily
+    REQUIRE(footprint.handlers == 8);
+    REQUIRE(footprint.maps == 1);
+    REQUIRE(footprint.map_entries == 5);
+    REQUIRE(footprint.bytes > sizeof(Handler<Record>) + 5 * sizeof(std::string));
+
+    std::vector<Record> records;
+    HandlerFootprint vector_footprint = handler_footprint(&records);
+    REQUIRE(vector_footprint.handlers == footprint.handlers + 1);
+    REQUIRE(vector_footprint.maps == 1);
+}
+
+namespace
+{
+struct Point
+{
+    int x = 0, y = 0;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("x", &x);
+        h->add_property("y", &y);
+    }
+};
+
+struct Pooled
+{
+    int value = 0;
+
+    void staticjson_init(ObjectHandler* h) { h->add_property("value", &value); }
+};
+
+struct TablePoint
+{
+    int x = 0, y = 0;
+};
+
+struct FieldsPoint
+{
+    int x = 0, y = 0;
+};
+
+int pooled_created = 0;
+
+std::string points(int count)
+{
+    std::string result = "[";
+    for (int i = 0; i < count; ++i)
+        result += (i ? ", " : "") + std::string("{\"x\": 1, \"y\": 2}");
+    return result + "]";
+}
+
+std::size_t pointer_parse_allocations(int count)
+{
+    std::vector<std::shared_ptr<Point>> result;
+    result.reserve(count);
+    AllocationStats stats;
+    ParseStatus status;
+    REQUIRE(from_json_string(points(count).c_str(), &result, &status, &stats));
+    REQUIRE(result.size() == static_cast<std::size_t>(count));
+    REQUIRE(result.back()->y == 2);
+    return stats.parse.count;
+}
+}
+
+STATICJSON_DECLARE_TABLE(TablePoint,
+                         Flags::Default,
+                         table_field("x", &TablePoint::x),
+                         table_field("y", &TablePoint::y))
+
+STATICJSON_FIELDS(FieldsPoint, (x, "x"), (y, "y"))
+
+namespace staticjson
+{
+template <>
+struct PointeeAllocator<Pooled>
+{
+    static std::shared_ptr<Pooled> make_shared(Pooled&& value)
+    {
+        ++pooled_created;
+        return std::make_shared<Pooled>(std::move(value));
+    }
+
+    static Pooled* create(Pooled&& value)
+    {
+        ++pooled_created;
+        return new Pooled(std::move(value));
+    }
+};
+}
+
+TEST_CASE("Smart pointer pointees")
+{
+    // One allocation per pointee, pointee and control block together
+    REQUIRE(pointer_parse_allocations(200) - pointer_parse_allocations(100) == 100);
+
+    pooled_created = 0;
+    std::vector<std::shared_ptr<Pooled>> shared;
+    std::vector<std::unique_ptr<Pooled>> unique;
+    ParseStatus status;
+    REQUIRE(from_json_string("[{\"value\": 1}, null, {\"value\": 3}]", &shared, &status));
+    REQUIRE(from_json_string("[{\"value\": 4}]", &unique, &status));
+    REQUIRE(pooled_created == 3);
+    REQUIRE(shared[0]->value == 1);
+    REQUIRE(!shared[1]);
+    REQUIRE(shared[2]->value == 3);
+    REQUIRE(unique[0]->value == 4);
+
+    // A pointee is only assigned once complete
+    std::shared_ptr<Pooled> single;
+    REQUIRE(!from_json_string("{\"value\": \"x\"}", &single, &status));
+    REQUIRE(!single);
+    REQUIRE(from_json_string("{\"value\": 5}", &single, &status));
+    REQUIRE(single->value == 5);
+    REQUIRE(to_json_string(single) == "{\"value\":5}");
+    REQUIRE(pooled_created == 4);
+
+    Record chain;
+    REQUIRE(from_json_string("{\"id\": 1, \"a rather long key that does not fit inline\": \"a\","
+                             " \"next\": {\"id\": 2, \"a rather long key that does not fit "
+                             "inline\": \"b\", \"next\": {\"id\": 3, \"a rather long key that "
+                             "does not fit inline\": \"c\"}}}",
+                             &chain,
+                             &status));
+    REQUIRE(chain.next->next->id == 3);
+    REQUIRE(!chain.next->next->next);
+}
+
+TEST_CASE("Tuple handlers are built inline")
+{
+    typedef std::tuple<double, std::string, int> Triple;
+    Triple triple;
+    AllocationStats stats;
+    ParseStatus status;
+    REQUIRE(from_json_string("[1.5, \"s\", 3]", &triple, &status, &stats));
+    REQUIRE(stats.handler_construction.count == 0);
+    REQUIRE(std::get<1>(triple) == "s");
+    REQUIRE(std::get<2>(triple) == 3);
+
+    HandlerFootprint footprint = handler_footprint(&triple);
+    REQUIRE(footprint.handlers == 4);
+    REQUIRE(footprint.bytes == sizeof(Handler<Triple>));
+
+    std::vector<std::pair<std::string, double>> pairs;
+    AllocationStats pair_stats;
+    REQUIRE(from_json_string("[[\"a\", 1], [\"b\", 2.5]]", &pairs, &status, &pair_stats));
+    REQUIRE(pair_stats.handler_construction.count == 0);
+    REQUIRE(pairs.size() == 2);
+    REQUIRE(pairs[1].first == "b");
+    REQUIRE(pairs[1].second == 2.5);
+    REQUIRE(to_json_string(pairs) == "[[\"a\",1.0],[\"b\",2.5]]");
+    Handler<std::pair<std::string, double>> pair_handler(&pairs[0]);
+    REQUIRE(pair_handler.type_name() == "std::pair<string, double>");
+
+    REQUIRE(!from_json_string("[[\"a\", \"b\"]]", &pairs, &status));
+    auto it = status.begin();
+    REQUIRE(it->type() == error::TYPE_MISMATCH);
+    REQUIRE((++it)->type() == error::ARRAY_ELEMENT);
+    REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 1);
+}
+
+TEST_CASE("Table-driven handlers allocate once")
+{
+    std::size_t allocations[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        std::vector<TablePoint> result;
+        result.reserve(200);
+        AllocationStats stats;
+        ParseStatus status;
+        REQUIRE(from_json_string(points(100 * (i + 1)).c_str(), &result, &status, &stats));
+        REQUIRE(stats.handler_construction.count == 0);
+        REQUIRE(result.back().y == 2);
+        allocations[i] = stats.parse.count;
+    }
+    REQUIRE(allocations[0] == allocations[1]);
+
+    TablePoint point;
+    HandlerFootprint footprint = handler_footprint(&point);
+    REQUIRE(footprint.handlers == 1);
+    REQUIRE(footprint.bytes == sizeof(Handler<TablePoint>));
+}
+
+TEST_CASE("Field list handlers hold their members inline")
+{
+    std::vector<FieldsPoint> result;
+    AllocationStats stats;
+    ParseStatus status;
+    REQUIRE(from_json_string(points(100).c_str(), &result, &status, &stats));
+    REQUIRE(stats.handler_construction.count == 0);
+    REQUIRE(result.back().y == 2);
+
+    FieldsPoint point;
+    HandlerFootprint footprint = handler_footprint(&point);
+    REQUIRE(footprint.handlers == 3);
+    REQUIRE(footprint.maps == 0);
+    REQUIRE(footprint.bytes == sizeof(Handler<FieldsPoint>));
+}
@@ -0,0 +1,113 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+const ErrorBase& top_error(const ParseStatus& status)
+{
+    REQUIRE(status.begin() != status.end());
+    return *status.begin();
+}
+
+std::string limit_name(const ParseStatus& status)
+{
+    REQUIRE(top_error(status).type() == error::LIMIT_EXCEEDED);
+    return static_cast<const error::LimitExceededError&>(top_error(status)).limit_name();
+}
+}
+
+TEST_CASE("Depth limit")
+{
+    ParseOptions options;
+    options.limits.max_depth = 3;
+    ParseStatus status;
+
+    std::vector<std::vector<std::vector<int>>> nested;
+    REQUIRE(from_json_string("[[[1]], [[2, 3]]]", &nested, &status, options));
+    REQUIRE(nested[1][0][1] == 3);
+
+    Document d;
+    REQUIRE(!from_json_string("[[[[1]]]]", &d, &status, options));
+    REQUIRE(top_error(status).type() == error::TOO_DEEP_RECURSION);
+
+    // Far deeper than the recursive parser could handle without limits
+    std::string deep(1000000, '[');
+    deep += std::string(1000000, ']');
+    REQUIRE(!from_json_string(deep.c_str(), &d, &status, options));
+    REQUIRE(top_error(status).type() == error::TOO_DEEP_RECURSION);
+    REQUIRE(status.offset() == 4);
+}
+
+TEST_CASE("String and container limits")
+{
+    ParseOptions options;
+    options.limits.max_string_length = 4;
+    options.limits.max_container_size = 3;
+    ParseStatus status;
+
+    std::vector<std::string> strings;
+    REQUIRE(from_json_string("[\"abcd\", \"\", \"x\"]", &strings, &status, options));
+    REQUIRE(!from_json_string("[\"abcde\"]", &strings, &status, options));
+    REQUIRE(limit_name(status) == "max_string_length");
+    REQUIRE(!from_json_string("[\"a\", \"b\", \"c\", \"d\"]", &strings, &status, options));
+    REQUIRE(limit_name(status) == "max_container_size");
+
+    std::map<std::string, int> map;
+    REQUIRE(!from_json_string("{\"a\": 1, \"b\": 2, \"c\": 3, \"d\": 4}", &map, &status, options));
+    REQUIRE(limit_name(status) == "max_container_size");
+    REQUIRE(map.size() == 3);
+    REQUIRE(!from_json_string("{\"abcde\": 1}", &map, &status, options));
+    REQUIRE(limit_name(status) == "max_string_length");
+
+    // A CBOR array announcing more elements than allowed fails before any of them is read
+    std::string cbor = to_cbor(std::vector<int>{1, 2, 3, 4});
+    std::vector<int> ints;
+    REQUIRE(!from_cbor(cbor.data(), cbor.size(), &ints, &status, options));
+    REQUIRE(limit_name(status) == "max_container_size");
+    REQUIRE(status.offset() == 1);
+    REQUIRE(ints.empty());
+    REQUIRE(!from_cbor(cbor, &ints, &status, options));
+    REQUIRE(limit_name(status) == "max_container_size");
+
+    Document d;
+    d.Parse("[1, 2, 3, 4]");
+    REQUIRE(!from_json_value(d, &ints, &status, options));
+    REQUIRE(limit_name(status) == "max_container_size");
+}
+
+TEST_CASE("Allocation budget")
+{
+    ParseOptions options;
+    options.limits.max_allocation = 1000;
+    ParseStatus status;
+
+    std::vector<std::string> strings;
+    REQUIRE(from_json_string("[\"abc\", \"def\"]", &strings, &status, options));
+
+    std::string big = "[\"" + std::string(600, 'x') + "\", \"" + std::string(600, 'y') + "\"]";
+    std::vector<std::string> big_strings;
+    REQUIRE(!from_json_string(big.c_str(), &big_strings, &status, options));
+    REQUIRE(limit_name(status) == "max_allocation");
+    REQUIRE(big_strings.size() == 1);
+
+    std::vector<double> doubles;
+    std::string many = "[0";
+    for (int i = 0; i < 200; ++i)
+        many += ", 1";
+    many += "]";
+    REQUIRE(!from_json_string(many.c_str(), &doubles, &status, options));
+    REQUIRE(limit_name(status) == "max_allocation");
+    REQUIRE(doubles.size() == 1000 / sizeof(double));
+
+    // The budget only applies to the parse it was given to
+    std::vector<double> unlimited;
+    REQUIRE(from_json_string(many.c_str(), &unlimited, &status));
+    REQUIRE(unlimited.size() == 201);
+}
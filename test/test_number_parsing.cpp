@@ -0,0 +1,219 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+std::uint64_t bits_of(double d)
+{
+    std::uint64_t b;
+    std::memcpy(&b, &d, sizeof(b));
+    return b;
+}
+
+std::uint32_t bits_of(float f)
+{
+    std::uint32_t b;
+    std::memcpy(&b, &f, sizeof(b));
+    return b;
+}
+
+double parsed_double(const std::string& text)
+{
+    double d = std::nan("");
+    REQUIRE(nonpublic::parse_double(text.data(), text.size(), &d));
+    return d;
+}
+
+float parsed_float(const std::string& text)
+{
+    float f = std::nanf("");
+    REQUIRE(nonpublic::parse_float(text.data(), text.size(), &f));
+    return f;
+}
+
+// Random JSON number text with up to 25 significant digits and a wide exponent range
+std::string random_number_text(std::mt19937_64& rng, int max_exponent)
+{
+    std::string text;
+    if (rng() % 2)
+        text += '-';
+    int integer_digits = 1 + static_cast<int>(rng() % 12);
+    text += static_cast<char>('1' + rng() % 9);
+    for (int i = 1; i < integer_digits; ++i)
+        text += static_cast<char>('0' + rng() % 10);
+    int fraction_digits = static_cast<int>(rng() % 14);
+    if (fraction_digits > 0)
+    {
+        text += '.';
+        for (int i = 0; i < fraction_digits; ++i)
+            text += static_cast<char>('0' + rng() % 10);
+    }
+    if (rng() % 4 != 0)
+    {
+        int span = 2 * max_exponent + 1;
+        text += 'e' + std::to_string(static_cast<int>(rng() % span) - max_exponent);
+    }
+    return text;
+}
+}
+
+TEST_CASE("Double parsing edge cases")
+{
+    const char* cases[] = {"0",
+                           "-0",
+                           "0.0",
+                           "1",
+                           "0.1",
+                           "0.3",
+                           "1e23",
+                           "8.988465674311579e307",
+                           "1.7976931348623157e308",
+                           "2.2250738585072011e-308",
+                           "2.2250738585072014e-308",
+                           "4.9406564584124654e-324",
+                           "2.4703282292062328e-324",
+                           "9007199254740993",
+                           "9007199254740992.5",
+                           "1.00000000000000011102230246251565404236316680908203125",
+                           "7.3177701707893310e+15",
+                           "123456789012345678901234567890",
+                           "0.000000000000000000000000000000000001",
+                           "1e-400"};
+    for (const char* text : cases)
+    {
+        INFO(text);
+        REQUIRE(bits_of(parsed_double(text)) == bits_of(std::strtod(text, nullptr)));
+    }
+    REQUIRE(std::signbit(parsed_double("-0.0")));
+
+    double d;
+    REQUIRE(!nonpublic::parse_double("1e400", 5, &d));
+    REQUIRE(!nonpublic::parse_double("1.", 2, &d));
+    REQUIRE(!nonpublic::parse_double("e5", 2, &d));
+}
+
+TEST_CASE("Randomized double round trip")
+{
+    std::mt19937_64 rng(20211017);
+    char buffer[64];
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::uint64_t b = rng();
+        double d;
+        std::memcpy(&d, &b, sizeof(d));
+        if (!std::isfinite(d))
+            continue;
+        std::snprintf(buffer, sizeof(buffer), "%.17g", d);
+        if (bits_of(parsed_double(buffer)) != b)
+            FAIL(buffer);
+    }
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::string text = random_number_text(rng, 330);
+        double expected = std::strtod(text.c_str(), nullptr);
+        double d;
+        bool ok = nonpublic::parse_double(text.data(), text.size(), &d);
+        if (std::isinf(expected))
+            REQUIRE(!ok);
+        else if (!ok || bits_of(d) != bits_of(expected))
+            FAIL(text);
+    }
+}
+
+TEST_CASE("Randomized float round trip")
+{
+    std::mt19937_64 rng(1017);
+    char buffer[64];
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::uint32_t b = static_cast<std::uint32_t>(rng());
+        float f;
+        std::memcpy(&f, &b, sizeof(f));
+        if (!std::isfinite(f))
+            continue;
+        std::snprintf(buffer, sizeof(buffer), "%.9g", f);
+        if (bits_of(parsed_float(buffer)) != b)
+            FAIL(buffer);
+    }
+    for (int i = 0; i < 200000; ++i)
+    {
+        std::string text = random_number_text(rng, 50);
+        float expected = std::strtof(text.c_str(), nullptr);
+        float f;
+        bool ok = nonpublic::parse_float(text.data(), text.size(), &f);
+        if (std::isinf(expected))
+            REQUIRE(!ok);
+        else if (!ok || bits_of(f) != bits_of(expected))
+            FAIL(text);
+    }
+}
+
+TEST_CASE("Full precision parsing through handlers")
+{
+    std::mt19937_64 rng(42);
+    std::vector<double> doubles;
+    std::vector<float> floats;
+    std::string double_json = "[", float_json = "[";
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string text = random_number_text(rng, 290);
+        doubles.push_back(std::strtod(text.c_str(), nullptr));
+        double_json += (i ? ", " : "") + text;
+
+        // Integers go through the exactness checks of Handler<float> instead
+        text = random_number_text(rng, 20);
+        if (nonpublic::is_integer_text(text.data(), text.size()))
+            text += ".5";
+        floats.push_back(std::strtof(text.c_str(), nullptr));
+        float_json += (i ? ", " : "") + text;
+    }
+    double_json += "]";
+    float_json += "]";
+
+    std::vector<double> parsed_doubles;
+    std::vector<float> parsed_floats;
+    ParseStatus status;
+    REQUIRE(from_json_string<rapidjson::kParseFullPrecisionFlag>(
+        double_json.c_str(), &parsed_doubles, &status));
+    REQUIRE(from_json_string<rapidjson::kParseFullPrecisionFlag>(
+        float_json.c_str(), &parsed_floats, &status));
+    for (std::size_t i = 0; i < doubles.size(); ++i)
+    {
+        REQUIRE(bits_of(parsed_doubles[i]) == bits_of(doubles[i]));
+        REQUIRE(bits_of(parsed_floats[i]) == bits_of(floats[i]));
+    }
+
+    std::vector<std::int64_t> integers;
+    REQUIRE(from_json_string<rapidjson::kParseFullPrecisionFlag>(
+        "[-9223372036854775808, -2147483648, 0, 9223372036854775807]", &integers, &status));
+    REQUIRE(integers.front() == std::numeric_limits<std::int64_t>::min());
+    REQUIRE(integers.back() == std::numeric_limits<std::int64_t>::max());
+
+    float f;
+    REQUIRE(!from_json_string<rapidjson::kParseFullPrecisionFlag>("1e39", &f, &status));
+    REQUIRE(status.error_code() == rapidjson::kParseErrorNumberTooBig);
+    REQUIRE(status.begin()->type() == error::NUMBER_OUT_OF_RANGE);
+    REQUIRE(static_cast<const error::NumberOutOfRangeError&>(*status.begin()).expected_type()
+            == "float");
+
+    // Doubles out of range are reported as the parser reports them without the flag
+    double d;
+    REQUIRE(!from_json_string("1e400", &d, &status));
+    REQUIRE(status.error_code() == rapidjson::kParseErrorNumberTooBig);
+    REQUIRE(!from_json_string<rapidjson::kParseFullPrecisionFlag>("1e400", &d, &status));
+    REQUIRE(status.error_code() == rapidjson::kParseErrorNumberTooBig);
+    REQUIRE(!from_json_string<rapidjson::kParseFullPrecisionFlag>(
+        "[1, -1e400]", &parsed_doubles, &status));
+    REQUIRE(status.error_code() == rapidjson::kParseErrorNumberTooBig);
+}
@@ -0,0 +1,187 @@
+#include <staticjson/cbor.hpp>
+#include <staticjson/document.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Telemetry
+{
+    std::vector<double> samples;
+    std::deque<long> levels;
+    std::vector<char> flags;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("samples", &samples);
+        h->add_property("levels", &levels);
+        h->add_property("flags", &flags);
+    }
+};
+
+template <class T>
+bool is_numeric_handler()
+{
+    typedef typename T::value_type ElementType;
+    return std::is_base_of<NumericArrayHandler<T>, Handler<T>>::value
+        && !std::is_base_of<ArrayHandler<T>, Handler<T>>::value
+        && nonpublic::is_numeric_element<ElementType>::value;
+}
+}
+
+TEST_CASE("Numeric arrays are handled without per-element handlers")
+{
+    REQUIRE(is_numeric_handler<std::vector<double>>());
+    REQUIRE(is_numeric_handler<std::vector<float>>());
+    REQUIRE(is_numeric_handler<std::vector<int>>());
+    REQUIRE(is_numeric_handler<std::vector<std::uint64_t>>());
+    REQUIRE(is_numeric_handler<std::deque<long>>());
+    REQUIRE((std::is_base_of<ArrayHandler<std::vector<char>>, Handler<std::vector<char>>>::value));
+    REQUIRE((std::is_base_of<ArrayHandler<std::vector<std::string>>,
+                             Handler<std::vector<std::string>>>::value));
+
+    ParseStatus status;
+    Telemetry t;
+    REQUIRE(from_json_string(
+        "{\"samples\": [1, -2, 3.5, 4294967296], \"levels\": [-3, 7], \"flags\": [true]}",
+        &t,
+        &status));
+    REQUIRE(t.samples == std::vector<double>({1, -2, 3.5, 4294967296.0}));
+    REQUIRE(t.levels == std::deque<long>({-3, 7}));
+    REQUIRE(t.flags.size() == 1);
+    REQUIRE(to_json_string(t)
+            == "{\"flags\":[true],\"levels\":[-3,7],\"samples\":[1.0,-2.0,3.5,4294967296.0]}");
+
+    std::vector<int> empty;
+    REQUIRE(from_json_string("[]", &empty, &status));
+    REQUIRE(empty.empty());
+
+    // Like every other array, a parse appends to what is already there
+    std::vector<int> ints = {1};
+    REQUIRE(from_json_string("[2, 3]", &ints, &status));
+    REQUIRE(ints == std::vector<int>({1, 2, 3}));
+
+    std::vector<float> floats;
+    REQUIRE(from_json_string<rapidjson::kParseFullPrecisionFlag>(
+        "[0.1, 16777216, 1e-7]", &floats, &status));
+    REQUIRE(floats == std::vector<float>({0.1f, 16777216.0f, 1e-7f}));
+
+    Document schema = export_json_schema(&floats);
+    REQUIRE(std::string(schema["type"].GetString()) == "array");
+    REQUIRE(std::string(schema["items"]["type"].GetString()) == "number");
+}
+
+TEST_CASE("Numeric array errors")
+{
+    ParseStatus status;
+
+    std::vector<unsigned> narrow;
+    REQUIRE(!from_json_string("[1, 2, 5000000000]", &narrow, &status));
+    REQUIRE(narrow.size() == 2);
+    auto it = status.begin();
+    REQUIRE(it->type() == error::NUMBER_OUT_OF_RANGE);
+    ++it;
+    REQUIRE(it->type() == error::ARRAY_ELEMENT);
+    REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 2);
+
+    std::vector<unsigned> unsigneds;
+    REQUIRE(!from_json_string("[1, -1]", &unsigneds, &status));
+    REQUIRE(std::next(status.begin())->type() == error::ARRAY_ELEMENT);
+
+    std::vector<int> ints;
+    REQUIRE(!from_json_string("[1, 1.5]", &ints, &status));
+    REQUIRE(!from_json_string("[1, \"2\"]", &ints, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+    REQUIRE(!from_json_string("[1, [2]]", &ints, &status));
+    REQUIRE(!from_json_string("[1, {}]", &ints, &status));
+    REQUIRE(!from_json_string("[null]", &ints, &status));
+    REQUIRE(!from_json_string("3", &ints, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+    std::vector<double> doubles;
+    REQUIRE(!from_json_string("[1, 9007199254740993]", &doubles, &status));
+    REQUIRE(status.begin()->type() == error::NUMBER_OUT_OF_RANGE);
+}
+
+TEST_CASE("Numeric arrays from CBOR")
+{
+    std::vector<double> source;
+    for (int i = 0; i < 1000; ++i)
+        source.push_back(i * 0.25);
+    std::vector<std::int64_t> ints = {-1, 0, 1LL << 40};
+
+    ParseStatus status;
+    std::vector<double> doubles;
+    REQUIRE(from_cbor(to_cbor(source), &doubles, &status));
+    REQUIRE(doubles == source);
+    REQUIRE(doubles.capacity() == source.size());
+
+    std::deque<std::int64_t> decoded;
+    REQUIRE(from_cbor(to_cbor(ints), &decoded, &status));
+    REQUIRE(decoded == std::deque<std::int64_t>(ints.begin(), ints.end()));
+
+    // A definite-length header that claims far more elements than present is not trusted
+    std::string lying = "\x9a\xff\xff\xff\xff\x01";
+    std::vector<int> small;
+    REQUIRE(!from_cbor(lying, &small, &status));
+    REQUIRE(small.capacity() <= (1u << 16));
+}
+
+namespace
+{
+// The generic per-element path, which bulk writes must match byte for byte
+template <class T>
+void require_same_output(const std::vector<T>& values)
+{
+    std::list<T> reference(values.begin(), values.end());
+    REQUIRE(to_json_string(values) == to_json_string(reference));
+    REQUIRE(to_pretty_json_string(values) == to_pretty_json_string(reference));
+    REQUIRE(to_cbor(values) == to_cbor(reference));
+
+    std::vector<T> decoded;
+    REQUIRE(from_json_string(to_json_string(values).c_str(), &decoded, nullptr));
+    REQUIRE(decoded == values);
+}
+}
+
+TEST_CASE("Bulk numeric array serialization")
+{
+    require_same_output(std::vector<double>{0.0, -0.0, 0.1, -2.5, 1e300, 5e-324, 123456789012.0});
+    require_same_output(std::vector<float>{0.1f, -3.0f, 1e30f, 1e-30f});
+    require_same_output(std::vector<int>{0, -1, 2147483647, -2147483647 - 1});
+    require_same_output(std::vector<unsigned>{0, 4294967295u});
+    require_same_output(
+        std::vector<std::int64_t>{-9223372036854775807LL - 1, 9223372036854775807LL});
+    require_same_output(std::vector<std::uint64_t>{18446744073709551615ULL});
+    require_same_output(std::vector<long long>{-5, 5});
+    require_same_output(std::vector<double>{});
+
+    std::vector<std::vector<double>> nested{{1.5}, {}, {2, 3}};
+    REQUIRE(to_json_string(nested) == "[[1.5],[],[2.0,3.0]]");
+
+    std::array<double, 3> fixed{{1, 2.5, -3}};
+    REQUIRE(to_json_string(fixed) == "[1.0,2.5,-3.0]");
+    std::array<std::string, 2> strings{{"a", "b"}};
+    REQUIRE(to_json_string(strings) == "[\"a\",\"b\"]");
+
+    // The writer stops at a number it cannot represent, whichever path is taken
+    std::vector<double> invalid{1, std::numeric_limits<double>::quiet_NaN()};
+    std::list<double> invalid_reference(invalid.begin(), invalid.end());
+    REQUIRE(to_json_string(invalid) == to_json_string(invalid_reference));
+
+    Document d;
+    REQUIRE(to_json_document(&d, std::vector<int>{1, 2}, nullptr));
+    REQUIRE(d.IsArray());
+    REQUIRE(d[1].GetInt() == 2);
+}
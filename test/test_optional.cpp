@@ -0,0 +1,134 @@
+#ifdef STATICJSON_EXPERIMENTAL_OPTIONAL
+#include <experimental/optional>
+#include <staticjson/optional_support.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Reading
+{
+    int sensor = 0;
+    std::vector<int> values;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("sensor", &sensor);
+        h->add_property("values", &values, Flags::Optional);
+    }
+};
+
+std::string readings(int count)
+{
+    std::string result = "[";
+    for (int i = 0; i < count; ++i)
+        result += i % 2 ? ", null" : (i ? ", " : "") + std::string("{\"sensor\": 1}");
+    return result + "]";
+}
+
+std::size_t optional_parse_allocations(int count)
+{
+    std::vector<nonpublic::optional<Reading>> result;
+    result.reserve(count);
+    AllocationStats stats;
+    ParseStatus status;
+    REQUIRE(from_json_string(readings(count).c_str(), &result, &status, &stats));
+    REQUIRE(result.size() == static_cast<std::size_t>(count));
+    REQUIRE(!result[1]);
+    REQUIRE(result[2]->sensor == 1);
+    return stats.parse.count;
+}
+
+template <class T>
+std::size_t write_allocations(const T& value)
+{
+    AllocationStats stats;
+    to_json_string(value, &stats);
+    return stats.serialize.count;
+}
+}
+
+TEST_CASE("Optional scalars")
+{
+    REQUIRE((std::is_base_of<OptionalScalarHandler<int>, Handler<nonpublic::optional<int>>>::value));
+    REQUIRE((std::is_base_of<OptionalScalarHandler<std::string>,
+                             Handler<nonpublic::optional<std::string>>>::value));
+    REQUIRE((std::is_base_of<OptionalHandler<Reading>,
+                             Handler<nonpublic::optional<Reading>>>::value));
+
+    ParseStatus status;
+    std::vector<nonpublic::optional<int>> ints;
+    REQUIRE(from_json_string("[1, null, -3]", &ints, &status));
+    REQUIRE(ints.size() == 3);
+    REQUIRE(*ints[0] == 1);
+    REQUIRE(!ints[1]);
+    REQUIRE(*ints[2] == -3);
+    REQUIRE(to_json_string(ints) == "[1,null,-3]");
+
+    nonpublic::optional<std::string> name;
+    REQUIRE(from_json_string("\"abc\"", &name, &status));
+    REQUIRE(*name == "abc");
+    REQUIRE(from_json_string("null", &name, &status));
+    REQUIRE(!name);
+
+    REQUIRE(!from_json_string("[1, [2]]", &ints, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+    REQUIRE(!from_json_string("[true]", &ints, &status));
+    REQUIRE(!from_json_string("{}", &name, &status));
+
+    Document schema = export_json_schema(&name);
+    REQUIRE(schema["anyOf"].Size() == 2);
+    REQUIRE(std::string(schema["anyOf"][1]["type"].GetString()) == "string");
+}
+
+TEST_CASE("Optional objects reuse their handler")
+{
+    // Only the values themselves allocate; no handler is built per element
+    REQUIRE(optional_parse_allocations(200) == optional_parse_allocations(100));
+
+    ParseStatus status;
+    std::vector<nonpublic::optional<Reading>> list;
+    REQUIRE(from_json_string(
+        "[{\"sensor\": 1, \"values\": [1, 2]}, null, {\"sensor\": 2}]", &list, &status));
+    REQUIRE(list[0]->values.size() == 2);
+    REQUIRE(!list[1]);
+    REQUIRE(list[2]->sensor == 2);
+    REQUIRE(list[2]->values.empty());
+    REQUIRE(to_json_string(list)
+            == "[{\"sensor\":1,\"values\":[1,2]},null,{\"sensor\":2,\"values\":[]}]");
+
+    // Named alike whether the element handler was built or not, and for scalars
+    nonpublic::optional<Reading> fresh;
+    Handler<nonpublic::optional<Reading>> unbuilt(&fresh), built(&fresh);
+    std::string name = unbuilt.type_name();
+    REQUIRE(built.StartObject());
+    REQUIRE(built.type_name() == name);
+    REQUIRE(name.compare(0, 14, "std::optional<") == 0);
+    nonpublic::optional<int> number;
+    REQUIRE(Handler<nonpublic::optional<int>>(&number).type_name() == "std::optional<int>");
+
+    std::vector<nonpublic::optional<Reading>> invalid;
+    REQUIRE(!from_json_string("[null, {\"values\": []}]", &invalid, &status));
+    REQUIRE(status.begin()->type() == error::MISSING_REQUIRED);
+}
+
+TEST_CASE("Writing optional objects allocates no more than writing the objects")
+{
+    std::vector<Reading> plain(100);
+    std::vector<nonpublic::optional<Reading>> engaged(plain.begin(), plain.end());
+    REQUIRE(to_json_string(engaged) == to_json_string(plain));
+    REQUIRE(write_allocations(engaged) == write_allocations(plain));
+
+    // Nothing is built for an empty optional
+    std::vector<nonpublic::optional<Reading>> empty(100);
+    std::vector<nonpublic::optional<int>> empty_ints(100);
+    REQUIRE(to_json_string(empty) == to_json_string(empty_ints));
+    REQUIRE(write_allocations(empty) == write_allocations(empty_ints));
+}
+#endif
@@ -0,0 +1,91 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Sample
+{
+    std::string name;
+    std::int64_t id;
+    double ratio;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("id", &id);
+        h->add_property("ratio", &ratio);
+    }
+};
+}
+
+TEST_CASE("Parse flags as template arguments")
+{
+    const char* input = "{\"name\": \"a\\u00e9b\", \"id\": -9000000000, \"ratio\": 0.1}";
+    ParseStatus status;
+
+    Sample defaults;
+    REQUIRE(from_json_string<rapidjson::kParseDefaultFlags>(input, &defaults, &status));
+    REQUIRE(defaults.id == -9000000000LL);
+
+    Sample full;
+    REQUIRE(from_json_string<rapidjson::kParseFullPrecisionFlag | rapidjson::kParseIterativeFlag>(
+        input, &full, &status));
+    REQUIRE(full.ratio == 0.1);
+
+    Sample raw;
+    REQUIRE(from_json_string<rapidjson::kParseNumbersAsStringsFlag>(input, &raw, &status));
+    REQUIRE(raw.id == defaults.id);
+    REQUIRE(raw.ratio == 0.1);
+    REQUIRE(raw.name == defaults.name);
+
+    std::vector<std::uint64_t> big;
+    REQUIRE(from_json_string<rapidjson::kParseNumbersAsStringsFlag>(
+        "[0, 4294967296, 18446744073709551615]", &big, &status));
+    REQUIRE(big.back() == 18446744073709551615ULL);
+
+    std::vector<int> ints;
+    REQUIRE(!from_json_string("[1, 2] trailing", &ints, &status));
+    ints.clear();
+    REQUIRE(from_json_string<rapidjson::kParseStopWhenDoneFlag>("[1, 2] trailing", &ints, &status));
+    REQUIRE(ints.size() == 2);
+
+    std::string buffer = input;
+    Sample insitu;
+    REQUIRE(from_json_insitu(&buffer[0], &insitu, &status));
+    REQUIRE(insitu.name == defaults.name);
+
+    ParseOptions options;
+    options.limits.max_string_length = 2;
+    REQUIRE(!from_json_string<rapidjson::kParseFullPrecisionFlag>(input, &full, &status, options));
+    REQUIRE(status.begin()->type() == error::LIMIT_EXCEEDED);
+}
+
+TEST_CASE("Parse flags with options for files")
+{
+    const char* filename = "parse_flags_test.json";
+    {
+        nonpublic::FileGuard fg(std::fopen(filename, "w"));
+        REQUIRE(fg.fp);
+        std::fputs("{\"name\": \"abc\", \"id\": 7, \"ratio\": 0.1} trailing", fg.fp);
+    }
+
+    ParseStatus status;
+    ParseOptions options;
+    Sample sample;
+    REQUIRE(from_json_file<rapidjson::kParseStopWhenDoneFlag>(
+        std::string(filename), &sample, &status, options));
+    REQUIRE(sample.id == 7);
+
+    options.limits.max_string_length = 2;
+    REQUIRE(!from_json_file<rapidjson::kParseStopWhenDoneFlag>(filename, &sample, &status, options));
+    REQUIRE(status.begin()->type() == error::LIMIT_EXCEEDED);
+    std::remove(filename);
+}
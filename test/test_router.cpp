@@ -0,0 +1,139 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Order
+{
+    int id = 0;
+    std::vector<std::string> items;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("id", &id);
+        h->add_property("items", &items, Flags::Optional);
+    }
+};
+
+struct Cancel
+{
+    int order = 0;
+    std::string reason;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("order", &order);
+        h->add_property("reason", &reason, Flags::Optional);
+        h->set_flags(Flags::DisallowUnknownKey);
+    }
+};
+
+struct Inbox
+{
+    std::vector<Order> orders;
+    std::vector<Cancel> cancels;
+    std::string log;
+};
+
+void add_routes(MessageRouter* router, Inbox* inbox)
+{
+    router->add_route<Order>("order", [inbox](Order& o) {
+        inbox->log += "o";
+        inbox->orders.push_back(std::move(o));
+    });
+    router->add_route<Cancel>("cancel", [inbox](Cancel& c) {
+        inbox->log += "c";
+        inbox->cancels.push_back(std::move(c));
+    });
+}
+}
+
+TEST_CASE("Routing NDJSON records")
+{
+    Inbox inbox;
+    MessageRouter router("kind");
+    add_routes(&router, &inbox);
+
+    ParseStatus status;
+    const char* input = "{\"kind\": \"order\", \"id\": 1, \"items\": [\"a\", \"b\"]}\n"
+                        "{\"kind\": \"cancel\", \"order\": 1}\n"
+                        "\n"
+                        "{\"id\": 2, \"items\": [\"c\"], \"kind\": \"order\"}\r\n"
+                        "{\"order\": 2, \"reason\": \"late\", \"kind\": \"cancel\"}\n";
+    REQUIRE(router.route_ndjson(input, &status));
+    REQUIRE(router.routed() == 4);
+    REQUIRE(inbox.log == "ococ");
+    REQUIRE(inbox.orders[0].items == std::vector<std::string>({"a", "b"}));
+    REQUIRE(inbox.orders[1].id == 2);
+    REQUIRE(inbox.orders[1].items == std::vector<std::string>({"c"}));
+    REQUIRE(inbox.cancels[1].reason == "late");
+
+    // Each record starts from a fresh value
+    REQUIRE(router.route("{\"kind\": \"order\", \"id\": 3}", &status));
+    REQUIRE(inbox.orders.back().items.empty());
+
+    REQUIRE(router.route_ndjson("", &status));
+    REQUIRE(router.routed() == 0);
+
+    Document schema;
+    router.generate_schema(schema, schema.GetAllocator());
+    REQUIRE(schema["anyOf"].Size() == 2);
+    REQUIRE(std::string(schema["anyOf"][0]["properties"]["kind"]["enum"][0].GetString())
+            == "cancel");
+}
+
+TEST_CASE("Routing errors")
+{
+    Inbox inbox;
+    MessageRouter router("kind");
+    add_routes(&router, &inbox);
+    ParseStatus status;
+
+    const char* input = "{\"kind\": \"order\", \"id\": 1}\n"
+                        "{\"kind\": \"refund\", \"id\": 2}\n"
+                        "{\"kind\": \"order\", \"id\": 3}\n";
+    REQUIRE(!router.route_ndjson(input, &status));
+    REQUIRE(router.routed() == 1);
+    auto it = status.begin();
+    REQUIRE(it->type() == error::INVALID_ENUM);
+    REQUIRE((++it)->type() == error::OBJECT_MEMBER);
+
+    REQUIRE(!router.route("{\"id\": 1}", &status));
+    REQUIRE(status.begin()->type() == error::MISSING_REQUIRED);
+    REQUIRE(!router.route("{\"kind\": \"cancel\", \"order\": 1, \"x\": 0}", &status));
+    REQUIRE(status.begin()->type() == error::UNKNOWN_FIELD);
+    REQUIRE(!router.route("{\"order\": \"1\", \"kind\": \"cancel\"}", &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+    REQUIRE(!router.route("{\"kind\": 1}", &status));
+    REQUIRE(!router.route("[]", &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+    REQUIRE(inbox.orders.size() == 1);
+    REQUIRE(inbox.cancels.empty());
+}
+
+TEST_CASE("Routing NDJSON files")
+{
+    std::FILE* fp = std::tmpfile();
+    REQUIRE(fp);
+    std::string records;
+    for (int i = 0; i < 500; ++i)
+        records += "{\"kind\": \"order\", \"id\": " + std::to_string(i) + "}\n";
+    std::fputs(records.c_str(), fp);
+    std::rewind(fp);
+
+    Inbox inbox;
+    MessageRouter router("kind");
+    add_routes(&router, &inbox);
+    ParseStatus status;
+    REQUIRE(router.route_ndjson(fp, &status));
+    std::fclose(fp);
+    REQUIRE(router.routed() == 500);
+    REQUIRE(inbox.orders.back().id == 499);
+}
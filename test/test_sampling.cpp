@@ -0,0 +1,94 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Member
+{
+    std::string name;
+    std::vector<std::string> tags;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("tags", &tags);
+    }
+};
+
+struct Roster
+{
+    std::vector<Member> members;
+    int count = -1;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("members", &members);
+        h->add_property("count", &count, Flags::Optional);
+    }
+};
+
+const char* roster_json = "{\"members\": [{\"name\": \"a\", \"tags\": [\"x\", \"y\", \"z\"]},"
+                          " {\"name\": \"b\", \"tags\": [\"w\", [\"nested\"]]},"
+                          " {\"name\": \"c\", \"tags\": []}], \"count\": 3}";
+}
+
+TEST_CASE("Sampling stops at the first elements of the root array")
+{
+    ParseOptions options;
+    options.sampling.max_array_elements = 3;
+    ParseStatus status;
+    status.enable_statistics();
+
+    // Anything after the third element is never read
+    std::string input = "[1, 2, 3, 4, this is not JSON";
+    std::vector<int> values;
+    REQUIRE(from_json_string(input.c_str(), &values, &status, options));
+    REQUIRE(values == std::vector<int>({1, 2, 3}));
+    REQUIRE(status.statistics()->bytes_consumed == input.find("4") - 2);
+
+    std::vector<int> short_values;
+    REQUIRE(from_json_string("[1, 2]", &short_values, &status, options));
+    REQUIRE(short_values.size() == 2);
+
+    std::string cbor = to_cbor(std::vector<int>{5, 6, 7, 8, 9});
+    REQUIRE(from_cbor(cbor.data(), cbor.size(), &values, &status, options));
+    REQUIRE(values.size() == 6);
+}
+
+TEST_CASE("Sampling by path")
+{
+    ParseOptions options;
+    options.sampling.max_array_elements_at["/members/*/tags"] = 1;
+    ParseStatus status;
+
+    Roster roster;
+    REQUIRE(from_json_string(roster_json, &roster, &status, options));
+    REQUIRE(roster.members.size() == 3);
+    REQUIRE(roster.members[0].tags == std::vector<std::string>({"x"}));
+    REQUIRE(roster.count == 3);
+
+    // The skipped element may itself be a container, of any type, which without sampling fails
+    REQUIRE(roster.members[1].tags == std::vector<std::string>({"w"}));
+    Roster unsampled;
+    REQUIRE(!from_json_string(roster_json, &unsampled, &status));
+
+    options.sampling.max_array_elements_at["/members"] = 2;
+    Roster preview;
+    REQUIRE(from_json_string(roster_json, &preview, &status, options));
+    REQUIRE(preview.members.size() == 2);
+    REQUIRE(preview.members[1].name == "b");
+    REQUIRE(preview.members[1].tags == std::vector<std::string>({"w"}));
+    REQUIRE(preview.count == -1);
+
+    Document d;
+    d.Parse(roster_json);
+    Roster from_dom;
+    REQUIRE(from_json_value(d, &from_dom, &status, options));
+    REQUIRE(from_dom.members.size() == 2);
+}
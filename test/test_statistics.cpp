@@ -0,0 +1,77 @@
+#include <staticjson/cbor.hpp>
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Entry
+{
+    int id;
+    double weight;
+    std::string label;
+    std::vector<std::map<std::string, bool>> flags;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("id", &id);
+        h->add_property("weight", &weight);
+        h->add_property("label", &label);
+        h->add_property("flags", &flags, Flags::Optional);
+    }
+};
+}
+
+TEST_CASE("Parse statistics")
+{
+    const std::string input = "[{\"id\": 1, \"weight\": 2.5, \"label\": \"abc\", \"extra\": null,"
+                              " \"flags\": [{\"x\": true, \"y\": false}]},"
+                              " {\"id\": 2, \"weight\": 3, \"label\": \"de\", \"more\": [1, 2]}]";
+    std::vector<Entry> entries;
+    ParseStatus status;
+    REQUIRE(status.statistics() == nullptr);
+    status.enable_statistics();
+    REQUIRE(from_json_string(input.c_str(), &entries, &status));
+
+    const ParseStatistics& stats = *status.statistics();
+    CHECK(stats.bytes_consumed == input.size());
+    CHECK(stats.nulls == 1);
+    CHECK(stats.bools == 2);
+    CHECK(stats.integers == 5);
+    CHECK(stats.doubles == 1);
+    CHECK(stats.strings == 2);
+    CHECK(stats.objects == 3);
+    CHECK(stats.arrays == 3);
+    CHECK(stats.keys == 11);
+    CHECK(stats.unknown_keys == 2);
+    CHECK(stats.max_depth == 4);
+    // Keys, then string values
+    CHECK(stats.string_bytes == 2 + 6 + 5 + 5 + 5 + 1 + 1 + 2 + 6 + 5 + 4 + 3 + 2);
+
+    SECTION("Statistics are reset by each parse and stop at the error")
+    {
+        REQUIRE(!from_json_string("[{\"id\": 1}, ", &entries, &status));
+        CHECK(status.statistics()->objects == 1);
+        CHECK(status.statistics()->unknown_keys == 0);
+        CHECK(status.statistics()->bytes_consumed == status.offset());
+    }
+
+    SECTION("CBOR")
+    {
+        std::string cbor = to_cbor(entries);
+        std::vector<Entry> decoded;
+        ParseStatus cbor_status;
+        cbor_status.enable_statistics();
+        REQUIRE(from_cbor(cbor, &decoded, &cbor_status));
+        CHECK(cbor_status.statistics()->bytes_consumed == cbor.size());
+        CHECK(cbor_status.statistics()->objects == 3);
+        CHECK(cbor_status.statistics()->keys == 10);
+        CHECK(cbor_status.statistics()->unknown_keys == 0);
+    }
+}
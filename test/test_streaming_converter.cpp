@@ -0,0 +1,280 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+// A growable buffer the library knows nothing about
+class Series
+{
+private:
+    std::unique_ptr<double[]> m_data;
+    std::size_t m_size = 0, m_capacity = 0;
+
+public:
+    std::size_t reserved = 0;
+
+    void clear() { m_size = 0; }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= m_capacity)
+            return;
+        std::unique_ptr<double[]> data(new double[capacity]);
+        for (std::size_t i = 0; i < m_size; ++i)
+            data[i] = m_data[i];
+        m_data.swap(data);
+        m_capacity = capacity;
+    }
+
+    void push(double d)
+    {
+        if (m_size == m_capacity)
+            reserve(m_capacity ? 2 * m_capacity : 4);
+        m_data[m_size++] = d;
+    }
+
+    std::size_t size() const { return m_size; }
+
+    double operator[](std::size_t i) const { return m_data[i]; }
+};
+
+struct Registry
+{
+    std::vector<std::pair<std::string, int>> entries;
+    bool sealed = false;
+};
+
+// A shadow that can only be moved from
+struct Bag
+{
+    std::vector<std::unique_ptr<int>> items;
+};
+
+struct Reading
+{
+    std::string name;
+    Series values;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("name", &name);
+        h->add_property("values", &values);
+    }
+};
+}
+
+namespace staticjson
+{
+template <>
+struct Converter<Series>
+{
+    typedef double element_type;
+
+    static void begin(Series& value, std::size_t size_hint)
+    {
+        value.clear();
+        value.reserve(size_hint);
+        value.reserved = size_hint;
+    }
+
+    static std::unique_ptr<ErrorBase> append(Series& value, double&& element)
+    {
+        if (std::isnan(element))
+            return std::unique_ptr<ErrorBase>(new error::CustomError("NaN in series"));
+        value.push(element);
+        return nullptr;
+    }
+
+    static std::unique_ptr<ErrorBase> end(Series&) { return nullptr; }
+
+    static std::size_t size(const Series& value) { return value.size(); }
+
+    template <class Visitor>
+    static bool for_each(const Series& value, Visitor visit)
+    {
+        for (std::size_t i = 0; i < value.size(); ++i)
+        {
+            if (!visit(value[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <>
+struct Converter<Registry>
+{
+    typedef int member_type;
+
+    static void begin(Registry& value, std::size_t size_hint)
+    {
+        value.entries.clear();
+        value.entries.reserve(size_hint);
+        value.sealed = false;
+    }
+
+    static std::unique_ptr<ErrorBase> append(Registry& value, const std::string& key, int&& id)
+    {
+        if (id < 0)
+            return std::unique_ptr<ErrorBase>(new error::CustomError("Negative id"));
+        value.entries.emplace_back(key, id);
+        return nullptr;
+    }
+
+    static std::unique_ptr<ErrorBase> end(Registry& value)
+    {
+        if (value.entries.empty())
+            return std::unique_ptr<ErrorBase>(new error::CustomError("Empty registry"));
+        value.sealed = true;
+        return nullptr;
+    }
+
+    static std::size_t size(const Registry& value) { return value.entries.size(); }
+
+    template <class Visitor>
+    static bool for_each(const Registry& value, Visitor visit)
+    {
+        for (auto&& entry : value.entries)
+        {
+            if (!visit(entry.first, entry.second))
+                return false;
+        }
+        return true;
+    }
+};
+
+template <>
+struct Converter<Bag>
+{
+    typedef std::vector<std::unique_ptr<int>> shadow_type;
+
+    static std::unique_ptr<ErrorBase> from_shadow(shadow_type&& shadow, Bag& value)
+    {
+        value.items = std::move(shadow);
+        return nullptr;
+    }
+
+    static void to_shadow(const Bag& value, shadow_type& shadow)
+    {
+        shadow.clear();
+        for (auto&& item : value.items)
+            shadow.emplace_back(item ? new int(*item) : nullptr);
+    }
+};
+}
+
+TEST_CASE("Streaming array converter")
+{
+    ParseStatus status;
+    Series series;
+    REQUIRE(from_json_string("[1, 2.5, -3, 4, 5]", &series, &status));
+    REQUIRE(series.size() == 5);
+    REQUIRE(series[1] == 2.5);
+    REQUIRE(series.reserved == 0);
+    REQUIRE(to_json_string(series) == "[1.0,2.5,-3.0,4.0,5.0]");
+
+    // Binary formats announce the length up front
+    Series decoded;
+    REQUIRE(from_cbor(to_cbor(series), &decoded, &status));
+    REQUIRE(decoded.reserved == 5);
+    REQUIRE(to_json_string(decoded) == to_json_string(series));
+
+    std::vector<Reading> readings;
+    const char* input = "[{\"name\": \"a\", \"values\": [1]}, {\"name\": \"b\", \"values\": []}]";
+    REQUIRE(from_json_string(input, &readings, &status));
+    REQUIRE(readings.size() == 2);
+    REQUIRE(readings[0].values.size() == 1);
+    REQUIRE(readings[1].values.size() == 0);
+    REQUIRE(to_json_string(readings)
+            == "[{\"name\":\"a\",\"values\":[1.0]},{\"name\":\"b\",\"values\":[]}]");
+
+    Document schema = export_json_schema(&series);
+    REQUIRE(std::string(schema["type"].GetString()) == "array");
+    REQUIRE(std::string(schema["items"]["type"].GetString()) == "number");
+}
+
+TEST_CASE("Announced CBOR lengths are bounded by the input")
+{
+    // 65536 elements announced, with room for two at most
+    const unsigned char input[] = {0x9a, 0x00, 0x01, 0x00, 0x00, 0x01, 0x02};
+    Series series;
+    ParseStatus status;
+    REQUIRE(!from_cbor(input, sizeof(input), &series, &status));
+    REQUIRE(series.reserved == 2);
+
+    // The hint passed on to converters is capped, however long the input
+    std::vector<unsigned char> zeros = {0x9a, 0x00, 0x01, 0x11, 0x70};
+    zeros.resize(zeros.size() + 70000, 0x00);
+    REQUIRE(from_cbor(zeros.data(), zeros.size(), &series, &status));
+    REQUIRE(series.size() == 70000);
+    REQUIRE(series.reserved == 65536);
+}
+
+TEST_CASE("Streaming array converter errors")
+{
+    ParseStatus status;
+    Series series;
+    REQUIRE(!from_json_string("[1, \"x\"]", &series, &status));
+    auto it = status.begin();
+    REQUIRE(it->type() == error::TYPE_MISMATCH);
+    ++it;
+    REQUIRE(it->type() == error::ARRAY_ELEMENT);
+    REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 1);
+
+    REQUIRE(!from_json_string("{}", &series, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+    // Errors returned by the converter are reported at the element
+    std::vector<double> nan = {1, std::nan("")};
+    REQUIRE(!from_cbor(to_cbor(nan), &series, &status));
+    it = status.begin();
+    REQUIRE(it->type() == error::CUSTOM);
+    ++it;
+    REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 1);
+}
+
+TEST_CASE("Streaming object converter")
+{
+    ParseStatus status;
+    Registry registry;
+    REQUIRE(from_json_string("{\"b\": 2, \"a\": 1}", &registry, &status));
+    REQUIRE(registry.sealed);
+    REQUIRE(registry.entries.size() == 2);
+    REQUIRE(registry.entries[0].first == "b");
+    // Members are written in the order the converter visits them
+    REQUIRE(to_json_string(registry) == "{\"b\":2,\"a\":1}");
+
+    REQUIRE(!from_json_string("{\"a\": 1, \"b\": -2}", &registry, &status));
+    auto it = status.begin();
+    REQUIRE(it->type() == error::CUSTOM);
+    ++it;
+    REQUIRE(it->type() == error::OBJECT_MEMBER);
+    REQUIRE(static_cast<const error::ObjectMemberError&>(*it).member_name() == "b");
+
+    REQUIRE(!from_json_string("{\"a\": [1]}", &registry, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+    REQUIRE(!from_json_string("{}", &registry, &status));
+    REQUIRE(status.begin()->type() == error::CUSTOM);
+}
+
+TEST_CASE("Shadow moved into the converter")
+{
+    ParseStatus status;
+    Bag bag;
+    REQUIRE(from_json_string("[1, null, 3]", &bag, &status));
+    REQUIRE(bag.items.size() == 3);
+    REQUIRE(*bag.items[2] == 3);
+    REQUIRE(!bag.items[1]);
+    REQUIRE(to_json_string(bag) == "[1,null,3]");
+}
@@ -0,0 +1,198 @@
+#include <staticjson/staticjson.hpp>
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace staticjson;
+
+// The same types twice, once through `ObjectHandler` and once through tables. Table fields are
+// listed in key order, the order `ObjectHandler` writes members in, so the output can be compared.
+namespace
+{
+struct TemplateReading
+{
+    double value = 0;
+    std::vector<int> codes;
+    std::string unit;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("codes", &codes, Flags::Optional);
+        h->add_property("unit", &unit);
+        h->add_property("value", &value);
+    }
+};
+
+struct TemplateStation
+{
+    bool active = false;
+    std::map<std::string, int> counters;
+    std::vector<std::vector<unsigned>> grid;
+    std::int64_t id = 0;
+    TemplateReading latest;
+    std::string name;
+    float ratio = 0;
+    std::vector<TemplateReading> readings;
+    std::uint64_t serial = 0;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("active", &active, Flags::Optional);
+        h->add_property("counters", &counters, Flags::Optional);
+        h->add_property("grid", &grid, Flags::Optional);
+        h->add_property("id", &id);
+        h->add_property("latest", &latest, Flags::Optional);
+        h->add_property("name", &name);
+        h->add_property("ratio", &ratio, Flags::Optional);
+        h->add_property("readings", &readings, Flags::Optional);
+        h->add_property("serial", &serial, Flags::Optional);
+    }
+};
+
+struct TableReading
+{
+    double value = 0;
+    std::vector<int> codes;
+    std::string unit;
+};
+
+struct TableStation
+{
+    bool active = false;
+    std::map<std::string, int> counters;
+    std::vector<std::vector<unsigned>> grid;
+    std::int64_t id = 0;
+    TableReading latest;
+    std::string name;
+    float ratio = 0;
+    std::vector<TableReading> readings;
+    std::uint64_t serial = 0;
+};
+
+struct Strict
+{
+    int a = 0;
+    std::string hidden = "kept";
+    std::string secret = "unwritten";
+};
+
+const char* const station_json
+    = "{\"id\": -5, \"name\": \"north\", \"active\": true, \"ratio\": 0.5, "
+      "\"serial\": 18446744073709551615, \"grid\": [[1, 2], [3]], \"counters\": {\"a\": 1}, "
+      "\"latest\": {\"value\": 1.5, \"codes\": [1, 2], \"unit\": \"C\"}, "
+      "\"readings\": [{\"value\": 2.5, \"codes\": [], \"unit\": \"F\"}, "
+      "{\"unit\": \"K\", \"value\": 3, \"codes\": [7]}], "
+      "\"extra\": {\"ignored\": [1, {\"x\": null}]}}";
+}
+
+STATICJSON_DECLARE_TABLE(TableReading,
+                         Flags::Default,
+                         table_field("codes", &TableReading::codes, Flags::Optional),
+                         table_field("unit", &TableReading::unit),
+                         table_field("value", &TableReading::value))
+
+STATICJSON_DECLARE_TABLE(TableStation,
+                         Flags::Default,
+                         table_field("active", &TableStation::active, Flags::Optional),
+                         table_field("counters", &TableStation::counters, Flags::Optional),
+                         table_field("grid", &TableStation::grid, Flags::Optional),
+                         table_field("id", &TableStation::id),
+                         table_field("latest", &TableStation::latest, Flags::Optional),
+                         table_field("name", &TableStation::name),
+                         table_field("ratio", &TableStation::ratio, Flags::Optional),
+                         table_field("readings", &TableStation::readings, Flags::Optional),
+                         table_field("serial", &TableStation::serial, Flags::Optional))
+
+STATICJSON_DECLARE_TABLE(Strict,
+                         Flags::DisallowUnknownKey,
+                         table_field("a", &Strict::a),
+                         table_field("hidden", &Strict::hidden, Flags::IgnoreRead | Flags::Optional),
+                         table_field("secret", &Strict::secret, Flags::IgnoreWrite | Flags::Optional))
+
+TEST_CASE("Table-driven types parse and write like template ones")
+{
+    REQUIRE(Handler<TableStation>::table().size == 9);
+    REQUIRE(Handler<TableStation>::table().fields[2].type.kind == TableKind::Sequence);
+    REQUIRE(Handler<TableStation>::table().fields[1].type.kind == TableKind::Custom);
+    REQUIRE(Handler<TableStation>::table().fields[4].type.kind == TableKind::Object);
+
+    ParseStatus status;
+    TableStation station;
+    REQUIRE(from_json_string(station_json, &station, &status));
+    REQUIRE(station.id == -5);
+    REQUIRE(station.name == "north");
+    REQUIRE(station.active);
+    REQUIRE(station.ratio == 0.5f);
+    REQUIRE(station.serial == 18446744073709551615ULL);
+    REQUIRE(station.grid == (std::vector<std::vector<unsigned>>{{1, 2}, {3}}));
+    REQUIRE(station.counters.at("a") == 1);
+    REQUIRE(station.latest.unit == "C");
+    REQUIRE(station.latest.codes == (std::vector<int>{1, 2}));
+    REQUIRE(station.readings.size() == 2);
+    REQUIRE(station.readings[1].value == 3);
+    REQUIRE(station.readings[1].codes == std::vector<int>{7});
+
+    TemplateStation reference;
+    REQUIRE(from_json_string(station_json, &reference, &status));
+    std::string json = to_json_string(station);
+    REQUIRE(json == to_json_string(reference));
+
+    TableStation again;
+    REQUIRE(from_json_string(json.c_str(), &again, &status));
+    REQUIRE(to_json_string(again) == json);
+
+    REQUIRE(to_json_string(export_json_schema(&station))
+            == to_json_string(export_json_schema(&reference)));
+}
+
+TEST_CASE("Table-driven types report errors like template ones")
+{
+    const char* const documents[] = {
+        "{\"name\": \"x\"}",
+        "{\"id\": \"x\", \"name\": \"x\"}",
+        "{\"id\": 1, \"name\": \"x\", \"id\": 2}",
+        "{\"id\": 1, \"name\": \"x\", \"grid\": [[1, -2]]}",
+        "{\"id\": 1, \"name\": \"x\", \"latest\": 5}",
+        "{\"id\": 1, \"name\": \"x\", \"latest\": {\"value\": true}}",
+        "{\"id\": 1, \"name\": \"x\", \"readings\": [{\"value\": 1, \"unit\": \"K\"}, {}]}",
+        "{\"id\": 1, \"name\": \"x\", \"readings\": [{\"value\": 1, \"unit\": [1]}]}",
+        "{\"id\": 1, \"name\": \"x\", \"counters\": {\"a\": \"b\"}}",
+        "{\"id\": 1.5, \"name\": \"x\"}",
+        "[1]",
+    };
+    for (const char* document : documents)
+    {
+        CAPTURE(document);
+        ParseStatus table_status, template_status;
+        TableStation station;
+        TemplateStation reference;
+        REQUIRE(!from_json_string(document, &station, &table_status));
+        REQUIRE(!from_json_string(document, &reference, &template_status));
+        REQUIRE(table_status.description() == template_status.description());
+    }
+}
+
+TEST_CASE("Table flags")
+{
+    ParseStatus status;
+    Strict value;
+    REQUIRE(from_json_string("{\"a\": 1, \"hidden\": \"x\", \"secret\": \"y\"}", &value, &status));
+    REQUIRE(value.a == 1);
+    REQUIRE(value.hidden == "kept");
+    REQUIRE(value.secret == "y");
+    REQUIRE(to_json_string(value) == "{\"a\":1,\"hidden\":\"kept\"}");
+
+    REQUIRE(!from_json_string("{\"a\": 1, \"b\": 2}", &value, &status));
+    REQUIRE(status.begin()->type() == error::UNKNOWN_FIELD);
+
+    // Handlers are reusable after an error
+    std::vector<TableReading> readings;
+    REQUIRE(!from_json_string("[{\"value\": 1}]", &readings, &status));
+    REQUIRE(from_json_string("[{\"value\": 1, \"unit\": \"m\"}]", &readings, &status));
+    REQUIRE(readings.size() == 1);
+    REQUIRE(readings[0].unit == "m");
+}
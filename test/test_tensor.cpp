@@ -4,6 +4,7 @@
 #include "myarray.hpp"
 
 #include <cerrno>
+#include <cstdint>
 #include <deque>
 #include <list>
 #include <vector>
@@ -49,3 +50,99 @@ TEST_CASE("Error tensor")
         REQUIRE(err.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
     }
 }
+
+TEST_CASE("Contiguous tensor")
+{
+    ParseStatus err;
+    Tensor<double, 2> matrix;
+    REQUIRE(from_json_string("[[1, 2, 3], [4, 5, 6.5]]", &matrix, &err));
+    REQUIRE(matrix.shape() == (Tensor<double, 2>::shape_type{{2, 3}}));
+    REQUIRE(matrix.size() == 6);
+    REQUIRE(matrix(1, 2) == 6.5);
+    REQUIRE(matrix.data()[3] == 4);
+    REQUIRE(to_json_string(matrix) == "[[1.0,2.0,3.0],[4.0,5.0,6.5]]");
+    std::vector<std::vector<double>> nested{{1, 2, 3}, {4, 5, 6.5}};
+    REQUIRE(to_pretty_json_string(matrix) == to_pretty_json_string(nested));
+
+    // A parse replaces the previous contents
+    REQUIRE(from_json_string("[[7], [8]]", &matrix, &err));
+    REQUIRE(matrix.shape() == (Tensor<double, 2>::shape_type{{2, 1}}));
+    REQUIRE(matrix(1, 0) == 8);
+
+    Tensor<double, 2> copy;
+    REQUIRE(from_cbor(to_cbor(matrix), &copy, &err));
+    REQUIRE(copy == matrix);
+
+    Tensor<int, 3> empty;
+    REQUIRE(from_json_string("[[], []]", &empty, &err));
+    REQUIRE(empty.shape() == (Tensor<int, 3>::shape_type{{2, 0, 0}}));
+    REQUIRE(empty.empty());
+    REQUIRE(to_json_string(empty) == "[[],[]]");
+
+    Tensor<float, 1> vector;
+    REQUIRE(from_json_string("[0.5, 2]", &vector, &err));
+    REQUIRE(vector.shape()[0] == 2);
+    REQUIRE(to_json_string(vector) == "[0.5,2.0]");
+
+    Tensor<std::int64_t, 2> built(Tensor<std::int64_t, 2>::shape_type{{2, 2}});
+    built(0, 1) = -3;
+    REQUIRE(to_json_string(built) == "[[0,-3],[0,0]]");
+}
+
+TEST_CASE("Tensor shape errors")
+{
+    // The rows of the example tensor have different lengths
+    {
+        Tensor<double, 3> tensor;
+        ParseStatus err;
+        REQUIRE(!from_json_file(get_base_dir() + "/examples/success/tensor.json", &tensor, &err));
+        auto it = err.begin();
+        REQUIRE(it->type() == error::ARRAY_LENGTH_MISMATCH);
+        ++it;
+        REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 0);
+        ++it;
+        REQUIRE(static_cast<const error::ArrayElementError&>(*it).index() == 1);
+        REQUIRE(++it == err.end());
+        REQUIRE(tensor.empty());
+    }
+    {
+        Tensor<int, 2> tensor;
+        ParseStatus err;
+        REQUIRE(!from_json_string("[[1, 2], [3, 4, 5]]", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
+        REQUIRE(!from_json_string("[[1, 2], [3, \"4\"]]", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::TYPE_MISMATCH);
+        REQUIRE(static_cast<const error::ArrayElementError&>(*std::next(err.begin())).index()
+                == 1);
+        REQUIRE(!from_json_string("[[1, 5000000000]]", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::NUMBER_OUT_OF_RANGE);
+        REQUIRE(!from_json_string("[1, 2]", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::TYPE_MISMATCH);
+        REQUIRE(!from_json_string("[[[1]]]", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::TYPE_MISMATCH);
+        REQUIRE(!from_json_string("{}", &tensor, &err));
+        REQUIRE(err.begin()->type() == error::TYPE_MISMATCH);
+    }
+}
+
+TEST_CASE("Tensor with fixed extents")
+{
+    Tensor<double, 2> points;
+    points.fix_extent(1, 3);
+    ParseStatus err;
+    REQUIRE(from_json_string("[[1, 2, 3]]", &points, &err));
+    REQUIRE(from_json_string("[]", &points, &err));
+    REQUIRE(points.shape() == (Tensor<double, 2>::shape_type{{0, 3}}));
+    REQUIRE(!from_json_string("[[1, 2]]", &points, &err));
+    REQUIRE(err.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
+    REQUIRE(!from_json_string("[[1, 2, 3, 4]]", &points, &err));
+    REQUIRE(err.begin()->type() == error::ARRAY_LENGTH_MISMATCH);
+
+    Document schema = export_json_schema(&points);
+    REQUIRE(!schema.HasMember("maxItems"));
+    REQUIRE(schema["items"]["maxItems"].GetUint64() == 3);
+    REQUIRE(std::string(schema["items"]["items"]["type"].GetString()) == "number");
+
+    points.fix_extent(1, Tensor<double, 2>::any);
+    REQUIRE(from_json_string("[[1, 2]]", &points, &err));
+}
@@ -0,0 +1,121 @@
+#if __cplusplus >= 201703L
+#include <staticjson/cbor.hpp>
+#include <staticjson/staticjson.hpp>
+#include <staticjson/variant_support.hpp>
+
+#include "catch.hpp"
+
+#include <string>
+#include <variant>
+#include <vector>
+
+using namespace staticjson;
+
+namespace
+{
+struct Circle
+{
+    double radius = 0;
+
+    void staticjson_init(ObjectHandler* h) { h->add_property("radius", &radius); }
+};
+
+struct Label
+{
+    std::string text;
+    std::vector<int> position;
+
+    void staticjson_init(ObjectHandler* h)
+    {
+        h->add_property("text", &text);
+        h->add_property("position", &position, Flags::Optional);
+        h->set_flags(Flags::DisallowUnknownKey);
+    }
+};
+
+typedef std::variant<Circle, Label> Shape;
+}
+
+STATICJSON_DECLARE_VARIANT(Shape, "type", "circle", "label")
+
+TEST_CASE("Variant with the discriminator first")
+{
+    ParseStatus status;
+    Shape shape;
+    REQUIRE(from_json_string("{\"type\": \"label\", \"text\": \"hi\", \"position\": [1, 2]}",
+                             &shape,
+                             &status));
+    REQUIRE(shape.index() == 1);
+    REQUIRE(std::get<Label>(shape).text == "hi");
+    REQUIRE(std::get<Label>(shape).position == std::vector<int>({1, 2}));
+    REQUIRE(to_json_string(shape) == "{\"type\":\"label\",\"position\":[1,2],\"text\":\"hi\"}");
+
+    std::vector<Shape> shapes;
+    REQUIRE(from_json_string("[{\"type\": \"circle\", \"radius\": 2}, {\"type\": \"label\","
+                             " \"text\": \"a\"}, {\"type\": \"circle\", \"radius\": 3}]",
+                             &shapes,
+                             &status));
+    REQUIRE(shapes.size() == 3);
+    REQUIRE(std::get<Circle>(shapes[0]).radius == 2);
+    REQUIRE(std::get<Label>(shapes[1]).text == "a");
+    REQUIRE(std::get<Circle>(shapes[2]).radius == 3);
+
+    std::vector<Shape> decoded;
+    REQUIRE(from_cbor(to_cbor(shapes), &decoded, &status));
+    REQUIRE(to_json_string(decoded) == to_json_string(shapes));
+}
+
+TEST_CASE("Variant with the discriminator later")
+{
+    ParseStatus status;
+    Shape shape;
+    REQUIRE(from_json_string(
+        "{\"position\": [3, 4], \"text\": \"late\", \"type\": \"label\"}", &shape, &status));
+    REQUIRE(std::get<Label>(shape).text == "late");
+    REQUIRE(std::get<Label>(shape).position == std::vector<int>({3, 4}));
+
+    REQUIRE(from_json_string("{\"radius\": 1.5, \"type\": \"circle\"}", &shape, &status));
+    REQUIRE(std::get<Circle>(shape).radius == 1.5);
+}
+
+TEST_CASE("Variant errors")
+{
+    ParseStatus status;
+    Shape shape;
+
+    REQUIRE(!from_json_string("{\"type\": \"square\", \"side\": 1}", &shape, &status));
+    auto it = status.begin();
+    REQUIRE(it->type() == error::INVALID_ENUM);
+    REQUIRE((++it)->type() == error::OBJECT_MEMBER);
+
+    REQUIRE(!from_json_string("{\"type\": 1}", &shape, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+    REQUIRE(!from_json_string("{\"radius\": 1}", &shape, &status));
+    REQUIRE(status.begin()->type() == error::MISSING_REQUIRED);
+
+    REQUIRE(!from_json_string("{\"type\": \"circle\", \"type\": \"circle\"}", &shape, &status));
+    REQUIRE(status.begin()->type() == error::DUPLICATE_KEYS);
+
+    REQUIRE(!from_json_string("[]", &shape, &status));
+    REQUIRE(status.begin()->type() == error::TYPE_MISMATCH);
+
+    // Errors of the alternative, whether its members came before the discriminator or after
+    REQUIRE(!from_json_string("{\"type\": \"label\", \"text\": \"a\", \"x\": 1}", &shape, &status));
+    REQUIRE(status.begin()->type() == error::UNKNOWN_FIELD);
+    REQUIRE(!from_json_string("{\"text\": 5, \"type\": \"label\"}", &shape, &status));
+    it = status.begin();
+    REQUIRE(it->type() == error::TYPE_MISMATCH);
+    REQUIRE((++it)->type() == error::OBJECT_MEMBER);
+}
+
+TEST_CASE("Variant schema")
+{
+    Shape shape;
+    Document schema = export_json_schema(&shape);
+    REQUIRE(schema["anyOf"].Size() == 2);
+    const Value& label = schema["anyOf"][1];
+    REQUIRE(std::string(label["properties"]["type"]["enum"][0].GetString()) == "label");
+    REQUIRE(label["required"].Size() == 2);
+}
+#endif